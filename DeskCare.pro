@@ -1,36 +1,20 @@
-QT += core gui qml quick widgets svg network sql
+# ========================================================================
+# DeskCare 顶层项目
+# ========================================================================
+# - core: 核心静态库 (计时引擎、活动记录、配置与统计，只依赖 QtCore/Sql/Network)
+# - app:  桌面程序 (QML 界面 + 托盘)
+# - headless: deskcare-headless 无界面控制台程序 (只依赖 QtCore/Sql/Network)
+# - ctl:  deskcare-ctl 命令行客户端 (通过本地套接字控制正在运行的实例)
+# - benchmarks: 活动查询与统计的 QtTest 基准测试 (tests/benchmarks)
+TEMPLATE = subdirs
 
-CONFIG += c++17
+SUBDIRS += core app headless ctl benchmarks
 
-TARGET = DeskCare
-TEMPLATE = app
-
-SOURCES += \
-    src/main.cpp \
-    src/core/TimerEngine.cpp \
-    src/gui/TrayIcon.cpp \
-    src/core/AppConfig.cpp \
-    src/utils/WindowUtils.cpp \
-    src/core/UpdateManager.cpp \
-    src/core/StatisticsManager.cpp \
-    src/core/Version.cpp \
-    src/core/ActivityLogger.cpp
-
-HEADERS += \
-    src/core/TimerEngine.h \
-    src/gui/TrayIcon.h \
-    src/core/AppConfig.h \
-    src/utils/WindowUtils.h \
-    src/core/UpdateManager.h \
-    src/core/StatisticsManager.h \
-    src/core/Version.h \
-    src/core/ActivityLogger.h
-
-RESOURCES += resources.qrc
-
-# High DPI support for Windows
-windows:MANIFEST_DEPENDENCIES += "type='win32' name='Microsoft.Windows.Common-Controls' version='6.0.0.0' processorArchitecture='*' publicKeyToken='6595b64144ccf1df' language='*'"
-win32:LIBS += -luser32 -lwtsapi32
-
-# Fix for MSVC "C2001: newline in constant" error due to UTF-8 encoding with Chinese comments
-msvc:QMAKE_CXXFLAGS += /utf-8
+core.file = src/core/core.pro
+app.file = src/app.pro
+app.depends = core
+headless.file = src/headless/headless.pro
+headless.depends = core
+benchmarks.file = tests/benchmarks/benchmarks.pro
+benchmarks.depends = core
+ctl.file = src/ctl/ctl.pro
@@ -23,7 +23,14 @@ Window {
     property date currentDate: new Date()
     property color themeColor: "#00d2ff" // Default theme color
     property var highlightFilter: null // { type: int, minDuration: int, startTime: qint64 }
-    onHighlightFilterChanged: timelineCanvas.requestPaint()
+    // 高亮命中集合 (key: 记录 id / "ongoing")，由 C++ 端 queryActivities 计算
+    property var highlightKeys: null
+    onHighlightFilterChanged: {
+        updateHighlightKeys()
+        timelineCanvas.requestPaint()
+    }
+    // 命中集合按日期计算，换日期时重新查询 (刷新数据时同样)
+    onCurrentDateChanged: updateHighlightKeys()
     
     // Calendar Popup Control
     property bool showCalendar: false
@@ -474,19 +481,9 @@ Window {
 
                                 ctx.fillStyle = getColorForType(act.type);
                                 
-                                // Highlight logic
-                            var isHighlighted = true;
-                            if (dashboardWindow.highlightFilter) {
-                                var f = dashboardWindow.highlightFilter;
-                                var typeMatch = (f.type === undefined || f.type === -1) || (act.type === f.type);
-                                var minDurationMatch = (f.minDuration === undefined || f.minDuration === -1) || (act.duration > f.minDuration);
-                                // Allow small time slop (1000ms) for floating point/conversion diffs
-                                var startTimeMatch = (f.startTime === undefined || f.startTime === -1) || (Math.abs(act.startTime - f.startTime) < 1000); 
-                                
-                                if (!typeMatch || !minDurationMatch || !startTimeMatch) {
-                                    isHighlighted = false;
-                                }
-                            }
+                                // Highlight logic (筛选已在 C++ 端完成，这里只做查表)
+                            var isHighlighted = !dashboardWindow.highlightKeys ||
+                                                dashboardWindow.highlightKeys[activityKey(act)] === true;
                             
                             if (isHighlighted) {
                                 ctx.globalAlpha = 1.0;
@@ -857,6 +854,35 @@ Window {
         }
     }
 
+    function activityKey(act) {
+        return act.isOngoing ? "ongoing" : act.id;
+    }
+
+    function updateHighlightKeys() {
+        var f = highlightFilter;
+        if (!f) {
+            highlightKeys = null;
+            return;
+        }
+
+        var midnight = new Date(currentDate);
+        midnight.setHours(0,0,0,0);
+        var spec = {
+            "startMs": midnight.getTime(),
+            "endMs": midnight.getTime() + 24 * 3600 * 1000 - 1
+        };
+        if (f.type !== undefined && f.type !== -1) spec.types = [f.type];
+        if (f.minDuration !== undefined && f.minDuration !== -1) spec.minDuration = f.minDuration;
+        if (f.startTime !== undefined && f.startTime !== -1) spec.startTime = f.startTime;
+
+        var keys = {};
+        var matches = activityLogger.queryActivities(spec);
+        for (var i = 0; i < matches.length; i++) {
+            keys[activityKey(matches[i])] = true;
+        }
+        highlightKeys = keys;
+    }
+
     function withAlpha(c, a) {
         return Qt.rgba(c.r, c.g, c.b, a).toString();
     }
@@ -865,6 +891,7 @@ Window {
         var activities = activityLogger.getDailyActivities(currentDate);
         var stats = activityLogger.getDailyStats(currentDate);
 
+        updateHighlightKeys();
         timelineCanvas.activityData = activities;
         timelineCanvas.requestPaint();
 
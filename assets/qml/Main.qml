@@ -4,6 +4,7 @@ import QtQuick.Window 2.15
 import QtQuick.Particles 2.0 // 引入粒子系统
 import QtQml 2.15 // 引入 Instantiator 等高级 QML 功能
 import QtGraphicalEffects 1.15 // 引入图形特效（如圆角裁剪、阴影、模糊）
+import DeskCare 1.0 // TimerEngine 状态枚举 (main.cpp 中注册)
 
 // ========================================================================
 // Main.qml - 应用程序主窗口
@@ -103,11 +104,15 @@ Window {
     width: isPinned ? 120 : 280
     height: isPinned ? 120 : 420
 
-    // Loader for Activity Dashboard
-    Loader {
+    // Activity Dashboard (由 componentPool 创建，用法同 Loader)
+    PooledWindow {
         id: dashboardLoader
+        key: "ActivityDashboard"
         active: false
         source: "ActivityDashboard.qml"
+        initialProperties: ({ visible: false })
+        // --probe-qml-memory 时核算加载/卸载前后的内存
+        Component.onCompleted: if (memoryProbe) memoryProbe.watch(dashboardLoader, "ActivityDashboard")
         onLoaded: {
             item.visible = true
             // Bind theme color for consistency
@@ -135,7 +140,8 @@ Window {
         mainWindow.opacity = 0
         mainWindow.visible = false
         
-        // Delay opening dashboard
+        // Delay opening dashboard；等待主窗口隐藏的同时在后台创建看板
+        dashboardLoader.prepare()
         openDashboardTimer.restart()
     }
 
@@ -160,6 +166,11 @@ Window {
     // 这彻底避免了窗口先在屏幕中间闪烁一下再跳到右上角，或在错误位置显示的“视觉抖动”，实现“无感启动”。
     visible: false // Manual control
     onIsInitializedChanged: if (isInitialized) visible = true
+
+    // 仅在窗口可见时向 TimerEngine 申请每秒刷新 (0=每秒, 2=仅到期)
+    // 隐藏到托盘或最小化后引擎不再每秒唤醒
+    readonly property bool needsSecondTicks: visible && visibility !== Window.Minimized
+    onNeedsSecondTicksChanged: timerEngine.requestDisplay("mainWindow", needsSecondTicks ? 0 : 2)
     
     // 新增标志：记录是否在进入 Mini 模式后鼠标已经移出过
     // 用于解决双击切换时立即显示 Peek 状态导致的卡影/突兀问题
@@ -213,12 +224,16 @@ Window {
     // 根据 timerEngine (C++ 后端) 的状态改变 UI 主色调。
     // property 绑定会自动更新，无需手动监听信号。
     property color themeColor: {
-        switch(timerEngine.statusText) {
-            case "已暂停": return "#ffbf00" // 琥珀金 - 提示状态
-            case "请休息": return "#00ff88" // 春日绿 - 休息状态
-            default: return "#00d2ff"       // 科技蓝 - 工作状态
+        switch(timerEngine.engineState) {
+            case TimerEngine.Engine_Paused: return "#ffbf00" // 琥珀金 - 提示状态
+            case TimerEngine.Engine_Break: return "#00ff88"  // 春日绿 - 休息状态
+            default: return "#00d2ff"                        // 科技蓝 - 工作状态
         }
     }
+
+    // 是否显示为"工作中" (锁屏自动暂停时界面保持不变)
+    readonly property bool isWorkingState: timerEngine.engineState === TimerEngine.Engine_Working
+                                           || timerEngine.engineState === TimerEngine.Engine_LockedWorking
     
     // ========================================================================
     // 模式切换与视觉补偿
@@ -417,7 +432,7 @@ Window {
                 SequentialAnimation on opacity {
                     // 性能优化：增加 mainWindow.visible 检查
                     // 只有当窗口可见且处于工作中状态时才运行动画，防止后台空耗 CPU
-                    running: mainWindow.visible && timerEngine.statusText === "工作中"
+                    running: mainWindow.visible && mainWindow.isWorkingState
                     loops: Animation.Infinite
                     NumberAnimation { from: 0.05; to: 0.15; duration: 2000; easing.type: Easing.InOutQuad }
                     NumberAnimation { from: 0.15; to: 0.05; duration: 2000; easing.type: Easing.InOutQuad }
@@ -628,7 +643,7 @@ Window {
                 // 跟随 Canvas 的动态颜色
                 color: progressCanvas.drawColor 
                 cornerRadius: width/2
-                visible: isPinned && timerEngine.statusText === "工作中"
+                visible: isPinned && mainWindow.isWorkingState
                 opacity: 0.2 // 降低初始不透明度，防止过曝
                 
                 // 呼吸动画
@@ -758,7 +773,7 @@ Window {
             Item {
                 id: rimLightContainer
                 anchors.fill: parent
-                visible: isPinned && timerEngine.statusText === "工作中" && progressCanvas.progress > 0
+                visible: isPinned && mainWindow.isWorkingState && progressCanvas.progress > 0
                 rotation: -90 // 配合 Canvas 的旋转
                 
                 // 光点本体
@@ -923,7 +938,7 @@ Window {
                             font.family: "Microsoft YaHei UI"
                             
                             // 逻辑：Mini模式隐藏 OR 非工作状态隐藏
-                            opacity: isPinned ? 0.0 : (timerEngine.statusText === "工作中" ? 1.0 : 0.0)
+                            opacity: isPinned ? 0.0 : (mainWindow.isWorkingState ? 1.0 : 0.0)
                             visible: opacity > 0
                             
                             height: visible ? implicitHeight : 0
@@ -1019,8 +1034,7 @@ Window {
                     repeat: false
                     onTriggered: {
                         // 触发立即运动
-                        themeController.generateRandomTheme()
-                        isReminderActive = true
+                        showReminder()
                     }
                 }
                 
@@ -1292,8 +1306,7 @@ Window {
                             label: "立即运动"
                             shortcut: "三击"
                             onTriggered: {
-                                themeController.generateRandomTheme()
-                                isReminderActive = true
+                                showReminder()
                             }
                         }
                         
@@ -1523,8 +1536,7 @@ Window {
                     text: "立即运动"
                     btnColor: "#3a7bd5"
                     onClicked: {
-                        themeController.generateRandomTheme()
-                        isReminderActive = true
+                        showReminder()
                     }
                 }
 
@@ -1723,6 +1735,7 @@ Window {
             active: false
             source: "UpdateDialog.qml"
             z: 200
+            Component.onCompleted: if (memoryProbe) memoryProbe.watch(updateDialog, "UpdateDialog")
 
             function open() {
                 if (active) {
@@ -1752,6 +1765,7 @@ Window {
         active: false
         source: "SettingsOverlay.qml"
         z: 200
+        Component.onCompleted: if (memoryProbe) memoryProbe.watch(settingsOverlay, "SettingsOverlay")
 
         function open() {
             if (active) {
@@ -1777,40 +1791,63 @@ Window {
     
     // 全局提醒激活状态
     property bool isReminderActive: false
+    // 提醒窗口已按当前主题在后台准备 (componentPool.prewarmDue)
+    property bool overlayPrepared: false
+
+    // 显示全屏提醒：已提前准备的窗口选好了主题，直接使用
+    function showReminder() {
+        if (!overlayPrepared) themeController.generateRandomTheme()
+        overlayPrepared = false
+        isReminderActive = true
+    }
+
+    // 倒计时最后一分钟在后台创建各屏幕的提醒窗口，提醒时只需显示
+    Connections {
+        target: componentPool
+        function onPrewarmDue() {
+            if (isReminderActive || timerEngine.isNapMode) return
+            themeController.generateRandomTheme()
+            for (var i = 0; i < overlayInstantiator.count; ++i) overlayInstantiator.objectAt(i).prepare()
+            overlayPrepared = true
+        }
+        function onPrewarmCancelled() {
+            for (var i = 0; i < overlayInstantiator.count; ++i) overlayInstantiator.objectAt(i).discard()
+            overlayPrepared = false
+        }
+    }
 
     // 多屏实例化全屏提醒窗口
     Instantiator {
+        id: overlayInstantiator
         model: Qt.application.screens
-        // 使用 Loader 进行懒加载和资源自动回收
-        delegate: Loader {
-            // 只有当全局提醒激活且不在午休模式时加载
-            // 加载时创建 Window，不加载时销毁 Window 及其所有资源 (粒子、Canvas等)
+        // 按需创建，关闭时销毁 Window 及其所有资源 (粒子、Canvas等)
+        delegate: PooledWindow {
+            id: overlaySlot
+            key: "OverlayWindow#" + index
+            source: "OverlayWindow.qml"
+            // 只有当全局提醒激活且不在午休模式时显示
             active: isReminderActive && !timerEngine.isNapMode
-            
-            sourceComponent: OverlayWindow {
-                screen: modelData // 绑定到对应屏幕
-                themeData: themeController.currentTheme
-                
-                // 注意：对于 Window 对象，Loader 加载后不会自动显示，
-                // 必须在 onLoaded 中显式调用 show() 或设置 visible=true
-                
-                onReminderFinished: {
-                    isReminderActive = false
-                    // 自动开启下一轮工作倒计时
-                    timerEngine.startWork()
-                }
-                onRequestStartWork: {
-                    // 立即开始工作，无需等待 OverlayWindow 销毁 (OverlayWindow 会在自己的倒计时结束后通过 onReminderFinished 关闭)
-                    timerEngine.startWork()
-                }
-                onSnoozeRequested: {
-                    timerEngine.snooze()
-                    isReminderActive = false
-                }
-            }
+            initialProperties: ({ screen: modelData, themeData: themeController.currentTheme })
+            Component.onCompleted: if (memoryProbe) memoryProbe.watch(overlaySlot, key)
 
+            // 注意：对于 Window 对象，创建后不会自动显示，
+            // 必须在 onLoaded 中显式调用 show() 或设置 visible=true
             onLoaded: {
                 if (item) {
+                    item.reminderFinished.connect(function() {
+                        isReminderActive = false
+                        // 自动开启下一轮工作倒计时
+                        timerEngine.startWork()
+                    })
+                    item.requestStartWork.connect(function() {
+                        // 立即开始工作，无需等待 OverlayWindow 销毁 (OverlayWindow 会在自己的倒计时结束后通过 onReminderFinished 关闭)
+                        timerEngine.startWork()
+                    })
+                    item.snoozeRequested.connect(function() {
+                        timerEngine.snooze()
+                        isReminderActive = false
+                    })
+
                     // 强制设置几何属性，确保在多显示器环境下位置正确
                     // 虽然 OverlayWindow 内部有绑定，但在某些 Qt 版本中，
                     // Window 创建初期的 screen 属性同步可能存在延迟，导致位置错乱。
@@ -1822,6 +1859,14 @@ Window {
                         item.height = modelData.virtualGeometry.height
                     }
                     
+                    // 第一帧绘制完成：记录提醒到全屏窗口可见的时延 (多屏时以最先完成的为准)
+                    var overlay = item
+                    var onFirstFrame = function() {
+                        overlay.frameSwapped.disconnect(onFirstFrame)
+                        metrics.markEnd("ui.reminderToOverlay")
+                    }
+                    overlay.frameSwapped.connect(onFirstFrame)
+
                     item.visible = true
                     item.showFullScreen()
                     item.raise()
@@ -1842,14 +1887,32 @@ Window {
         }
     }
 
+    // ========================================================================
+    // 性能指标浮窗 (Ctrl+Shift+M，调试用)
+    // ========================================================================
+    Shortcut {
+        sequence: "Ctrl+Shift+M"
+        context: Qt.ApplicationShortcut
+        onActivated: metricsHud.active = !metricsHud.active
+    }
+
+    Loader {
+        id: metricsHud
+        active: false
+        source: "MetricsHud.qml"
+        onLoaded: {
+            item.show()
+            item.closeRequested.connect(function() { metricsHud.active = false })
+        }
+    }
+
     Connections {
         target: timerEngine
         function onReminderTriggered() {
             // 如果正在午休，不打扰
             if (timerEngine.isNapMode) return;
             
-            themeController.generateRandomTheme()
-            isReminderActive = true
+            showReminder()
         }
     }
 }
\ No newline at end of file
@@ -0,0 +1,98 @@
+import QtQuick 2.15
+import QtQuick.Window 2.15
+
+// ========================================================================
+// MetricsHud.qml - 性能指标浮窗 (调试用)
+// ========================================================================
+// Main.qml 中按 Ctrl+Shift+M 切换，由 Loader 按需创建，关闭即销毁。
+// 显示 metrics.snapshot()：直方图为 次数 / p50 / p99 / 最大值 (毫秒)，
+// 计数器为累计值。可见时每秒刷新一次。
+// ========================================================================
+
+Window {
+    id: hud
+    width: 460
+    height: Math.min(420, content.implicitHeight + 24)
+    color: "transparent"
+    flags: Qt.Tool | Qt.FramelessWindowHint | Qt.WindowStaysOnTopHint | Qt.WindowDoesNotAcceptFocus
+
+    signal closeRequested()
+
+    property var rows: []
+
+    function refresh() {
+        rows = metrics.snapshot()
+    }
+
+    Component.onCompleted: {
+        // 默认放在当前屏幕右上角
+        x = Screen.virtualX + Screen.width - width - 16
+        y = Screen.virtualY + 16
+        refresh()
+    }
+
+    Timer {
+        interval: 1000
+        repeat: true
+        running: hud.visible
+        onTriggered: hud.refresh()
+    }
+
+    Rectangle {
+        anchors.fill: parent
+        radius: 8
+        color: "#D0101820"
+        border.color: "#40FFFFFF"
+
+        MouseArea {
+            anchors.fill: parent
+            property point pressPos
+            onPressed: pressPos = Qt.point(mouse.x, mouse.y)
+            onPositionChanged: {
+                hud.x += mouse.x - pressPos.x
+                hud.y += mouse.y - pressPos.y
+            }
+            onDoubleClicked: hud.closeRequested()
+        }
+
+        Column {
+            id: content
+            anchors.fill: parent
+            anchors.margins: 12
+            spacing: 2
+
+            Text {
+                text: "Metrics  (双击关闭 · Ctrl+Shift+M)"
+                color: "#8899AA"
+                font.pixelSize: 11
+            }
+
+            Repeater {
+                model: hud.rows
+                delegate: Row {
+                    spacing: 8
+                    Text {
+                        width: 200
+                        text: modelData.name
+                        color: "#DDE6F0"
+                        elide: Text.ElideMiddle
+                        font.family: "Consolas"
+                        font.pixelSize: 12
+                    }
+                    Text {
+                        text: modelData.type === "counter"
+                              ? modelData.value
+                              : ("n=" + modelData.count + "  p50 " + modelData.p50Ms + "  p99 " + modelData.p99Ms
+                                 + "  max " + modelData.maxMs)
+                        // p99 超过一帧 (16ms) 标黄，超过 100ms 标红
+                        color: modelData.type === "counter" ? "#DDE6F0"
+                             : modelData.p99Ms > 100 ? "#FF6B6B"
+                             : modelData.p99Ms > 16 ? "#FFBF00" : "#00FF88"
+                        font.family: "Consolas"
+                        font.pixelSize: 12
+                    }
+                }
+            }
+        }
+    }
+}
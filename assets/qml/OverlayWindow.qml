@@ -820,6 +820,7 @@ Window {
                     opacity: 0.3
                     SequentialAnimation on scale {
                         loops: Animation.Infinite
+                        running: overlayWin.visible
                         NumberAnimation {
                             from: 1.0
                             to: 1.3
@@ -833,6 +834,7 @@ Window {
                     }
                     SequentialAnimation on opacity {
                         loops: Animation.Infinite
+                        running: overlayWin.visible
                         NumberAnimation {
                             from: 0.6
                             to: 0.0
@@ -863,6 +865,7 @@ Window {
                     anchors.fill: parent
                     RotationAnimation on rotation {
                         loops: Animation.Infinite
+                        running: overlayWin.visible
                         from: 0
                         to: 360
                         duration: 10000
@@ -897,6 +900,7 @@ Window {
                     property real rot: 0
                     RotationAnimation on rot {
                         loops: Animation.Infinite
+                        running: overlayWin.visible
                         from: 0
                         to: 360
                         duration: 10000
@@ -978,6 +982,7 @@ Window {
                             }
                             RotationAnimation on rotation {
                                 loops: Animation.Infinite
+                                running: overlayWin.visible
                                 from: 0
                                 to: 360
                                 duration: 2000
@@ -1024,6 +1029,7 @@ Window {
                             to: 1.1
                             duration: 1000 + index*500
                             loops: Animation.Infinite
+                            running: overlayWin.visible
                             easing.type: Easing.SineCurve
                         }
                     }
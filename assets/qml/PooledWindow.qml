@@ -0,0 +1,45 @@
+import QtQuick 2.15
+
+// ========================================================================
+// PooledWindow.qml - 由 componentPool 创建的顶层窗口 (代替 Loader)
+// ========================================================================
+// 用法与 Loader 相同：active 为 true 时取出 (没有准备时同步创建) 窗口并
+// 发出 loaded，为 false 时销毁窗口。prepare() 提前在后台孵化一个隐藏的
+// 实例，之后的 active = true 只需显示。只适用于 Window 类型的组件。
+// 见 src/utils/ComponentPool.h
+// ========================================================================
+
+QtObject {
+    id: root
+
+    property string key           // 在 componentPool 中的名称 (每个实例唯一)
+    property url source
+    property var initialProperties: ({})
+    property bool active: false
+    property var item: null
+
+    signal loaded()
+
+    // 按当前的 initialProperties 开始后台创建
+    function prepare() {
+        if (!active) componentPool.prepare(key, source, initialProperties)
+    }
+
+    function discard() {
+        componentPool.discard(key)
+    }
+
+    onActiveChanged: {
+        if (active) {
+            item = componentPool.take(key, source, initialProperties)
+            if (item) loaded()
+        } else if (item) {
+            var window = item
+            item = null
+            window.destroy()
+        }
+    }
+
+    // 准备好但未取用的实例由 componentPool 在退出时回收
+    Component.onDestruction: if (item) item.destroy()
+}
@@ -54,6 +54,9 @@ Item {
         // Default tab
         tabBar.currentIndex = 0
         visible = true
+
+        // 首次打开时在后台构建输入联想索引
+        workLogSuggester.prepare()
     }
 
     function close() {
@@ -217,6 +220,7 @@ Item {
                     text: workLogOverlay.formalContent
                     onTextChanged: workLogOverlay.formalContent = text
                     accentColor: colorFormal
+                    category: 0
                 }
                 
                 // 2. Learning
@@ -225,6 +229,7 @@ Item {
                     text: workLogOverlay.learningContent
                     onTextChanged: workLogOverlay.learningContent = text
                     accentColor: colorLearning
+                    category: 1
                 }
                 
                 // 3. Personal
@@ -233,6 +238,7 @@ Item {
                     text: workLogOverlay.personalContent
                     onTextChanged: workLogOverlay.personalContent = text
                     accentColor: colorPersonal
+                    category: 2
                 }
             }
 
@@ -313,15 +319,45 @@ Item {
 
     // Helper Component for TextArea
     component TextAreaInput : Rectangle {
+        id: inputRoot
         property alias text: area.text
         property alias placeholderText: area.placeholderText
         property color accentColor: "#ffffff"
+        property int category: 0 // 0=正式工作, 1=学习成长, 2=私人事务
+        property var suggestions: []
         
         color: Qt.rgba(0, 0, 0, 0.3)
         radius: 12
         border.color: area.activeFocus ? accentColor : "transparent"
         border.width: 1
         Behavior on border.color { ColorAnimation { duration: 200 } }
+
+        // 当前行光标前的文本作为联想前缀
+        function currentLinePrefix() {
+            var before = area.text.substring(0, area.cursorPosition)
+            return before.substring(before.lastIndexOf("\n") + 1)
+        }
+
+        function refreshSuggestions() {
+            var prefix = currentLinePrefix()
+            if (!area.activeFocus || prefix.trim().length === 0) {
+                suggestions = []
+                return
+            }
+            suggestions = workLogSuggester.suggest(prefix, category, 5)
+        }
+
+        // 用选中的候选替换当前整行 (使用 remove/insert，不破坏 text 的属性绑定)
+        function acceptSuggestion(suggestion) {
+            var pos = area.cursorPosition
+            var lineStart = pos > 0 ? area.text.lastIndexOf("\n", pos - 1) + 1 : 0
+            var lineEnd = area.text.indexOf("\n", pos)
+            if (lineEnd < 0) lineEnd = area.text.length
+            area.remove(lineStart, lineEnd)
+            area.insert(lineStart, suggestion)
+            area.cursorPosition = lineStart + suggestion.length
+            suggestions = []
+        }
         
         ScrollView {
             anchors.fill: parent
@@ -335,6 +371,61 @@ Item {
                 background: null
                 placeholderTextColor: "#666666"
                 selectionColor: Qt.rgba(accentColor.r, accentColor.g, accentColor.b, 0.4)
+
+                onCursorPositionChanged: inputRoot.refreshSuggestions()
+                onActiveFocusChanged: inputRoot.refreshSuggestions()
+
+                // Tab 接受第一条候选，Esc 关闭候选列表
+                Keys.onTabPressed: {
+                    if (inputRoot.suggestions.length > 0) inputRoot.acceptSuggestion(inputRoot.suggestions[0])
+                    else event.accepted = false
+                }
+                Keys.onEscapePressed: {
+                    if (inputRoot.suggestions.length > 0) inputRoot.suggestions = []
+                    else event.accepted = false
+                }
+            }
+        }
+
+        // 联想候选列表
+        Column {
+            anchors.left: parent.left
+            anchors.right: parent.right
+            anchors.bottom: parent.bottom
+            anchors.margins: 6
+            spacing: 2
+            visible: inputRoot.suggestions.length > 0
+
+            Repeater {
+                model: inputRoot.suggestions
+                delegate: Rectangle {
+                    width: parent.width
+                    height: 28
+                    radius: 6
+                    color: suggestionMouse.containsMouse ? Qt.rgba(accentColor.r, accentColor.g, accentColor.b, 0.3) : "#E61B2A4E"
+
+                    Text {
+                        anchors.fill: parent
+                        anchors.leftMargin: 10
+                        anchors.rightMargin: 10
+                        verticalAlignment: Text.AlignVCenter
+                        text: modelData
+                        color: "white"
+                        font.pixelSize: 13
+                        elide: Text.ElideRight
+                    }
+
+                    MouseArea {
+                        id: suggestionMouse
+                        anchors.fill: parent
+                        hoverEnabled: true
+                        cursorShape: Qt.PointingHandCursor
+                        onClicked: {
+                            inputRoot.acceptSuggestion(modelData)
+                            area.forceActiveFocus()
+                        }
+                    }
+                }
             }
         }
     }
@@ -108,6 +108,14 @@ if exist "%DESKCARE_SRC%" (
     exit /b 1
 )
 
+:: Command line client (optional)
+set "CTL_SRC=build\Desktop_Qt_5_15_2_MSVC2015_64bit-Release\release\deskcare-ctl.exe"
+if exist "%CTL_SRC%" copy "%CTL_SRC%" "%DIST_DIR%" >nul
+
+:: Headless console build (optional)
+set "HEADLESS_SRC=build\Desktop_Qt_5_15_2_MSVC2015_64bit-Release\release\deskcare-headless.exe"
+if exist "%HEADLESS_SRC%" copy "%HEADLESS_SRC%" "%DIST_DIR%" >nul
+
 :: Copy Version Info
 echo [COPY] Copying version_info.json...
 copy "version_info.json" "%DIST_DIR%" >nul
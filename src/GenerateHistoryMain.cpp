@@ -0,0 +1,38 @@
+#include "GenerateHistoryMain.h"
+#include <QCoreApplication>
+#include <cstdio>
+#include "core/HistoryGenerator.h"
+
+int runGenerateHistory(int argc, char *argv[])
+{
+    QCoreApplication app(argc, argv);
+
+    HistoryGenerator::Options options;
+    QString dir;
+
+    const QStringList args = app.arguments();
+    for (int i = 1; i < args.size(); ++i) {
+        const QString& arg = args.at(i);
+        const QString value = arg.section('=', 1);
+        if (arg.startsWith("--generate-history=")) {
+            dir = value;
+        } else if (arg.startsWith("--rows=")) {
+            options.rows = value.toLongLong();
+        } else if (arg.startsWith("--seed=")) {
+            options.seed = value.toUInt();
+        } else if (arg.startsWith("--end-date=")) {
+            options.endDate = QDate::fromString(value, Qt::ISODate);
+        }
+    }
+
+    HistoryGenerator::Result result;
+    QString error;
+    if (!HistoryGenerator::generate(dir, options, &result, &error)) {
+        fprintf(stderr, "generate-history: %s\n", qPrintable(error));
+        return 1;
+    }
+    HistoryGenerator::saveResult(dir, options, result);
+    printf("%lld rows, %d days (%s .. %s)\n", result.rows, result.days,
+           qPrintable(result.firstDate.toString(Qt::ISODate)), qPrintable(result.lastDate.toString(Qt::ISODate)));
+    return 0;
+}
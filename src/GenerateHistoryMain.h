@@ -0,0 +1,13 @@
+#pragma once
+
+// ========================================================================
+// 合成历史数据 (--generate-history)
+// ========================================================================
+// 基于 QCoreApplication，不连接单实例服务器，不写日志文件，也不触碰真实
+// 活动数据库，可与正在运行的实例并存。
+//
+//   --generate-history=<目录> [--rows=N] [--seed=N] [--end-date=yyyy-MM-dd]
+//                               生成合成历史数据 (见 core/HistoryGenerator.h)
+//
+// 活动查询与统计的基准测试见 tests/benchmarks (QtTest)。
+int runGenerateHistory(int argc, char *argv[]);
@@ -0,0 +1,375 @@
+#include "SoakMain.h"
+#include <QGuiApplication>
+#include <QQmlEngine>
+#include <QQmlComponent>
+#include <QQmlContext>
+#include <QQuickWindow>
+#include <QDir>
+#include <QDirIterator>
+#include <QElapsedTimer>
+#include <QFile>
+#include <QRandomGenerator>
+#include <QTemporaryDir>
+#include <QScopedPointer>
+#include <algorithm>
+#include <functional>
+#include <cstdio>
+#include "core/AppConfig.h"
+#include "core/Clock.h"
+#include "core/TimerEngine.h"
+#include "core/ReminderScheduler.h"
+#include "core/ActivityLogger.h"
+#include "core/SqliteActivityStore.h"
+#include "core/WorkLogSuggester.h"
+#include "core/Metrics.h"
+#include "core/ProcessStats.h"
+#include "utils/QmlMemoryProbe.h"
+
+static const int kFrameTimeoutMs = 2000; // 等待窗口第一帧的上限
+static const int kWindowLingerMs = 100;  // 第一帧之后再运行一会儿 (动画、定时器)
+static const int kMinSamplesToJudge = 8;
+static const int kExitInsufficientSamples = 3; // 采样太少，无法判定 (与增长失败 1、环境错误 2 区分)
+
+namespace {
+
+struct Sample {
+    int day = 0;
+    qint64 wallMs = 0;
+    qint64 residentBytes = -1;
+    qint64 qobjects = -1;
+    int handles = -1;
+    int guiObjects = -1;
+    qint64 dbBytes = 0;
+    int overlays = 0;
+    int dashboards = 0;
+};
+
+qint64 directorySize(const QString& path) {
+    qint64 total = 0;
+    QDirIterator it(path, QDir::Files | QDir::Hidden, QDirIterator::Subdirectories);
+    while (it.hasNext()) {
+        it.next();
+        total += it.fileInfo().size();
+    }
+    return total;
+}
+
+// 中位数 (忽略 -1)
+double median(QVector<double> values) {
+    values.erase(std::remove(values.begin(), values.end(), -1.0), values.end());
+    if (values.isEmpty()) return -1;
+    std::sort(values.begin(), values.end());
+    return values.at(values.size() / 2);
+}
+
+// 模拟的一天：驱动引擎并按需加载/卸载界面
+class SoakDriver {
+public:
+    SoakDriver(VirtualClock* clock, TimerEngine* engine, QQmlEngine* qml, QObject* theme, QmlMemoryProbe* probe,
+               quint32 seed)
+        : m_clock(clock), m_engine(engine), m_qml(qml), m_theme(theme), m_probe(probe), m_rng(seed)
+        , m_overlay(qml, QUrl("qrc:/assets/qml/OverlayWindow.qml"))
+        , m_dashboard(qml, QUrl("qrc:/assets/qml/ActivityDashboard.qml"))
+    {
+        QObject::connect(engine, &TimerEngine::reminderTriggered, [this]() { m_reminded = true; });
+    }
+
+    bool isReady(QString* error) const {
+        for (const QQmlComponent* component : { &m_overlay, &m_dashboard }) {
+            if (component->isError()) {
+                *error = component->errorString();
+                return false;
+            }
+        }
+        return true;
+    }
+
+    int overlays() const { return m_overlays; }
+    int dashboards() const { return m_dashboards; }
+
+    void simulateDay() {
+        const QDate date = m_clock->now().date();
+        const bool weekend = date.dayOfWeek() >= 6;
+        const int cycles = weekend ? 2 : 8;
+
+        advanceTo(QTime(9, 0).addSecs(m_rng.bounded(1800)));
+        m_engine->startWork();
+        for (int cycle = 0; cycle < cycles; ++cycle) {
+            // 工作中途锁屏一段时间
+            if (m_rng.bounded(5) == 0) {
+                m_clock->advance(qint64(5 + m_rng.bounded(20)) * 60 * 1000);
+                m_engine->handleSystemLock(true);
+                m_clock->advance(qint64(5 + m_rng.bounded(40)) * 60 * 1000);
+                m_engine->handleSystemLock(false);
+            }
+            if (!waitForReminder()) break;
+
+            // 偶尔先贪睡一次
+            if (m_rng.bounded(7) == 0) {
+                m_engine->snooze();
+                if (!waitForReminder()) break;
+            }
+
+            showOverlay();
+            m_clock->advance(qint64(3 + m_rng.bounded(5)) * 60 * 1000);
+            m_engine->startWork();
+
+            // 午休
+            if (cycle == cycles / 2 && !weekend) {
+                m_engine->startNap();
+                m_clock->advance(qint64(20 + m_rng.bounded(15)) * 60 * 1000);
+                m_engine->stopNap();
+                m_engine->startWork();
+            }
+        }
+        m_engine->stop();
+        showDashboard();
+
+        // 推进到第二天凌晨 (期间只有压实等后台定时器)
+        advanceTo(QTime(23, 59, 59));
+        m_clock->advance(1000);
+    }
+
+private:
+    void advanceTo(const QTime& time) {
+        const QDateTime target(m_clock->now().date(), time);
+        const qint64 ms = m_clock->now().msecsTo(target);
+        if (ms > 0) m_clock->advance(ms);
+    }
+
+    bool waitForReminder() {
+        m_reminded = false;
+        // 上限 4 小时，防止配置异常时空转
+        const qint64 limit = m_clock->monotonicMs() + 4 * 3600 * 1000;
+        while (!m_reminded && m_clock->monotonicMs() < limit) {
+            if (!m_clock->advanceToNextTimer()) return false;
+        }
+        return m_reminded;
+    }
+
+    void showOverlay() {
+        QMetaObject::invokeMethod(m_theme, "generateRandomTheme");
+        showWindow(&m_overlay, "OverlayWindow", { { "themeData", m_theme->property("currentTheme") } });
+        ++m_overlays;
+    }
+
+    void showDashboard() {
+        showWindow(&m_dashboard, "ActivityDashboard", {});
+        ++m_dashboards;
+    }
+
+    // 与 Loader 的 active: true -> false 相同：创建、显示到第一帧、销毁。
+    // 前后由 QmlMemoryProbe 采样，核算每次加载/卸载是否把内存还回来
+    void showWindow(QQmlComponent* component, const QString& name, const QVariantMap& properties) {
+        QScopedPointer<QObject> object(component->createWithInitialProperties(properties, m_qml->rootContext()));
+        auto* window = qobject_cast<QQuickWindow*>(object.data());
+        if (window) {
+            bool swapped = false;
+            QObject::connect(window, &QQuickWindow::frameSwapped, window, [&swapped]() { swapped = true; },
+                             Qt::QueuedConnection);
+            window->show();
+            QElapsedTimer timer;
+            timer.start();
+            while (!swapped && timer.elapsed() < kFrameTimeoutMs) {
+                QCoreApplication::processEvents(QEventLoop::AllEvents, 10);
+            }
+            while (timer.elapsed() < kWindowLingerMs) QCoreApplication::processEvents(QEventLoop::AllEvents, 10);
+            m_probe->recordLoaded(name);
+            window->hide();
+        }
+        object.reset();
+        QCoreApplication::sendPostedEvents(nullptr, QEvent::DeferredDelete);
+        m_probe->recordUnloaded(name);
+    }
+
+    VirtualClock* m_clock;
+    TimerEngine* m_engine;
+    QQmlEngine* m_qml;
+    QObject* m_theme;
+    QmlMemoryProbe* m_probe;
+    QRandomGenerator m_rng;
+    QQmlComponent m_overlay;
+    QQmlComponent m_dashboard;
+    bool m_reminded = false;
+    int m_overlays = 0;
+    int m_dashboards = 0;
+};
+
+// ========================================================================
+// 判定
+// ========================================================================
+
+// 中段 [n/4, n/2) 与末段 [3n/4, n) 的中位数之差超过容差即视为持续增长
+bool checkGrowth(const QVector<Sample>& samples, const char* name, double absoluteTolerance,
+                 double relativeTolerance, const std::function<double(const Sample&)>& value, QString* report) {
+    const int n = samples.size();
+    QVector<double> middle, tail;
+    for (int i = n / 4; i < n / 2; ++i) middle.append(value(samples.at(i)));
+    for (int i = n * 3 / 4; i < n; ++i) tail.append(value(samples.at(i)));
+    const double a = median(middle);
+    const double b = median(tail);
+    if (a < 0 || b < 0) {
+        *report += QString("  %1: unavailable\n").arg(name, -12);
+        return true;
+    }
+    const double tolerance = qMax(absoluteTolerance, a * relativeTolerance);
+    const bool ok = b - a <= tolerance;
+    *report += QString("  %1: %2 -> %3 (tolerance +%4)%5\n").arg(name, -12).arg(a, 0, 'f', 0).arg(b, 0, 'f', 0)
+                   .arg(tolerance, 0, 'f', 0).arg(ok ? "" : "  GROWING");
+    return ok;
+}
+
+} // namespace
+
+int runSoak(int argc, char *argv[])
+{
+    // 在创建任何 QObject 之前开始计数
+    ProcessStats::trackQObjects();
+
+    QGuiApplication app(argc, argv);
+    app.setOrganizationName("TraeAI");
+    app.setApplicationName("FocusTimer");
+
+    int days = 60;
+    QString reportPath;
+    quint32 seed = 1;
+    for (const QString& arg : app.arguments()) {
+        if (arg.startsWith("--soak=")) days = qMax(1, arg.mid(7).toInt());
+        else if (arg.startsWith("--soak-report=")) reportPath = arg.mid(14);
+        else if (arg.startsWith("--soak-seed=")) seed = arg.mid(12).toUInt();
+    }
+
+    QTemporaryDir dataDir;
+    if (!dataDir.isValid()) {
+        fputs("soak: cannot create a temporary directory\n", stderr);
+        return 2;
+    }
+
+    // ---- 核心模块 (虚拟时间、临时数据库、不写运动统计) ----
+    VirtualClock clock(QDateTime(QDate::currentDate(), QTime(0, 0)));
+    TimerEngine timerEngine(&clock);
+    timerEngine.setPersistStats(false);
+    timerEngine.stop();
+    ReminderScheduler reminderScheduler(&timerEngine);
+    ActivityLogger activityLogger(&timerEngine, new SqliteActivityStore(dataDir.path(), "soak"));
+    WorkLogSuggester workLogSuggester(&activityLogger);
+    AppConfig appConfig;
+    // 附加提醒视为立即完成 (托盘气泡点击)
+    QObject::connect(&reminderScheduler, &ReminderScheduler::remindersDue,
+                     &reminderScheduler, &ReminderScheduler::completeAll);
+
+    // ---- QML (与 main.cpp 相同的上下文属性) ----
+    QQmlEngine engine;
+    qmlRegisterUncreatableType<TimerEngine>("DeskCare", 1, 0, "TimerEngine",
+                                            "TimerEngine is provided via the timerEngine context property");
+    engine.rootContext()->setContextProperty("timerEngine", &timerEngine);
+    engine.rootContext()->setContextProperty("reminderScheduler", &reminderScheduler);
+    engine.rootContext()->setContextProperty("activityLogger", &activityLogger);
+    engine.rootContext()->setContextProperty("workLogSuggester", &workLogSuggester);
+    engine.rootContext()->setContextProperty("appConfig", &appConfig);
+    engine.rootContext()->setContextProperty("metrics", Metrics::instance());
+
+    QQmlComponent themeComponent(&engine, QUrl("qrc:/assets/qml/ThemeController.qml"));
+    QScopedPointer<QObject> theme(themeComponent.create());
+    if (!theme) {
+        fprintf(stderr, "soak: %s\n", qPrintable(themeComponent.errorString()));
+        return 2;
+    }
+    QmlMemoryProbe probe(&engine, 0);
+    probe.recordBaseline("OverlayWindow");
+    probe.recordBaseline("ActivityDashboard");
+    SoakDriver driver(&clock, &timerEngine, &engine, theme.data(), &probe, seed);
+    QString error;
+    if (!driver.isReady(&error)) {
+        fprintf(stderr, "soak: %s\n", qPrintable(error));
+        return 2;
+    }
+
+    QFile report(reportPath);
+    if (!reportPath.isEmpty()) {
+        if (!report.open(QIODevice::WriteOnly | QIODevice::Truncate | QIODevice::Text)) {
+            fprintf(stderr, "soak: cannot write %s\n", qPrintable(reportPath));
+            return 2;
+        }
+        report.write("day,wall_s,rss_kb,qobjects,handles,gui_objects,db_bytes,overlays,dashboards\n");
+    }
+
+    // ---- 运行 ----
+    const int sampleEvery = qMax(1, days / 30);
+    QVector<Sample> samples;
+    QElapsedTimer wall;
+    wall.start();
+    for (int day = 1; day <= days; ++day) {
+        driver.simulateDay();
+        if (day % sampleEvery != 0 && day != days) continue;
+
+        // 采样前回收 JS 垃圾与延迟删除的对象，读数反映稳定状态
+        engine.collectGarbage();
+        QCoreApplication::sendPostedEvents(nullptr, QEvent::DeferredDelete);
+        QCoreApplication::processEvents();
+
+        Sample sample;
+        sample.day = day;
+        sample.wallMs = wall.elapsed();
+        sample.residentBytes = ProcessStats::residentBytes();
+        sample.qobjects = ProcessStats::liveQObjects();
+        sample.handles = ProcessStats::openHandles();
+        sample.guiObjects = ProcessStats::guiObjects();
+        sample.dbBytes = directorySize(dataDir.path());
+        sample.overlays = driver.overlays();
+        sample.dashboards = driver.dashboards();
+        samples.append(sample);
+
+        const QString line = QString("%1,%2,%3,%4,%5,%6,%7,%8,%9\n").arg(sample.day).arg(sample.wallMs / 1000.0, 0, 'f', 1)
+                .arg(sample.residentBytes < 0 ? -1 : sample.residentBytes / 1024).arg(sample.qobjects)
+                .arg(sample.handles).arg(sample.guiObjects).arg(sample.dbBytes).arg(sample.overlays).arg(sample.dashboards);
+        if (report.isOpen()) {
+            report.write(line.toUtf8());
+            report.flush();
+        }
+        fprintf(stderr, "day %d/%d  rss %lld KB  qobjects %lld  handles %d  db %lld KB\n", day, days,
+                sample.residentBytes / 1024, sample.qobjects, sample.handles, sample.dbBytes / 1024);
+    }
+
+    // ---- 判定 ----
+    if (samples.size() < kMinSamplesToJudge) {
+        fprintf(stderr, "soak: FAILED: insufficient samples (%d, need at least %d); run more days\n",
+                int(samples.size()), kMinSamplesToJudge);
+        return kExitInsufficientSamples;
+    }
+
+    QString summary;
+    bool ok = true;
+    ok &= checkGrowth(samples, "rss", 8.0 * 1024 * 1024, 0.10,
+                      [](const Sample& s) { return double(s.residentBytes); }, &summary);
+    ok &= checkGrowth(samples, "qobjects", 200, 0.02, [](const Sample& s) { return double(s.qobjects); }, &summary);
+    ok &= checkGrowth(samples, "handles", 16, 0, [](const Sample& s) { return double(s.handles); }, &summary);
+    ok &= checkGrowth(samples, "gui_objects", 50, 0, [](const Sample& s) { return double(s.guiObjects); }, &summary);
+
+    // 数据库随历史线性增长是正常的；每天的增量变大 (例如日志不再压实、索引失效) 才是问题
+    const int n = samples.size();
+    const Sample& first = samples.at(n / 4);
+    const Sample& middle = samples.at(n / 2);
+    const Sample& last = samples.last();
+    const double earlyRate = double(middle.dbBytes - first.dbBytes) / qMax(1, middle.day - first.day);
+    const double lateRate = double(last.dbBytes - middle.dbBytes) / qMax(1, last.day - middle.day);
+    const bool dbOk = lateRate <= earlyRate * 1.5 + 4096;
+    ok &= dbOk;
+    summary += QString("  %1: %2 -> %3 bytes/day%4\n").arg("db_growth", -12).arg(earlyRate, 0, 'f', 0)
+                   .arg(lateRate, 0, 'f', 0).arg(dbOk ? "" : "  ACCELERATING");
+
+    // 每个组件单次加载/卸载的残留 (与上面的整体趋势互补：能指出是哪个组件)
+    for (const QString& component : { QStringLiteral("OverlayWindow"), QStringLiteral("ActivityDashboard") }) {
+        QString failure;
+        if (!probe.expectReleased(component, &failure)) {
+            ok = false;
+            summary += failure;
+        }
+    }
+    summary += "\n" + probe.report();
+
+    fprintf(stderr, "\nSoak: %d simulated days, %d overlays, %d dashboards, %.1f s\n%s%s\n", days, driver.overlays(),
+            driver.dashboards(), wall.elapsed() / 1000.0, summary.toUtf8().constData(),
+            ok ? "PASS" : "FAIL: unbounded growth");
+    return ok ? 0 : 1;
+}
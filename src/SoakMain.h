@@ -0,0 +1,23 @@
+#pragma once
+
+// ========================================================================
+// 长时间运行检查 (--soak)
+// ========================================================================
+// 用 VirtualClock 加速驱动真实的 TimerEngine / ActivityLogger (SQLite，
+// 临时目录) / ReminderScheduler，模拟数月的日常使用：每天若干轮工作与
+// 提醒，夹杂贪睡、锁屏/解锁、午休；每次提醒创建并销毁一次全屏提醒窗口
+// (OverlayWindow.qml)，每天结束时打开并关闭一次活动看板
+// (ActivityDashboard.qml)，与 Main.qml 中 Loader 的加载/卸载一致。
+//
+// 定期采样常驻内存、存活 QObject 数量、打开的句柄 (Windows 另计 GDI/USER
+// 对象) 与数据库目录大小 (见 core/ProcessStats.h)。结束时比较运行中段与
+// 末段的中位数，任何一项持续增长超过容差 (数据库则为增长速度变快) 即判定
+// 失败，退出码为 1。每次窗口加载/卸载另由 QmlMemoryProbe 核算，某个组件
+// 平均每次残留超过容差时同样失败 (见 utils/QmlMemoryProbe.h)。
+// 采样少于 8 次 (模拟天数太少) 时无法判定，退出码为 3；环境错误为 2。
+//
+//   --soak[=<模拟天数>]     默认 60 天
+//   --soak-report=<文件>    采样结果写为 CSV
+//   --soak-seed=N           随机序列 (同样的种子得到同样的操作序列)
+// 窗口会实际显示；在没有显示器的环境中可加 -platform offscreen。
+int runSoak(int argc, char *argv[]);
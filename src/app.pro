@@ -0,0 +1,58 @@
+QT += core gui qml quick widgets svg network sql
+
+CONFIG += c++17
+
+TARGET = DeskCare
+TEMPLATE = app
+
+include(core/core.pri)
+
+SOURCES += \
+    main.cpp \
+    GenerateHistoryMain.cpp \
+    SoakMain.cpp \
+    gui/TrayIcon.cpp \
+    utils/WindowUtils.cpp \
+    utils/WakeupAuditor.cpp \
+    utils/QmlMemoryProbe.cpp \
+    utils/ComponentPool.cpp \
+    utils/ForegroundAppMonitor.cpp
+
+HEADERS += \
+    GenerateHistoryMain.h \
+    SoakMain.h \
+    gui/TrayIcon.h \
+    utils/WindowUtils.h \
+    utils/WakeupAuditor.h \
+    utils/QmlMemoryProbe.h \
+    utils/ComponentPool.h \
+    utils/ForegroundAppMonitor.h
+
+# Linux: 在场检测 (logind 锁屏 / Mutter 空闲) 走 D-Bus，前台窗口查询走 xcb
+linux {
+    QT += dbus
+    LIBS += -lxcb
+    SOURCES += utils/LinuxPresence.cpp
+    HEADERS += utils/LinuxPresence.h
+}
+
+RESOURCES += ../resources.qrc
+
+# QmlMemoryProbe 读取 JS 堆统计需要 QtQml 私有头文件；没有安装时该项显示为不可用
+qtHaveModule(qml-private) {
+    QT += qml-private
+    DEFINES += DESKCARE_HAVE_QML_PRIVATE
+}
+
+# Windows: 保持 <构建目录>/release/DeskCare.exe 的位置 (打包脚本依赖)
+win32 {
+    CONFIG(debug, debug|release): DESTDIR = $$shadowed($$PWD/..)/debug
+    else: DESTDIR = $$shadowed($$PWD/..)/release
+}
+
+# High DPI support for Windows
+windows:MANIFEST_DEPENDENCIES += "type='win32' name='Microsoft.Windows.Common-Controls' version='6.0.0.0' processorArchitecture='*' publicKeyToken='6595b64144ccf1df' language='*'"
+win32:LIBS += -luser32 -lwtsapi32
+
+# Fix for MSVC "C2001: newline in constant" error due to UTF-8 encoding with Chinese comments
+msvc:QMAKE_CXXFLAGS += /utf-8
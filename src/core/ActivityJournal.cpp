@@ -0,0 +1,153 @@
+#include "ActivityJournal.h"
+#include "Logging.h"
+#include <QtEndian>
+#include <cstring>
+
+static const char kJournalMagic[4] = { 'D', 'C', 'J', '1' };
+
+ActivityJournal::ActivityJournal(const QString& path, int capacity)
+    : m_file(path), m_capacity(capacity)
+{
+}
+
+ActivityJournal::~ActivityJournal() {
+    if (m_file.isOpen()) {
+        m_file.close();
+    }
+}
+
+bool ActivityJournal::open() {
+    // Unbuffered: 每次 append 直接对应一次 write 系统调用，进程崩溃也不会丢失
+    if (!m_file.open(QIODevice::ReadWrite | QIODevice::Unbuffered)) {
+        qCWarning(lcDb) << "ActivityJournal: cannot open" << m_file.fileName() << m_file.errorString();
+        return false;
+    }
+
+    const qint64 expectedSize = HEADER_SIZE + qint64(m_capacity) * RECORD_SIZE;
+
+    // 校验头部，不匹配 (新文件/旧格式/容量变化) 时丢弃重建
+    char header[HEADER_SIZE];
+    bool valid = m_file.size() >= HEADER_SIZE
+                 && m_file.read(header, HEADER_SIZE) == HEADER_SIZE
+                 && std::memcmp(header, kJournalMagic, 4) == 0
+                 && qFromLittleEndian<quint32>(header + 4) == quint32(RECORD_SIZE)
+                 && qFromLittleEndian<quint32>(header + 8) == quint32(m_capacity);
+
+    if (!valid) {
+        if (m_file.size() > 0) {
+            qCWarning(lcDb) << "ActivityJournal: header mismatch, recreating" << m_file.fileName();
+        }
+        m_file.resize(0);
+        if (!writeHeader()) return false;
+    }
+
+    // 预分配：之后的追加写不会再改变文件大小
+    if (m_file.size() != expectedSize && !m_file.resize(expectedSize)) {
+        qCWarning(lcDb) << "ActivityJournal: cannot preallocate" << m_file.errorString();
+        return false;
+    }
+
+    m_count = 0;
+    return true;
+}
+
+bool ActivityJournal::writeHeader() {
+    char header[HEADER_SIZE] = {};
+    std::memcpy(header, kJournalMagic, 4);
+    qToLittleEndian<quint32>(RECORD_SIZE, header + 4);
+    qToLittleEndian<quint32>(quint32(m_capacity), header + 8);
+    return m_file.seek(0) && m_file.write(header, HEADER_SIZE) == HEADER_SIZE;
+}
+
+QVector<ActivityJournal::Entry> ActivityJournal::readAll() {
+    QVector<Entry> entries;
+    if (!m_file.isOpen()) return entries;
+
+    m_file.seek(HEADER_SIZE);
+    const QByteArray data = m_file.read(qint64(m_capacity) * RECORD_SIZE);
+
+    const int available = data.size() / RECORD_SIZE;
+    for (int i = 0; i < available; ++i) {
+        Entry entry;
+        if (!decode(data.constData() + i * RECORD_SIZE, &entry)) break; // 到达末尾
+        entries.append(entry);
+    }
+
+    m_count = entries.size();
+    return entries;
+}
+
+bool ActivityJournal::append(const Entry& entry) {
+    if (!m_file.isOpen() || isFull()) return false;
+
+    char buffer[RECORD_SIZE];
+    encode(entry, buffer);
+
+    if (!m_file.seek(HEADER_SIZE + qint64(m_count) * RECORD_SIZE)
+        || m_file.write(buffer, RECORD_SIZE) != RECORD_SIZE) {
+        qCWarning(lcDb) << "ActivityJournal: append failed" << m_file.errorString();
+        return false;
+    }
+
+    m_count++;
+    return true;
+}
+
+bool ActivityJournal::reset() {
+    if (!m_file.isOpen()) return false;
+    if (m_count == 0) return true;
+
+    // 只清零已使用的区域 (一次写)，文件大小保持不变
+    const QByteArray zeros(m_count * RECORD_SIZE, '\0');
+    if (!m_file.seek(HEADER_SIZE) || m_file.write(zeros) != zeros.size()) {
+        qCWarning(lcDb) << "ActivityJournal: reset failed" << m_file.errorString();
+        return false;
+    }
+
+    m_count = 0;
+    return true;
+}
+
+void ActivityJournal::encode(const Entry& entry, char* buffer) {
+    std::memset(buffer, 0, RECORD_SIZE);
+    qToLittleEndian<quint32>(entry.seq, buffer);
+    buffer[4] = char(entry.state);
+    buffer[5] = char(entry.flags | Flag_Valid);
+    qToLittleEndian<qint64>(entry.start, buffer + 8);
+    qToLittleEndian<qint64>(entry.end, buffer + 16);
+    qToLittleEndian<quint16>(qChecksum(buffer, RECORD_SIZE - 2), buffer + 30);
+}
+
+bool ActivityJournal::decode(const char* buffer, Entry* entry) {
+    if (!(quint8(buffer[5]) & Flag_Valid)) return false;
+    if (qFromLittleEndian<quint16>(buffer + 30) != qChecksum(buffer, RECORD_SIZE - 2)) return false;
+
+    entry->seq = qFromLittleEndian<quint32>(buffer);
+    entry->state = quint8(buffer[4]);
+    entry->flags = quint8(buffer[5]);
+    entry->start = qFromLittleEndian<qint64>(buffer + 8);
+    entry->end = qFromLittleEndian<qint64>(buffer + 16);
+    return true;
+}
+
+quint8 ActivityJournal::stateCode(const QString& state) {
+    if (state == "Focus") return 0;
+    if (state == "Rest") return 1;
+    if (state == "Nap") return 2;
+    if (state == "Pause") return 3;
+    if (state == "Offline") return 4;
+    if (state == "Ready") return 5;
+    return 255;
+}
+
+QString ActivityJournal::stateName(quint8 code) {
+    switch (code) {
+        case 0: return "Focus";
+        case 1: return "Rest";
+        case 2: return "Nap";
+        case 3: return "Pause";
+        case 4: return "Offline";
+        case 5: return "Ready";
+        default: return "Unknown";
+    }
+}
@@ -0,0 +1,69 @@
+#pragma once
+
+#include <QFile>
+#include <QString>
+#include <QVector>
+
+// ========================================================================
+// ActivityJournal：追加写的二进制会话日志
+// ========================================================================
+// 作用：作为会话记录的主写入路径。每次状态切换只向预分配好的文件追加
+// 一条 32 字节的定长记录 (一次小的 write 调用)，不再为每条记录开启一次
+// SQLite 事务；SqliteActivityStore 会批量把日志"压实"进数据库。
+// 程序异常退出后，启动时重放尚未压实的记录，保证不丢数据。
+//
+// 文件格式 (小端)：
+//   头部 16 字节:  "DCJ1" | recordSize(u32) | capacity(u32) | reserved(u32)
+//   记录 32 字节:  seq(u32) | state(u8) | flags(u8) | reserved(u16)
+//                  | start(i64) | end(i64) | reserved(u16) | crc16(u16)
+// 全零或校验失败的记录视为日志末尾 (写到一半被中断的记录会被忽略)。
+// ========================================================================
+class ActivityJournal {
+public:
+    struct Entry {
+        quint32 seq = 0;     // 单调递增序号，用于判断是否已压实
+        quint8 state = 0;    // 见 stateCode()
+        quint8 flags = 0;    // Flag_*
+        qint64 start = 0;    // 秒
+        qint64 end = 0;      // 秒
+    };
+
+    enum Flags : quint8 {
+        Flag_Valid = 0x01    // 区分有效记录与预分配的零字节
+    };
+
+    static const int RECORD_SIZE = 32;
+    static const int HEADER_SIZE = 16;
+
+    explicit ActivityJournal(const QString& path, int capacity = 2048);
+    ~ActivityJournal();
+
+    // 打开或创建日志文件，并预分配 capacity 条记录的空间
+    bool open();
+    bool isOpen() const { return m_file.isOpen(); }
+
+    // 读取全部有效记录 (按写入顺序)，并把写指针定位到其后
+    QVector<Entry> readAll();
+
+    // 追加一条记录 (单次 write，无缓冲)
+    bool append(const Entry& entry);
+
+    // 清空已写入的记录 (压实成功后调用)
+    bool reset();
+
+    int count() const { return m_count; }
+    bool isFull() const { return m_count >= m_capacity; }
+
+    // 状态字符串与 u8 编码互转
+    static quint8 stateCode(const QString& state);
+    static QString stateName(quint8 code);
+
+private:
+    bool writeHeader();
+    static void encode(const Entry& entry, char* buffer);
+    static bool decode(const char* buffer, Entry* entry);
+
+    QFile m_file;
+    int m_capacity;
+    int m_count = 0; // 已写入的记录数
+};
@@ -1,13 +1,26 @@
 #include "ActivityLogger.h"
+#include "SqliteActivityStore.h"
+#include "Metrics.h"
+#include "Logging.h"
 #include <QStandardPaths>
-#include <QDir>
-#include <QDebug>
-#include <QSqlError>
 
 ActivityLogger::ActivityLogger(TimerEngine* engine, QObject *parent)
-    : QObject(parent), m_engine(engine), m_currentState(TimerEngine::State_Offline)
+    : ActivityLogger(engine, new SqliteActivityStore(QStandardPaths::writableLocation(QStandardPaths::AppDataLocation)), parent)
 {
-    initDatabase();
+}
+
+ActivityLogger::ActivityLogger(TimerEngine* engine, ActivityStore* store, QObject *parent)
+    : QObject(parent), m_store(store), m_engine(engine)
+    , m_clock(engine ? engine->clock() : Clock::system())
+    , m_currentState(TimerEngine::State_Offline)
+{
+    init();
+}
+
+void ActivityLogger::init() {
+    m_compactTimer = m_clock->createTimer(this);
+    m_compactTimer->setObjectName("compact");
+    connect(m_compactTimer, &ClockTimer::timeout, this, [this]() { m_store->flush(); });
 
     if (m_engine) {
         connect(m_engine, &TimerEngine::activityStateChanged, this, &ActivityLogger::onActivityStateChanged);
@@ -16,7 +29,7 @@ ActivityLogger::ActivityLogger(TimerEngine* engine, QObject *parent)
         
         // Initialize with current engine state
         m_currentState = m_engine->currentActivityState();
-        m_currentStartTime = QDateTime::currentDateTime();
+        m_currentStartTime = m_clock->now();
         
         // If engine is already running (e.g. started before Logger), log it.
         // But usually Logger is created at startup.
@@ -26,53 +39,7 @@ ActivityLogger::ActivityLogger(TimerEngine* engine, QObject *parent)
 
 ActivityLogger::~ActivityLogger() {
     closeCurrentSession();
-    if (m_db.isOpen()) {
-        m_db.close();
-    }
-}
-
-void ActivityLogger::initDatabase() {
-    QString dataDir = QStandardPaths::writableLocation(QStandardPaths::AppDataLocation);
-    QDir dir(dataDir);
-    if (!dir.exists()) {
-        dir.mkpath(".");
-    }
-
-    QString dbPath = dir.filePath("activity_log.db");
-    m_db = QSqlDatabase::addDatabase("QSQLITE");
-    m_db.setDatabaseName(dbPath);
-
-    if (!m_db.open()) {
-        qCritical() << "Error opening database:" << m_db.lastError();
-        return;
-    }
-
-    QSqlQuery query;
-    // Create table if not exists
-    // id, state (text), start_time (int timestamp), end_time (int timestamp), duration (int seconds)
-    QString createTable = R"(
-        CREATE TABLE IF NOT EXISTS activity_log (
-            id INTEGER PRIMARY KEY AUTOINCREMENT,
-            state TEXT,
-            start_time INTEGER,
-            end_time INTEGER,
-            duration INTEGER
-        )
-    )";
-
-    if (!query.exec(createTable)) {
-        qCritical() << "Error creating table:" << query.lastError();
-    } else {
-        m_dbInitialized = true;
-        
-        // Check and add new columns if they don't exist (Migration)
-        // content TEXT, work_type INTEGER
-        // SQLite doesn't support IF NOT EXISTS for ADD COLUMN, so we just try and ignore error
-        // or check pragma, but try-catch is simpler here since we just want to ensure they exist.
-        
-        query.exec("ALTER TABLE activity_log ADD COLUMN content TEXT");
-        query.exec("ALTER TABLE activity_log ADD COLUMN work_type INTEGER DEFAULT 0");
-    }
+    m_store->flush();
 }
 
 void ActivityLogger::onActivityStateChanged(TimerEngine::ActivityState newState) {
@@ -83,7 +50,7 @@ void ActivityLogger::onActivityStateChanged(TimerEngine::ActivityState newState)
 }
 
 void ActivityLogger::onManualExerciseRecorded(int durationSeconds) {
-    if (!m_dbInitialized || durationSeconds <= 0) return;
+    if (!m_store->isOpen() || durationSeconds <= 0) return;
 
     // 智能防重复逻辑：
     // 如果当前系统状态已经是 Rest，并且当前会话持续时间与记录的时间相近，
@@ -109,7 +76,7 @@ void ActivityLogger::onManualExerciseRecorded(int durationSeconds) {
     // 结果：数据库里有两条 300s 的 Rest 记录。统计变 600s。这是错误的。
     
     if (m_currentState == TimerEngine::State_Rest) {
-        qDebug() << "Manual exercise recorded while in Rest state. Trusting auto-logger to handle this session.";
+        qCDebug(lcDb) << "Manual exercise recorded while in Rest state. Trusting auto-logger to handle this session.";
         return; 
     }
 
@@ -117,7 +84,7 @@ void ActivityLogger::onManualExerciseRecorded(int durationSeconds) {
     // 这种情况通常发生在用户在工作状态下手动触发运动，或者系统状态尚未切换。
     // 为了避免"Ongoing Session"覆盖这条手动记录（导致显示为蓝色覆盖绿色），我们需要截断当前会话。
     
-    QDateTime now = QDateTime::currentDateTime();
+    QDateTime now = m_clock->now();
     QDateTime exerciseStartTime = now.addSecs(-durationSeconds);
     
     // 1. 截断当前会话 (Ending at exerciseStartTime)
@@ -131,17 +98,18 @@ void ActivityLogger::onManualExerciseRecorded(int durationSeconds) {
     closeCurrentSession(splitTime);
     
     // 2. 插入手动记录 (Rest)
-    QSqlQuery query;
-    query.prepare("INSERT INTO activity_log (state, start_time, end_time, duration) VALUES (?, ?, ?, ?)");
-    query.addBindValue("Rest"); // 强制标记为 Rest
-    query.addBindValue(exerciseStartTime.toSecsSinceEpoch());
-    query.addBindValue(now.toSecsSinceEpoch());
-    query.addBindValue(durationSeconds);
-
-    if (!query.exec()) {
-        qWarning() << "Failed to insert manual exercise record:" << query.lastError();
+    ActivityRecord record;
+    record.state = "Rest"; // 强制标记为 Rest
+    record.startTime = exerciseStartTime.toSecsSinceEpoch();
+    record.endTime = now.toSecsSinceEpoch();
+    record.duration = durationSeconds;
+
+    if (m_store->appendSession(record) < 0) {
+        qCWarning(lcDb) << "Failed to insert manual exercise record";
     } else {
-        qDebug() << "Inserted manual exercise record (compensating for non-Rest state):" << durationSeconds << "s";
+        qCDebug(lcDb) << "Inserted manual exercise record (compensating for non-Rest state):" << durationSeconds << "s";
+        ++m_revision;
+        if (!m_compactTimer->isActive()) m_compactTimer->start(COMPACT_DELAY_MS);
     }
     
     // 3. 重新开始当前状态的会话 (Starting from now)
@@ -149,14 +117,43 @@ void ActivityLogger::onManualExerciseRecorded(int durationSeconds) {
     startNewSession(m_currentState);
 }
 
+void ActivityLogger::onReminderStarted(const QString& kindId, const QString& logState) {
+    if (logState.isEmpty()) return;
+    m_reminderSessions.insert(kindId, qMakePair(logState, m_clock->now()));
+}
+
+void ActivityLogger::onReminderFinished(const QString& kindId, int maxSeconds) {
+    if (!m_reminderSessions.contains(kindId)) return;
+    const QPair<QString, QDateTime> session = m_reminderSessions.take(kindId);
+    if (!m_store->isOpen()) return;
+
+    QDateTime endTime = m_clock->now();
+    qint64 duration = session.second.secsTo(endTime);
+    if (maxSeconds > 0) duration = qMin<qint64>(duration, maxSeconds);
+    if (duration <= 0) return;
+
+    ReminderRecord record;
+    record.kind = session.first;
+    record.startTime = endTime.toSecsSinceEpoch() - duration;
+    record.endTime = endTime.toSecsSinceEpoch();
+    record.duration = (int)duration;
+
+    if (m_store->appendReminder(record)) {
+        qCDebug(lcDb) << "Logged reminder:" << kindId << duration << "s";
+        ++m_revision;
+    }
+}
+
 void ActivityLogger::closeCurrentSession(const QDateTime& customEndTime) {
-    if (!m_dbInitialized) return;
+    if (!m_store->isOpen()) return;
+    static MetricHistogram *s_latency = Metrics::instance()->histogram("activity.closeCurrentSession");
+    MetricTimer timer(s_latency);
     
-    QDateTime endTime = customEndTime.isValid() ? customEndTime : QDateTime::currentDateTime();
+    QDateTime endTime = customEndTime.isValid() ? customEndTime : m_clock->now();
     
     // 如果结束时间早于开始时间，直接忽略 (无效会话)
     if (endTime < m_currentStartTime) {
-        qDebug() << "Ignoring invalid session duration (end < start):" << stateToString(m_currentState);
+        qCDebug(lcDb) << "Ignoring invalid session duration (end < start):" << stateToString(m_currentState);
         return;
     }
     
@@ -164,23 +161,103 @@ void ActivityLogger::closeCurrentSession(const QDateTime& customEndTime) {
 
     // If duration is too short (e.g. < 1s), maybe ignore? But for timeline accuracy, keep it.
     
-    QSqlQuery query;
-    query.prepare("INSERT INTO activity_log (state, start_time, end_time, duration) VALUES (?, ?, ?, ?)");
-    query.addBindValue(stateToString(m_currentState));
-    query.addBindValue(m_currentStartTime.toSecsSinceEpoch());
-    query.addBindValue(endTime.toSecsSinceEpoch());
-    query.addBindValue(duration);
-
-    if (!query.exec()) {
-        qWarning() << "Failed to log session:" << query.lastError();
-    } else {
-        qDebug() << "Logged session:" << stateToString(m_currentState) << duration << "s";
+    ActivityRecord record;
+    record.state = stateToString(m_currentState);
+    record.startTime = m_currentStartTime.toSecsSinceEpoch();
+    record.endTime = endTime.toSecsSinceEpoch();
+    record.duration = (int)duration;
+
+    const bool stored = m_store->appendSession(record) >= 0;
+    if (stored) {
+        qCDebug(lcDb) << "Logged session:" << stateToString(m_currentState) << duration << "s";
+        ++m_revision;
+        if (!m_compactTimer->isActive()) m_compactTimer->start(COMPACT_DELAY_MS);
     }
+    // 会话没有写入时应用时长无处归属，不写 (startNewSession 会清空)
+    if (stored && m_currentState == TimerEngine::State_Focus) flushAppUsage(record.startTime);
 }
 
 void ActivityLogger::startNewSession(TimerEngine::ActivityState state) {
     m_currentState = state;
-    m_currentStartTime = QDateTime::currentDateTime();
+    m_currentStartTime = m_clock->now();
+    m_foregroundSinceMs = m_clock->monotonicMs();
+    m_appMs.clear();
+    ++m_revision; // 进行中的会话换了状态
+}
+
+// ========================================================================
+// 前台应用时长
+// ========================================================================
+
+void ActivityLogger::onForegroundAppChanged(const QString& app) {
+    if (app == m_foregroundApp) return; // 只有标题变化
+    accrueForegroundApp();
+    m_foregroundApp = app;
+}
+
+void ActivityLogger::accrueForegroundApp() {
+    const qint64 now = m_clock->monotonicMs();
+    if (m_currentState == TimerEngine::State_Focus && !m_foregroundApp.isEmpty() && now > m_foregroundSinceMs) {
+        m_appMs[m_foregroundApp] += now - m_foregroundSinceMs;
+    }
+    m_foregroundSinceMs = now;
+}
+
+void ActivityLogger::flushAppUsage(qint64 sessionStart) {
+    accrueForegroundApp();
+    if (m_appMs.isEmpty()) return;
+
+    // 不足 1 秒的切换不记录
+    QVector<AppUsage> usage;
+    for (auto it = m_appMs.constBegin(); it != m_appMs.constEnd(); ++it) {
+        if (it.value() < 1000) continue;
+        AppUsage entry;
+        entry.app = it.key();
+        entry.seconds = int(it.value() / 1000);
+        usage.append(entry);
+    }
+    m_appMs.clear();
+
+    if (usage.isEmpty()) return;
+    if (m_store->appendAppUsage(sessionStart, usage)) {
+        ++m_revision;
+    } else {
+        qCWarning(lcDb) << "Failed to log app usage for session starting at" << sessionStart;
+    }
+}
+
+QVariantList ActivityLogger::getAppUsage(const QDate& date) {
+    QVariantList list;
+    if (!m_store->isOpen()) return list;
+
+    const qint64 startTs = QDateTime(date, QTime(0, 0, 0)).toSecsSinceEpoch();
+    const qint64 endTs = QDateTime(date, QTime(23, 59, 59)).toSecsSinceEpoch();
+    const QVector<AppUsage> usage = m_store->appUsage(startTs, endTs);
+    for (const AppUsage& entry : usage) {
+        QVariantMap map;
+        map["app"] = entry.app;
+        map["seconds"] = entry.seconds;
+        list.append(map);
+    }
+    return list;
+}
+
+QVariantList ActivityLogger::getReminders(const QDate& date) {
+    QVariantList list;
+    if (!m_store->isOpen()) return list;
+
+    const qint64 startTs = QDateTime(date, QTime(0, 0, 0)).toSecsSinceEpoch();
+    const qint64 endTs = QDateTime(date, QTime(23, 59, 59)).toSecsSinceEpoch();
+    const QVector<ReminderRecord> reminders = m_store->reminders(startTs, endTs);
+    for (const ReminderRecord& record : reminders) {
+        QVariantMap map;
+        map["kind"] = record.kind;
+        map["startTime"] = record.startTime * 1000;
+        map["endTime"] = record.endTime * 1000;
+        map["duration"] = record.duration;
+        list.append(map);
+    }
+    return list;
 }
 
 QString ActivityLogger::stateToString(TimerEngine::ActivityState state) {
@@ -200,58 +277,56 @@ int ActivityLogger::stateToColorType(TimerEngine::ActivityState state) {
     return (int)state;
 }
 
+int ActivityLogger::stateStringToType(const QString& stateStr) {
+    if (stateStr == "Focus") return 0; // Blue
+    if (stateStr == "Rest") return 1;  // Green
+    if (stateStr == "Nap") return 2;   // Purple
+    if (stateStr == "Pause") return 3; // Gray
+    return 4; // Dark/Other
+}
+
+QVariantMap ActivityLogger::recordToMap(const ActivityRecord& record) {
+    QVariantMap map;
+    map["id"] = record.id;
+    map["state"] = record.state;
+    map["startTime"] = record.startTime * 1000; // JS uses milliseconds
+    map["endTime"] = record.endTime * 1000;
+    map["duration"] = record.duration;
+    map["content"] = record.content;
+    map["workType"] = record.workType;
+    // Map state string back to a display friendly name or type
+    map["type"] = stateStringToType(record.state);
+    return map;
+}
+
 QVariantList ActivityLogger::getDailyActivities(const QDate& date) {
     QVariantList list;
-    if (!m_dbInitialized) return list;
+    if (!m_store->isOpen()) return list;
+    static MetricHistogram *s_latency = Metrics::instance()->histogram("activity.getDailyActivities");
+    MetricTimer timer(s_latency);
 
     QDateTime dayStart(date, QTime(0, 0, 0));
     QDateTime dayEnd(date, QTime(23, 59, 59));
     qint64 startTs = dayStart.toSecsSinceEpoch();
     qint64 endTs = dayEnd.toSecsSinceEpoch();
 
-    QSqlQuery query;
-    query.prepare("SELECT id, state, start_time, end_time, duration, content, work_type FROM activity_log WHERE start_time >= ? AND start_time <= ? ORDER BY start_time ASC");
-    query.addBindValue(startTs);
-    query.addBindValue(endTs);
-
-    if (query.exec()) {
-        while (query.next()) {
-            QVariantMap map;
-            int id = query.value(0).toInt();
-            QString stateStr = query.value(1).toString();
-            qint64 sTime = query.value(2).toLongLong();
-            qint64 eTime = query.value(3).toLongLong();
-            int duration = query.value(4).toInt();
-            QString content = query.value(5).toString();
-            int workType = query.value(6).toInt();
-
-            map["id"] = id;
-            map["state"] = stateStr;
-            map["startTime"] = sTime * 1000; // JS uses milliseconds
-            map["endTime"] = eTime * 1000;
-            map["duration"] = duration;
-            map["content"] = content;
-            map["workType"] = workType;
-            
-            // Map state string back to a display friendly name or type
-            if (stateStr == "Focus") map["type"] = 0; // Blue
-            else if (stateStr == "Rest") map["type"] = 1; // Green
-            else if (stateStr == "Nap") map["type"] = 2; // Purple
-            else if (stateStr == "Pause") map["type"] = 3; // Gray
-            else map["type"] = 4; // Dark/Other
-
-            list.append(map);
-        }
+    ActivityQuery query;
+    query.startTs = startTs;
+    query.endTs = endTs;
+    const QVector<ActivityRecord> records = m_store->scan(query);
+    for (const ActivityRecord& record : records) {
+        list.append(recordToMap(record));
     }
     
     // Add current ongoing session if it matches today
     if (m_currentStartTime.date() == date) {
          QVariantMap map;
-         map["state"] = stateToString(m_currentState);
+         const QString state = stateToString(m_currentState);
+         map["state"] = state;
          map["startTime"] = m_currentStartTime.toSecsSinceEpoch() * 1000;
-         map["endTime"] = QDateTime::currentDateTime().toSecsSinceEpoch() * 1000;
-         map["duration"] = m_currentStartTime.secsTo(QDateTime::currentDateTime());
-         map["type"] = (int)m_currentState;
+         map["endTime"] = m_clock->now().toSecsSinceEpoch() * 1000;
+         map["duration"] = m_currentStartTime.secsTo(m_clock->now());
+         map["type"] = stateStringToType(state);
          map["isOngoing"] = true;
          list.append(map);
     }
@@ -261,7 +336,9 @@ QVariantList ActivityLogger::getDailyActivities(const QDate& date) {
 
 QVariantMap ActivityLogger::getDailyStats(const QDate& date) {
     QVariantMap stats;
-    if (!m_dbInitialized) return stats;
+    if (!m_store->isOpen()) return stats;
+    static MetricHistogram *s_latency = Metrics::instance()->histogram("activity.getDailyStats");
+    MetricTimer timer(s_latency);
 
     QDateTime dayStart(date, QTime(0, 0, 0));
     QDateTime dayEnd(date, QTime(23, 59, 59));
@@ -285,58 +362,42 @@ QVariantMap ActivityLogger::getDailyStats(const QDate& date) {
     qint64 maxPauseStart = 0;
     qint64 maxNapStart = 0;
 
-    QSqlQuery query;
     // Use the same filtering logic as getDailyActivities to ensure consistency
-    // Fetch all records for the day and aggregate manually, avoiding GROUP BY issues
-    query.prepare("SELECT state, duration, start_time FROM activity_log WHERE start_time >= ? AND start_time <= ?");
-    query.addBindValue(startTs);
-    query.addBindValue(endTs);
-
-    if (query.exec()) {
-        while (query.next()) {
-            QString state = query.value(0).toString();
-            int duration = query.value(1).toInt();
-            qint64 startTime = query.value(2).toLongLong() * 1000; // Convert to ms
-
-            // Accumulate generic stats
-            stats[state + "Duration"] = stats[state + "Duration"].toInt() + duration;
-            stats[state + "Count"] = stats[state + "Count"].toInt() + 1;
-
-            if (state == "Focus") {
-                totalFocus += duration;
-                if (duration > 1800) focusCount++; // Only count > 30min
-                if (duration > maxFocus) {
-                    maxFocus = duration;
-                    maxFocusStart = startTime;
-                }
-            } else if (state == "Rest") {
-                totalRest += duration;
-                if (duration > maxRest) {
-                    maxRest = duration;
-                    maxRestStart = startTime;
-                }
-            } else if (state == "Nap") {
-                totalNap += duration;
-                if (duration > maxNap) {
-                    maxNap = duration;
-                    maxNapStart = startTime;
-                }
-            } else if (state == "Pause") {
-                totalPause += duration;
-                if (duration > maxPause) {
-                    maxPause = duration;
-                    maxPauseStart = startTime;
-                }
-            }
+    // 聚合交给存储后端完成 (SQLite 中为 GROUP BY，不再逐行取回)
+    const QHash<QString, ActivityAggregate> aggregates = m_store->aggregate(startTs, endTs, 1800);
+    for (auto it = aggregates.constBegin(); it != aggregates.constEnd(); ++it) {
+        const QString& state = it.key();
+        const ActivityAggregate& agg = it.value();
+        qint64 maxStartMs = agg.maxStart * 1000; // Convert to ms
+
+        // Accumulate generic stats
+        stats[state + "Duration"] = agg.totalSeconds;
+        stats[state + "Count"] = agg.count;
+
+        if (state == "Focus") {
+            totalFocus = agg.totalSeconds;
+            focusCount = agg.longCount; // Only count > 30min
+            maxFocus = agg.maxSeconds;
+            maxFocusStart = maxStartMs;
+        } else if (state == "Rest") {
+            totalRest = agg.totalSeconds;
+            maxRest = agg.maxSeconds;
+            maxRestStart = maxStartMs;
+        } else if (state == "Nap") {
+            totalNap = agg.totalSeconds;
+            maxNap = agg.maxSeconds;
+            maxNapStart = maxStartMs;
+        } else if (state == "Pause") {
+            totalPause = agg.totalSeconds;
+            maxPause = agg.maxSeconds;
+            maxPauseStart = maxStartMs;
         }
-    } else {
-        qWarning() << "getDailyStats query failed:" << query.lastError();
     }
 
     // Add ongoing session if applicable
     if (m_currentStartTime.date() == date) {
         QString currentStateStr = stateToString(m_currentState);
-        int currentDuration = m_currentStartTime.secsTo(QDateTime::currentDateTime());
+        int currentDuration = m_currentStartTime.secsTo(m_clock->now());
         
         stats[currentStateStr + "Duration"] = stats[currentStateStr + "Duration"].toInt() + currentDuration;
         stats[currentStateStr + "Count"] = stats[currentStateStr + "Count"].toInt() + 1;
@@ -391,26 +452,93 @@ QVariantMap ActivityLogger::getDailyStats(const QDate& date) {
     return stats;
 }
 
-bool ActivityLogger::updateActivityContent(int id, const QString& content, int workType) {
-    if (!m_dbInitialized) return false;
+QVariantList ActivityLogger::queryActivities(const QVariantMap& filter) {
+    QVariantList list;
+    if (!m_store->isOpen()) return list;
+
+    // 解析筛选条件 (-1 / 缺省表示不限)
+    QVariantList types = filter.value("types").toList();
+    int minDuration = filter.value("minDuration", -1).toInt();
+    int maxDuration = filter.value("maxDuration", -1).toInt();
+    qint64 startMs = filter.value("startMs", -1).toLongLong();
+    qint64 endMs = filter.value("endMs", -1).toLongLong();
+    qint64 exactStartMs = filter.value("startTime", -1).toLongLong();
+    bool hasContent = filter.value("hasContent", false).toBool();
+
+    ActivityQuery query;
+    query.minDuration = minDuration;
+    query.maxDuration = maxDuration;
+    query.startTs = startMs >= 0 ? startMs / 1000 : -1;
+    query.endTs = endMs >= 0 ? endMs / 1000 : -1;
+    query.exactStartMs = exactStartMs;
+    query.hasContent = hasContent;
+    for (const QVariant& t : types) {
+        switch (t.toInt()) {
+            case 0: query.states << "Focus"; break;
+            case 1: query.states << "Rest"; break;
+            case 2: query.states << "Nap"; break;
+            case 3: query.states << "Pause"; break;
+            default: query.includeOtherStates = true; break;
+        }
+    }
+
+    const QVector<ActivityRecord> records = m_store->scan(query);
+    for (const ActivityRecord& record : records) {
+        list.append(recordToMap(record));
+    }
 
-    QSqlQuery query;
-    query.prepare("UPDATE activity_log SET content = ?, work_type = ? WHERE id = ?");
-    query.addBindValue(content);
-    query.addBindValue(workType);
-    query.addBindValue(id);
+    // 进行中的会话不在数据库里，按同样的条件在内存中判断
+    if (m_currentStartTime.isValid() && !hasContent) {
+        QDateTime now = m_clock->now();
+        qint64 curStartMs = m_currentStartTime.toSecsSinceEpoch() * 1000;
+        int curDuration = m_currentStartTime.secsTo(now);
+        // 与已落库的记录使用同一映射 (ActivityState 的枚举值与类型编号并不一致，如 Ready)
+        const QString curState = stateToString(m_currentState);
+        const int curType = stateStringToType(curState);
+
+        bool match = true;
+        if (!types.isEmpty()) {
+            bool typeMatch = false;
+            for (const QVariant& t : types) {
+                if (t.toInt() == curType) { typeMatch = true; break; }
+            }
+            match = typeMatch;
+        }
+        if (minDuration >= 0 && curDuration <= minDuration) match = false;
+        if (maxDuration >= 0 && curDuration > maxDuration) match = false;
+        if (startMs >= 0 && curStartMs < startMs) match = false;
+        if (endMs >= 0 && curStartMs > endMs) match = false;
+        if (exactStartMs >= 0 && qAbs(curStartMs - exactStartMs) >= 1000) match = false;
 
-    if (query.exec()) {
-        qDebug() << "Updated activity content for ID:" << id;
+        if (match) {
+            QVariantMap map;
+            map["state"] = curState;
+            map["startTime"] = curStartMs;
+            map["endTime"] = now.toSecsSinceEpoch() * 1000;
+            map["duration"] = curDuration;
+            map["type"] = curType;
+            map["isOngoing"] = true;
+            list.append(map);
+        }
+    }
+
+    return list;
+}
+
+bool ActivityLogger::updateActivityContent(int id, const QString& content, int workType) {
+    if (!m_store->isOpen()) return false;
+
+    if (m_store->updateContent(id, content, workType)) {
+        qCDebug(lcDb) << "Updated activity content for ID:" << id;
+        ++m_revision;
+        emit activityContentUpdated(id, content, workType);
         return true;
-    } else {
-        qWarning() << "Failed to update activity content:" << query.lastError();
-        return false;
     }
+    return false;
 }
 
 QString ActivityLogger::generateReport(const QDate& date, int range, int mode) {
-    if (!m_dbInitialized) return "Error: Database not initialized.";
+    if (!m_store->isOpen()) return "Error: Database not initialized.";
 
     QDateTime startDt, endDt;
     endDt = QDateTime(date, QTime(23, 59, 59));
@@ -434,7 +562,9 @@ QString ActivityLogger::generateReport(const QDate& date, int range, int mode) {
 }
 
 QString ActivityLogger::generateReportCustom(qint64 startMs, qint64 endMs, int mode) {
-    if (!m_dbInitialized) return "Error: Database not initialized.";
+    if (!m_store->isOpen()) return "Error: Database not initialized.";
+    static MetricHistogram *s_latency = Metrics::instance()->histogram("activity.generateReport");
+    MetricTimer timer(s_latency);
 
     qint64 startTs = startMs / 1000;
     qint64 endTs = endMs / 1000;
@@ -442,14 +572,13 @@ QString ActivityLogger::generateReportCustom(qint64 startMs, qint64 endMs, int m
     QDateTime startDt = QDateTime::fromSecsSinceEpoch(startTs);
     QDateTime endDt = QDateTime::fromSecsSinceEpoch(endTs);
 
-    QSqlQuery query;
     // We only care about Focus Work (state='Focus') that has content
-    QString sql = "SELECT start_time, end_time, duration, content, work_type FROM activity_log WHERE state='Focus' AND start_time >= ? AND start_time <= ? AND content IS NOT NULL AND content != '' ORDER BY start_time ASC";
-    query.prepare(sql);
-    query.addBindValue(startTs);
-    query.addBindValue(endTs);
-
-    if (!query.exec()) return "Error: Query failed " + query.lastError().text();
+    ActivityQuery query;
+    query.startTs = startTs;
+    query.endTs = endTs;
+    query.states << "Focus";
+    query.hasContent = true;
+    const QVector<ActivityRecord> records = m_store->scan(query);
 
     QString report;
     report += "📅 工作汇报\n";
@@ -459,12 +588,12 @@ QString ActivityLogger::generateReportCustom(qint64 startMs, qint64 endMs, int m
     report += "----------------------------------------\n";
 
     int count = 0;
-    while (query.next()) {
-        qint64 sTime = query.value(0).toLongLong();
-        qint64 eTime = query.value(1).toLongLong();
-        int duration = query.value(2).toInt();
-        QString content = query.value(3).toString();
-        int workType = query.value(4).toInt();
+    for (const ActivityRecord& record : records) {
+        qint64 sTime = record.startTime;
+        qint64 eTime = record.endTime;
+        int duration = record.duration;
+        const QString& content = record.content;
+        int workType = record.workType;
 
         QDateTime sDt = QDateTime::fromSecsSinceEpoch(sTime);
         QDateTime eDt = QDateTime::fromSecsSinceEpoch(eTime);
@@ -1,22 +1,44 @@
 #pragma once
 
 #include <QObject>
-#include <QSqlDatabase>
-#include <QSqlQuery>
 #include <QDateTime>
 #include <QVariant>
+#include <QScopedPointer>
+#include <QHash>
+#include <QPair>
 #include "TimerEngine.h"
+#include "ActivityStore.h"
 
 class ActivityLogger : public QObject {
     Q_OBJECT
 public:
+    // 默认使用 AppData 目录下的 SQLite 存储
     explicit ActivityLogger(TimerEngine* engine, QObject *parent = nullptr);
+    // 使用指定的存储后端 (接管 store 的所有权)，用于内存模拟与基准测试
+    ActivityLogger(TimerEngine* engine, ActivityStore* store, QObject *parent = nullptr);
     ~ActivityLogger();
 
     // QML Invokable methods
     Q_INVOKABLE QVariantList getDailyActivities(const QDate& date);
     Q_INVOKABLE QVariantMap getDailyStats(const QDate& date);
     Q_INVOKABLE bool updateActivityContent(int id, const QString& content, int workType);
+
+    // 某天专注时间内各前台应用的使用时长 (返回 [{app: "Code", seconds: 3600}, ...]，按时长降序)
+    Q_INVOKABLE QVariantList getAppUsage(const QDate& date);
+
+    // 某天处理过的附加提醒 (返回 [{kind: "EyeRest", startTime: ms, endTime: ms, duration: 20}, ...])
+    Q_INVOKABLE QVariantList getReminders(const QDate& date);
+
+    // 按条件筛选活动记录 (在 SQL 中求值，供仪表盘高亮使用)
+    // filter 键 (均可省略):
+    //   types: [int]          — 类型集合 (0=Focus, 1=Rest, 2=Nap, 3=Pause, 4=Other)
+    //   minDuration: int      — 时长下限 (秒, 不含), -1 表示不限
+    //   maxDuration: int      — 时长上限 (秒, 含), -1 表示不限
+    //   startMs / endMs: ms   — 开始时间窗口
+    //   startTime: ms         — 精确匹配某一段 (允许 1 秒误差)
+    //   hasContent: bool      — 仅返回已填写工作日志的记录
+    // 返回与 getDailyActivities 相同结构的列表 (包含匹配的进行中会话)
+    Q_INVOKABLE QVariantList queryActivities(const QVariantMap& filter);
     
     // Report Generation
     // range: 0=Day, 1=Week, 2=Month
@@ -26,21 +48,64 @@ public:
     // Custom Date Range Report
     Q_INVOKABLE QString generateReportCustom(qint64 startMs, qint64 endMs, int mode);
 
+    ActivityStore* store() const { return m_store.data(); }
+
+    // 数据修订号：每次写入记录、修改工作日志或切换进行中的会话时递增，
+    // 供 HTTP 接口生成 ETag (修订号不变则历史数据不变)
+    quint64 dataRevision() const { return m_revision; }
+    // 进行中会话的开始时间 (其时长随时间增长，不计入修订号)
+    QDateTime currentSessionStart() const { return m_currentStartTime; }
+    // 记录使用的时钟 (与 TimerEngine 共用)
+    Clock* clock() const { return m_clock; }
+
+signals:
+    // 工时内容保存成功后触发
+    void activityContentUpdated(int id, const QString& content, int workType);
+
+public slots:
+    // 附加提醒 (护眼、喝水等) 的独立记录，存入提醒表，不影响活动时间线与状态合计
+    // logState 为空的提醒不单独记录 (例如运动提醒由主状态 Rest 覆盖)
+    void onReminderStarted(const QString& kindId, const QString& logState);
+    // maxSeconds: 记录时长上限 (用户迟迟未确认时不把等待时间算进去)
+    void onReminderFinished(const QString& kindId, int maxSeconds);
+
+    // 前台应用切换 (ForegroundAppMonitor)，只在专注会话中累计时长
+    void onForegroundAppChanged(const QString& app);
+
 private slots:
     void onActivityStateChanged(TimerEngine::ActivityState newState);
     // 处理手动记录的运动
     void onManualExerciseRecorded(int durationSeconds);
 
 private:
-    void initDatabase();
+    void init();
     void closeCurrentSession(const QDateTime& endTime = QDateTime());
     void startNewSession(TimerEngine::ActivityState state);
     QString stateToString(TimerEngine::ActivityState state);
     int stateToColorType(TimerEngine::ActivityState state); // Returns an index or string for UI color mapping
+    static int stateStringToType(const QString& stateStr); // "Focus" -> 0 ... 其他 -> 4
+    static QVariantMap recordToMap(const ActivityRecord& record);
+    // 把当前前台应用截至此刻的时长计入本会话
+    void accrueForegroundApp();
+    // 写入专注会话的应用时长并清空
+    void flushAppUsage(qint64 sessionStart);
 
-    QSqlDatabase m_db;
+    QScopedPointer<ActivityStore> m_store;
     TimerEngine* m_engine;
+    Clock* m_clock; // 与 TimerEngine 共用 (无引擎时为 Clock::system())
     TimerEngine::ActivityState m_currentState;
     QDateTime m_currentStartTime;
-    bool m_dbInitialized = false;
+    quint64 m_revision = 0;
+
+    // 每种提醒各自的进行中会话: kindId -> (状态名, 开始时间)
+    QHash<QString, QPair<QString, QDateTime>> m_reminderSessions;
+
+    // 当前专注会话的前台应用时长 (单调时钟毫秒)
+    QString m_foregroundApp;
+    qint64 m_foregroundSinceMs = 0;
+    QHash<QString, qint64> m_appMs;
+
+    // 写入后延迟压实存储后端的写入日志 (批量落库，避免每次状态切换都开事务)
+    ClockTimer* m_compactTimer;
+    static const int COMPACT_DELAY_MS = 5 * 60 * 1000;
 };
@@ -0,0 +1,101 @@
+#pragma once
+
+#include <QString>
+#include <QStringList>
+#include <QVector>
+#include <QHash>
+
+// ========================================================================
+// ActivityStore：活动记录存储后端接口
+// ========================================================================
+// ActivityLogger 只负责状态跟踪，所有持久化操作都通过此接口完成，
+// 便于在 SQLite (SqliteActivityStore) 与纯内存 (MemoryActivityStore)
+// 之间切换，也方便单独对查询路径做基准测试。
+// 时间均为秒级 Unix 时间戳。
+// ========================================================================
+
+// 一条活动记录 (对应 activity_log 表的一行)
+struct ActivityRecord {
+    int id = 0;
+    QString state;        // "Focus" / "Rest" / "Nap" / "Pause" / "Offline" / "Ready"
+    qint64 startTime = 0;
+    qint64 endTime = 0;
+    int duration = 0;     // 秒
+    QString content;      // 工时日志 (JSON 或旧版纯文本)
+    int workType = 0;
+};
+
+// 范围扫描条件 (-1 / 空表示不限)
+struct ActivityQuery {
+    qint64 startTs = -1;          // start_time >= startTs
+    qint64 endTs = -1;            // start_time <= endTs
+    QStringList states;           // 状态集合
+    bool includeOtherStates = false; // 额外匹配 Focus/Rest/Nap/Pause 以外的状态
+    int minDuration = -1;         // duration > minDuration
+    int maxDuration = -1;         // duration <= maxDuration
+    qint64 exactStartMs = -1;     // |start_time*1000 - exactStartMs| < 1000
+    bool hasContent = false;      // content 非空
+};
+
+// 一个应用的前台时长
+struct AppUsage {
+    QString app;          // 应用名 (进程名或窗口类名)
+    int seconds = 0;
+};
+
+// 一次附加提醒 (护眼、喝水等) 的处理记录，单独存放，不进入活动时间线
+struct ReminderRecord {
+    QString kind;         // 提醒的记录名，例如 "EyeRest" / "Hydration" / "LongBreak"
+    qint64 startTime = 0;
+    qint64 endTime = 0;
+    int duration = 0;     // 秒
+};
+
+// 单个状态的聚合结果
+struct ActivityAggregate {
+    int totalSeconds = 0;
+    int count = 0;
+    int maxSeconds = 0;
+    qint64 maxStart = 0;   // 最长一段的开始时间 (秒)
+    int longCount = 0;     // duration 超过 longThreshold 的段数
+};
+
+class ActivityStore {
+public:
+    virtual ~ActivityStore() = default;
+
+    virtual bool isOpen() const = 0;
+
+    // 追加一段已结束的会话，成功时返回新记录 id，失败返回 -1
+    // (带写入日志的后端在压实前无法给出 id，此时返回 0)
+    virtual int appendSession(const ActivityRecord& record) = 0;
+
+    // 将缓冲中的写入落盘 (默认实现无缓冲)
+    virtual void flush() {}
+
+    // 按条件范围扫描，结果按 start_time 升序
+    virtual QVector<ActivityRecord> scan(const ActivityQuery& query) = 0;
+
+    // 按状态聚合 [startTs, endTs] 内的记录
+    virtual QHash<QString, ActivityAggregate> aggregate(qint64 startTs, qint64 endTs, int longThreshold) = 0;
+
+    // 更新工时日志内容，记录不存在或只读时返回 false
+    virtual bool updateContent(int id, const QString& content, int workType) = 0;
+
+    // 记录一段专注会话中各前台应用的时长，按会话开始时间 (秒) 关联
+    // (写入日志压实前会话还没有 id)
+    virtual bool appendAppUsage(qint64 sessionStart, const QVector<AppUsage>& usage) = 0;
+
+    // 按应用汇总 [startTs, endTs] 内开始的会话的前台时长，按时长降序
+    virtual QVector<AppUsage> appUsage(qint64 startTs, qint64 endTs) = 0;
+
+    // 记录一次附加提醒。提醒与进行中的主状态会话重叠，不写入 activity_log，
+    // 以免时间线与各状态合计被打乱
+    virtual bool appendReminder(const ReminderRecord& record) = 0;
+
+    // [startTs, endTs] 内开始的提醒，按开始时间升序
+    virtual QVector<ReminderRecord> reminders(qint64 startTs, qint64 endTs) = 0;
+
+    // 底层数据库文件 (按年份升序，当前可写库在最后)；纯内存实现返回空
+    virtual QStringList databaseFiles() const { return QStringList(); }
+};
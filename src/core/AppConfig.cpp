@@ -1,5 +1,5 @@
 #include "AppConfig.h"
-#include <QDebug>
+#include "Logging.h"
 #include <QCoreApplication>
 #include <QDir>
 
@@ -26,7 +26,7 @@ AppConfig::AppConfig(QObject *parent) : QObject(parent)
         // 如果当前值与期望值不一致（包括路径改变、参数缺失等情况），则更新
         // 这也解决了文件夹重命名后自启路径失效的问题
         if (currentValue != expectedValue) {
-            qDebug() << "Auto-start registry key mismatch (Path/Args). Updating...";
+            qCDebug(lcEngine) << "Auto-start registry key mismatch (Path/Args). Updating...";
             setAutoStart(true); 
         }
     }
@@ -0,0 +1,343 @@
+#include "Calendar.h"
+#include "Logging.h"
+#include <QIODevice>
+#include <QTimeZone>
+#include <QStringList>
+#include <algorithm>
+#include <limits>
+
+// ========================================================================
+// CalendarIndex
+// ========================================================================
+
+void CalendarIndex::rebuild(QVector<BusyInterval> intervals) {
+    std::sort(intervals.begin(), intervals.end(), [](const BusyInterval& a, const BusyInterval& b) {
+        return a.startMs < b.startMs;
+    });
+
+    // 合并重叠与首尾相接的会议 (连续开会视为一个忙碌时段)
+    m_intervals.clear();
+    m_intervals.reserve(intervals.size());
+    for (const BusyInterval& interval : qAsConst(intervals)) {
+        if (interval.endMs <= interval.startMs) continue;
+        if (!m_intervals.isEmpty() && interval.startMs <= m_intervals.last().endMs) {
+            m_intervals.last().endMs = qMax(m_intervals.last().endMs, interval.endMs);
+        } else {
+            m_intervals.append(interval);
+        }
+    }
+    m_intervals.squeeze();
+}
+
+int CalendarIndex::upperBound(qint64 atMs) const {
+    auto it = std::upper_bound(m_intervals.constBegin(), m_intervals.constEnd(), atMs,
+                               [](qint64 t, const BusyInterval& interval) { return t < interval.startMs; });
+    return int(it - m_intervals.constBegin());
+}
+
+qint64 CalendarIndex::nextFreeSlot(qint64 atMs) const {
+    // 时段互不相接，所在时段的结束时刻一定空闲
+    const int i = upperBound(atMs);
+    if (i > 0 && m_intervals.at(i - 1).endMs > atMs) return m_intervals.at(i - 1).endMs;
+    return atMs;
+}
+
+qint64 CalendarIndex::nextBusyStart(qint64 atMs) const {
+    const int i = upperBound(atMs);
+    return i < m_intervals.size() ? m_intervals.at(i).startMs : -1;
+}
+
+// ========================================================================
+// IcsParser
+// ========================================================================
+
+// 单个重复规则最多展开的步数 (防止异常规则导致长时间循环)
+static const int kMaxRuleSteps = 20000;
+
+IcsParser::IcsParser(qint64 fromMs, qint64 toMs)
+    : m_fromMs(fromMs), m_toMs(toMs)
+{
+}
+
+bool IcsParser::parse(QIODevice* device) {
+    if (!device->isOpen() && !device->open(QIODevice::ReadOnly)) {
+        qCWarning(lcEngine) << "IcsParser: cannot open calendar" << device->errorString();
+        return false;
+    }
+
+    // 按 RFC 5545 展开折行：以空格/Tab 开头的物理行是上一行的续行。
+    // 拼接在字节层面进行，避免在多字节 UTF-8 字符中间解码。
+    QByteArray logical;
+    while (!device->atEnd()) {
+        QByteArray raw = device->readLine();
+        while (raw.endsWith('\n') || raw.endsWith('\r')) raw.chop(1);
+
+        if (!raw.isEmpty() && (raw.at(0) == ' ' || raw.at(0) == '\t')) {
+            logical.append(raw.constData() + 1, raw.size() - 1);
+            continue;
+        }
+        if (!logical.isEmpty()) handleLine(QString::fromUtf8(logical));
+        logical = raw;
+    }
+    if (!logical.isEmpty()) handleLine(QString::fromUtf8(logical));
+
+    // 文件在 VEVENT 中间结束 (正在被写入)：丢弃未完成的事件，等下次重新加载
+    m_inEvent = false;
+    m_nestedDepth = 0;
+    return true;
+}
+
+void IcsParser::handleLine(const QString& line) {
+    // NAME;PARAM=VALUE;PARAM="A:B":值 —— 第一个不在引号内的冒号分隔属性名与值
+    int colon = -1;
+    bool quoted = false;
+    for (int i = 0; i < line.size(); ++i) {
+        const QChar c = line.at(i);
+        if (c == QLatin1Char('"')) quoted = !quoted;
+        else if (c == QLatin1Char(':') && !quoted) { colon = i; break; }
+    }
+    if (colon < 0) return;
+
+    const QStringList head = line.left(colon).split(QLatin1Char(';'));
+    const QString name = head.first().trimmed().toUpper();
+    const QString value = line.mid(colon + 1);
+
+    if (name == QLatin1String("BEGIN")) {
+        if (!m_inEvent && value.trimmed().toUpper() == QLatin1String("VEVENT")) {
+            m_inEvent = true;
+            m_event = Event();
+        } else if (m_inEvent) {
+            m_nestedDepth++;
+        }
+        return;
+    }
+    if (name == QLatin1String("END")) {
+        if (!m_inEvent) return;
+        if (m_nestedDepth > 0) {
+            m_nestedDepth--;
+        } else if (value.trimmed().toUpper() == QLatin1String("VEVENT")) {
+            finishEvent();
+            m_inEvent = false;
+        }
+        return;
+    }
+    if (!m_inEvent || m_nestedDepth > 0) return;
+
+    QHash<QString, QString> params;
+    for (int i = 1; i < head.size(); ++i) {
+        const int eq = head.at(i).indexOf(QLatin1Char('='));
+        if (eq < 0) continue;
+        QString paramValue = head.at(i).mid(eq + 1);
+        if (paramValue.startsWith(QLatin1Char('"')) && paramValue.endsWith(QLatin1Char('"')) && paramValue.size() >= 2) {
+            paramValue = paramValue.mid(1, paramValue.size() - 2);
+        }
+        params.insert(head.at(i).left(eq).toUpper(), paramValue);
+    }
+
+    bool allDay = false;
+    if (name == QLatin1String("UID")) {
+        m_event.uid = value.trimmed();
+    } else if (name == QLatin1String("DTSTART")) {
+        m_event.start = parseDateTime(value, params, &allDay);
+        m_event.allDay = allDay;
+    } else if (name == QLatin1String("DTEND")) {
+        m_event.end = parseDateTime(value, params, &allDay);
+    } else if (name == QLatin1String("DURATION")) {
+        m_event.durationSecs = parseDuration(value);
+    } else if (name == QLatin1String("RRULE")) {
+        m_event.rrule = value.trimmed().toUpper();
+    } else if (name == QLatin1String("EXDATE")) {
+        for (const QString& item : value.split(QLatin1Char(','), Qt::SkipEmptyParts)) {
+            const QDateTime exdate = parseDateTime(item, params, &allDay);
+            if (exdate.isValid()) m_event.exdates.append(exdate.toMSecsSinceEpoch());
+        }
+    } else if (name == QLatin1String("RECURRENCE-ID")) {
+        const QDateTime recurrenceId = parseDateTime(value, params, &allDay);
+        if (recurrenceId.isValid()) m_event.recurrenceIdMs = recurrenceId.toMSecsSinceEpoch();
+    } else if (name == QLatin1String("TRANSP")) {
+        m_event.transparent = value.trimmed().toUpper() == QLatin1String("TRANSPARENT");
+    } else if (name == QLatin1String("STATUS")) {
+        m_event.cancelled = value.trimmed().toUpper() == QLatin1String("CANCELLED");
+    }
+}
+
+void IcsParser::finishEvent() {
+    m_eventCount++;
+    const Event& event = m_event;
+
+    // 单次修改：无论修改后是否仍然忙碌，原来的那一次都不再出现
+    if (event.recurrenceIdMs >= 0 && !event.uid.isEmpty()) {
+        m_overridden[event.uid].insert(event.recurrenceIdMs);
+    }
+
+    // 全天事件 (假期、出差等) 与标记为"空闲"的事件不视为会议
+    if (event.cancelled || event.transparent || event.allDay || !event.start.isValid()) return;
+
+    qint64 lengthMs = 0;
+    if (event.end.isValid()) lengthMs = event.start.msecsTo(event.end);
+    else if (event.durationSecs > 0) lengthMs = event.durationSecs * 1000;
+    if (lengthMs <= 0) return;
+
+    if (event.rrule.isEmpty() || event.recurrenceIdMs >= 0) {
+        emitInstance(event.uid, event.start.toMSecsSinceEpoch(), lengthMs, false);
+    } else {
+        expandRule(event, lengthMs);
+    }
+}
+
+void IcsParser::expandRule(const Event& event, qint64 lengthMs) {
+    QHash<QString, QString> rule;
+    for (const QString& part : event.rrule.split(QLatin1Char(';'), Qt::SkipEmptyParts)) {
+        const int eq = part.indexOf(QLatin1Char('='));
+        if (eq > 0) rule.insert(part.left(eq), part.mid(eq + 1));
+    }
+
+    const QString freq = rule.value("FREQ");
+    const int interval = qMax(1, rule.value("INTERVAL", "1").toInt());
+    const int count = rule.value("COUNT").toInt(); // 0 表示不限
+    qint64 untilMs = std::numeric_limits<qint64>::max();
+    if (rule.contains("UNTIL")) {
+        bool dateOnly = false;
+        const QDateTime until = parseDateTime(rule.value("UNTIL"), QHash<QString, QString>(), &dateOnly);
+        // 只有日期的 UNTIL 包含当天
+        if (until.isValid()) {
+            untilMs = dateOnly ? until.addDays(1).toMSecsSinceEpoch() - 1 : until.toMSecsSinceEpoch();
+        }
+    }
+
+    // 在 DTSTART 的时区中逐次推进 (跨夏令时保持会议的本地时刻不变)
+    const QDateTime& first = event.start;
+    int produced = 0;
+    auto take = [&](const QDateTime& start) -> bool {
+        const qint64 startMs = start.toMSecsSinceEpoch();
+        if (startMs > untilMs || startMs >= m_toMs) return false;
+        if (count > 0 && produced >= count) return false;
+        produced++; // COUNT 从第一次开始计数，包括查询窗口之前的
+        if (!event.exdates.contains(startMs)) emitInstance(event.uid, startMs, lengthMs, true);
+        return true;
+    };
+
+    if (freq == QLatin1String("DAILY")) {
+        for (int i = 0; i < kMaxRuleSteps; ++i) {
+            if (!take(first.addDays(qint64(i) * interval))) break;
+        }
+    } else if (freq == QLatin1String("WEEKLY")) {
+        static const char* const kDays[] = { "MO", "TU", "WE", "TH", "FR", "SA", "SU" };
+        QVector<int> days; // 1 = 周一 ... 7 = 周日
+        for (const QString& item : rule.value("BYDAY").split(QLatin1Char(','), Qt::SkipEmptyParts)) {
+            const QString day = item.right(2); // 忽略 "1MO" 之类的序号前缀
+            for (int d = 0; d < 7; ++d) {
+                if (day == QLatin1String(kDays[d]) && !days.contains(d + 1)) days.append(d + 1);
+            }
+        }
+        if (days.isEmpty()) days.append(first.date().dayOfWeek());
+        std::sort(days.begin(), days.end());
+
+        const QDateTime weekStart = first.addDays(1 - first.date().dayOfWeek()); // 周一 (WKST=MO)
+        bool done = false;
+        for (int week = 0; week < kMaxRuleSteps && !done; ++week) {
+            for (int day : qAsConst(days)) {
+                const QDateTime start = weekStart.addDays(qint64(week) * 7 * interval + day - 1);
+                if (start < first) continue;
+                if (!take(start)) { done = true; break; }
+            }
+        }
+    } else if (freq == QLatin1String("MONTHLY")) {
+        for (int i = 0; i < kMaxRuleSteps; ++i) {
+            const QDateTime start = first.addMonths(i * interval);
+            if (start.date().day() != first.date().day()) continue; // 当月没有这一天 (如 31 号)，按 RFC 跳过
+            if (!take(start)) break;
+        }
+    } else {
+        // 不支持的频率：至少保留第一次
+        take(first);
+    }
+}
+
+void IcsParser::emitInstance(const QString& uid, qint64 startMs, qint64 lengthMs, bool recurring) {
+    if (startMs >= m_toMs || startMs + lengthMs <= m_fromMs) return;
+
+    BusyInterval interval;
+    interval.startMs = startMs;
+    interval.endMs = startMs + lengthMs;
+    if (recurring) m_recurring.append(qMakePair(uid, interval));
+    else m_intervals.append(interval);
+}
+
+QVector<BusyInterval> IcsParser::takeIntervals() {
+    for (const auto& instance : qAsConst(m_recurring)) {
+        auto it = m_overridden.constFind(instance.first);
+        if (it != m_overridden.constEnd() && it->contains(instance.second.startMs)) continue;
+        m_intervals.append(instance.second);
+    }
+    m_recurring.clear();
+    m_overridden.clear();
+
+    QVector<BusyInterval> result;
+    result.swap(m_intervals);
+    return result;
+}
+
+QDateTime IcsParser::parseDateTime(const QString& value, const QHash<QString, QString>& params, bool* allDay) {
+    QString text = value.trimmed();
+    *allDay = false;
+
+    if (params.value("VALUE").toUpper() == QLatin1String("DATE") || text.size() == 8) {
+        *allDay = true;
+        return QDateTime(QDate::fromString(text.left(8), "yyyyMMdd"), QTime(0, 0), Qt::LocalTime);
+    }
+
+    const bool utc = text.endsWith(QLatin1Char('Z'));
+    if (utc) text.chop(1);
+
+    QDateTime dateTime = QDateTime::fromString(text, "yyyyMMdd'T'HHmmss");
+    if (!dateTime.isValid()) return QDateTime();
+
+    if (utc) {
+        dateTime.setTimeSpec(Qt::UTC);
+        return dateTime;
+    }
+
+    const QString tzid = params.value("TZID");
+    if (!tzid.isEmpty()) {
+        // Outlook 导出的是 Windows 时区名 (如 "China Standard Time")
+        QTimeZone zone(tzid.toUtf8());
+        if (!zone.isValid()) zone = QTimeZone(QTimeZone::windowsIdToDefaultIanaId(tzid.toUtf8()));
+        if (zone.isValid()) {
+            dateTime.setTimeZone(zone);
+            return dateTime;
+        }
+    }
+
+    // 浮动时间：按本地时区理解
+    dateTime.setTimeSpec(Qt::LocalTime);
+    return dateTime;
+}
+
+qint64 IcsParser::parseDuration(const QString& value) {
+    // P[nW][nD][T[nH][nM][nS]]，负时长视为无效
+    QString text = value.trimmed();
+    if (text.startsWith(QLatin1Char('+'))) text.remove(0, 1);
+    if (!text.startsWith(QLatin1Char('P'))) return -1;
+
+    qint64 seconds = 0;
+    qint64 number = 0;
+    for (int i = 1; i < text.size(); ++i) {
+        const QChar c = text.at(i);
+        if (c.isDigit()) {
+            number = number * 10 + c.digitValue();
+            continue;
+        }
+        switch (c.toLatin1()) {
+            case 'W': seconds += number * 7 * 86400; break;
+            case 'D': seconds += number * 86400; break;
+            case 'H': seconds += number * 3600; break;
+            case 'M': seconds += number * 60; break;
+            case 'S': seconds += number; break;
+            case 'T': break;
+            default: return -1;
+        }
+        number = 0;
+    }
+    return seconds;
+}
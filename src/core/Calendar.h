@@ -0,0 +1,117 @@
+#pragma once
+
+#include <QVector>
+#include <QString>
+#include <QHash>
+#include <QSet>
+#include <QDateTime>
+
+class QIODevice;
+
+// ========================================================================
+// Calendar：本地日历 (.ics) 的忙碌时段
+// ========================================================================
+// 作用：会议期间弹出全屏休息提醒会打断会议。这里把本地 .ics 文件中的
+// 会议解析为忙碌时段，TimerEngine / ReminderScheduler 在提醒到期时查询，
+// 会议中的提醒自动顺延到会议结束。
+// - IcsParser：流式解析 (逐行读取，同一时刻只保留当前 VEVENT 的字段)，
+//   只展开查询窗口内的重复会议，文件再大内存占用也不变。
+// - CalendarIndex：按开始时间排序、合并重叠后的时段数组，
+//   "现在是否忙 / 下一个空闲时刻" 为二分查找 O(log n)。
+// 时间统一为 UTC 毫秒 (QDateTime::toMSecsSinceEpoch)。
+// ========================================================================
+
+struct BusyInterval {
+    qint64 startMs = 0;
+    qint64 endMs = 0;   // 不含
+};
+
+// ========================================================================
+// CalendarIndex：忙碌时段索引
+// ========================================================================
+class CalendarIndex
+{
+public:
+    // 用一组 (可能重叠、无序的) 时段重建索引
+    void rebuild(QVector<BusyInterval> intervals);
+    void clear() { m_intervals.clear(); }
+
+    bool isEmpty() const { return m_intervals.isEmpty(); }
+    int size() const { return m_intervals.size(); }
+    const QVector<BusyInterval>& intervals() const { return m_intervals; }
+
+    // atMs 时刻是否处于会议中
+    bool isBusy(qint64 atMs) const { return nextFreeSlot(atMs) > atMs; }
+
+    // 不早于 atMs 的第一个空闲时刻 (空闲时返回 atMs 本身)
+    qint64 nextFreeSlot(qint64 atMs) const;
+
+    // 晚于 atMs 开始的下一个会议，没有时返回 -1
+    qint64 nextBusyStart(qint64 atMs) const;
+
+private:
+    // 第一个 startMs > atMs 的时段下标
+    int upperBound(qint64 atMs) const;
+
+    QVector<BusyInterval> m_intervals; // 按 startMs 排序且互不重叠 (相接的已合并)
+};
+
+// ========================================================================
+// IcsParser：流式 iCalendar 解析器
+// ========================================================================
+// 支持的子集 (覆盖 Outlook / Google / 飞书导出的常见会议)：
+// - DTSTART / DTEND / DURATION，UTC ("Z")、TZID 参数 (IANA 或 Windows 时区名)
+//   与浮动时间 (按本地时区)；全天事件 (VALUE=DATE) 不视为忙碌
+// - TRANSP:TRANSPARENT、STATUS:CANCELLED 的事件跳过
+// - RRULE：FREQ=DAILY/WEEKLY/MONTHLY，INTERVAL、COUNT、UNTIL、BYDAY (仅 WEEKLY)
+// - EXDATE，以及带 RECURRENCE-ID 的单次修改 (替换被修改的那一次)
+// ========================================================================
+class IcsParser
+{
+public:
+    // 只输出与 [fromMs, toMs) 相交的时段
+    IcsParser(qint64 fromMs, qint64 toMs);
+
+    // 解析一个日历流，可对多个文件依次调用
+    bool parse(QIODevice* device);
+
+    // 取出全部结果 (应用 RECURRENCE-ID 替换)
+    QVector<BusyInterval> takeIntervals();
+
+    int eventCount() const { return m_eventCount; }
+
+private:
+    struct Event {
+        QString uid;
+        QDateTime start;
+        QDateTime end;
+        qint64 durationSecs = -1;
+        QString rrule;
+        QVector<qint64> exdates;
+        qint64 recurrenceIdMs = -1;
+        bool allDay = false;
+        bool transparent = false;
+        bool cancelled = false;
+    };
+
+    void handleLine(const QString& line);
+    void finishEvent();
+    void expandRule(const Event& event, qint64 lengthMs);
+    void emitInstance(const QString& uid, qint64 startMs, qint64 lengthMs, bool recurring);
+
+    static QDateTime parseDateTime(const QString& value, const QHash<QString, QString>& params, bool* allDay);
+    static qint64 parseDuration(const QString& value);
+
+    qint64 m_fromMs;
+    qint64 m_toMs;
+    int m_eventCount = 0;
+
+    bool m_inEvent = false;
+    int m_nestedDepth = 0; // VEVENT 内部的 VALARM 等子组件
+    Event m_event;
+
+    QVector<BusyInterval> m_intervals;
+    // 重复会议的实例 (UID, 开始时间)，用于按 RECURRENCE-ID 剔除被修改的那一次
+    QVector<QPair<QString, BusyInterval>> m_recurring;
+    QHash<QString, QSet<qint64>> m_overridden;
+};
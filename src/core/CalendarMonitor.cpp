@@ -0,0 +1,112 @@
+#include "CalendarMonitor.h"
+#include "Clock.h"
+#include "Logging.h"
+#include <QSettings>
+#include <QStandardPaths>
+#include <QFileInfo>
+#include <QFile>
+#include <QDir>
+
+CalendarMonitor::CalendarMonitor(Clock* clock, QObject* parent)
+    : QObject(parent), m_clock(clock)
+{
+    m_reloadTimer = m_clock->createTimer(this);
+    m_reloadTimer->setObjectName("reload");
+    connect(m_reloadTimer, &ClockTimer::timeout, this, &CalendarMonitor::reload);
+
+    m_windowTimer = m_clock->createTimer(this);
+    m_windowTimer->setObjectName("window");
+    connect(m_windowTimer, &ClockTimer::timeout, this, &CalendarMonitor::reload);
+
+    connect(&m_watcher, &QFileSystemWatcher::fileChanged, this, &CalendarMonitor::onPathChanged);
+    connect(&m_watcher, &QFileSystemWatcher::directoryChanged, this, &CalendarMonitor::onPathChanged);
+
+    QSettings settings("TraeAI", "DeskCare");
+    const QString defaultDir = QStandardPaths::writableLocation(QStandardPaths::AppDataLocation) + "/calendars";
+    m_paths = settings.value("Calendar/paths", QStringList{ defaultDir }).toStringList();
+    // 默认目录需要存在才能被监视 (用户把导出的 .ics 放进来即可生效)
+    if (!settings.contains("Calendar/paths")) QDir().mkpath(defaultDir);
+
+    reload();
+}
+
+void CalendarMonitor::setPaths(const QStringList& paths) {
+    if (paths == m_paths) return;
+    m_paths = paths;
+
+    QSettings settings("TraeAI", "DeskCare");
+    settings.setValue("Calendar/paths", m_paths);
+
+    emit pathsChanged();
+    reload();
+}
+
+QStringList CalendarMonitor::calendarFiles() const {
+    QStringList files;
+    for (const QString& path : m_paths) {
+        const QFileInfo info(path);
+        if (info.isDir()) {
+            const QFileInfoList entries = QDir(path).entryInfoList(QStringList{ "*.ics" }, QDir::Files, QDir::Name);
+            for (const QFileInfo& entry : entries) files << entry.absoluteFilePath();
+        } else if (info.isFile()) {
+            files << info.absoluteFilePath();
+        }
+    }
+    return files;
+}
+
+void CalendarMonitor::updateWatches(const QStringList& files) {
+    // 编辑器/同步工具常以"写临时文件再改名"的方式保存，原文件的监视会失效，
+    // 因此每次重新加载后都补上监视
+    QStringList wanted = files;
+    for (const QString& path : m_paths) {
+        if (QFileInfo(path).isDir()) wanted << QFileInfo(path).absoluteFilePath();
+    }
+
+    QStringList watched = m_watcher.files() + m_watcher.directories();
+    QStringList stale;
+    for (const QString& path : qAsConst(watched)) {
+        if (!wanted.contains(path)) stale << path;
+    }
+    if (!stale.isEmpty()) m_watcher.removePaths(stale);
+
+    QStringList added;
+    for (const QString& path : qAsConst(wanted)) {
+        if (!watched.contains(path)) added << path;
+    }
+    if (!added.isEmpty()) m_watcher.addPaths(added);
+}
+
+void CalendarMonitor::onPathChanged() {
+    // 一次保存常触发多个通知，合并为一次重新加载
+    m_reloadTimer->start(RELOAD_DEBOUNCE_MS);
+}
+
+void CalendarMonitor::reload() {
+    m_reloadTimer->stop();
+
+    // 查询窗口：从一天前 (覆盖正在进行的长会议) 到 WINDOW_DAYS 天后
+    const qint64 now = m_clock->now().toMSecsSinceEpoch();
+    const qint64 dayMs = 24LL * 60 * 60 * 1000;
+    IcsParser parser(now - dayMs, now + WINDOW_DAYS * dayMs);
+
+    const QStringList files = calendarFiles();
+    for (const QString& path : files) {
+        QFile file(path);
+        if (!file.open(QIODevice::ReadOnly)) {
+            qCWarning(lcEngine) << "Calendar: cannot open" << path << file.errorString();
+            continue;
+        }
+        parser.parse(&file);
+    }
+
+    m_index.rebuild(parser.takeIntervals());
+    updateWatches(files);
+    m_windowTimer->start(WINDOW_REFRESH_MS);
+
+    if (!files.isEmpty()) {
+        qCDebug(lcEngine) << "Calendar loaded:" << files.size() << "files," << parser.eventCount()
+                 << "events," << m_index.size() << "busy intervals";
+    }
+    emit calendarChanged();
+}
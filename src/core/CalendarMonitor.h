@@ -0,0 +1,67 @@
+#pragma once
+
+#include <QObject>
+#include <QStringList>
+#include <QFileSystemWatcher>
+#include "Calendar.h"
+
+class Clock;
+class ClockTimer;
+
+// ========================================================================
+// CalendarMonitor：监视本地 .ics 文件并维护忙碌时段索引
+// ========================================================================
+// 作用：读取配置的日历文件/目录 (目录下的所有 *.ics)，解析未来一段时间
+// (WINDOW_DAYS) 内的会议，写入 CalendarIndex 供 TimerEngine 与
+// ReminderScheduler 查询。文件变化 (同步工具写入、编辑器保存) 时防抖后
+// 重新加载；查询窗口每隔 WINDOW_REFRESH_MS 向前滑动一次。
+// 配置保存在 QSettings("TraeAI", "DeskCare") 的 Calendar/paths，
+// 默认为 AppData 下的 calendars 目录。
+// ========================================================================
+class CalendarMonitor : public QObject
+{
+    Q_OBJECT
+
+    // 日历文件或目录列表
+    Q_PROPERTY(QStringList paths READ paths WRITE setPaths NOTIFY pathsChanged)
+    // 当前索引中的忙碌时段数 (合并后)
+    Q_PROPERTY(int busyIntervalCount READ busyIntervalCount NOTIFY calendarChanged)
+
+public:
+    explicit CalendarMonitor(Clock* clock, QObject* parent = nullptr);
+
+    // 索引对象在监视器的整个生命周期内不变，重新加载时原地更新
+    const CalendarIndex* index() const { return &m_index; }
+
+    QStringList paths() const { return m_paths; }
+    void setPaths(const QStringList& paths);
+
+    int busyIntervalCount() const { return m_index.size(); }
+
+    // 立即重新解析全部日历文件
+    Q_INVOKABLE void reload();
+
+signals:
+    void pathsChanged();
+    // 忙碌时段已更新
+    void calendarChanged();
+
+private slots:
+    void onPathChanged();
+
+private:
+    // 展开目录，返回全部 .ics 文件
+    QStringList calendarFiles() const;
+    void updateWatches(const QStringList& files);
+
+    static const int RELOAD_DEBOUNCE_MS = 1000;
+    static const int WINDOW_DAYS = 14;
+    static const int WINDOW_REFRESH_MS = 6 * 60 * 60 * 1000;
+
+    Clock* m_clock;
+    ClockTimer* m_reloadTimer;  // 文件变化防抖
+    ClockTimer* m_windowTimer;  // 查询窗口滑动
+    QFileSystemWatcher m_watcher;
+    QStringList m_paths;
+    CalendarIndex m_index;
+};
@@ -0,0 +1,144 @@
+#include "Clock.h"
+#include <QTimer>
+#include <QElapsedTimer>
+#include <climits>
+
+#ifdef Q_OS_WIN
+#include <windows.h>
+#elif defined(Q_OS_LINUX)
+#include <time.h>
+#endif
+
+// ========================================================================
+// SystemClock
+// ========================================================================
+
+namespace {
+
+// 基于 QTimer 的单次定时器
+class SystemClockTimer : public ClockTimer
+{
+public:
+    // m_timer 作为子对象：事件分析 (WakeupAuditor) 可以沿父对象链找到定时器的使用者
+    explicit SystemClockTimer(QObject* parent) : ClockTimer(parent), m_timer(this) {
+        m_timer.setSingleShot(true);
+        m_timer.setTimerType(Qt::PreciseTimer);
+        connect(&m_timer, &QTimer::timeout, this, &ClockTimer::timeout);
+    }
+
+    void start(qint64 ms) override { m_timer.start(int(qBound<qint64>(0, ms, INT_MAX))); }
+    void stop() override { m_timer.stop(); }
+    bool isActive() const override { return m_timer.isActive(); }
+
+private:
+    QTimer m_timer;
+};
+
+} // namespace
+
+Clock* Clock::system() {
+    static SystemClock clock;
+    return &clock;
+}
+
+qint64 SystemClock::monotonicMs() const {
+#ifdef Q_OS_WIN
+    // GetTickCount64 包含睡眠/休眠时间
+    return qint64(GetTickCount64());
+#elif defined(Q_OS_LINUX)
+    // CLOCK_BOOTTIME 与 CLOCK_MONOTONIC 相同，但包含挂起时间
+    struct timespec ts;
+    if (clock_gettime(CLOCK_BOOTTIME, &ts) == 0) {
+        return qint64(ts.tv_sec) * 1000 + ts.tv_nsec / 1000000;
+    }
+#endif
+    static QElapsedTimer fallback;
+    if (!fallback.isValid()) fallback.start();
+    return fallback.elapsed();
+}
+
+QDateTime SystemClock::now() const {
+    return QDateTime::currentDateTime();
+}
+
+ClockTimer* SystemClock::createTimer(QObject* parent) {
+    return new SystemClockTimer(parent);
+}
+
+// ========================================================================
+// VirtualClock
+// ========================================================================
+
+VirtualClock::VirtualClock(const QDateTime& start)
+    : m_start(start)
+{
+}
+
+VirtualClock::~VirtualClock() {
+    // 定时器可能比时钟活得更久 (由各自的 parent 管理)，解除关联
+    for (VirtualClockTimer* timer : qAsConst(m_timers)) {
+        timer->m_clock = nullptr;
+        timer->m_active = false;
+    }
+}
+
+ClockTimer* VirtualClock::createTimer(QObject* parent) {
+    return new VirtualClockTimer(this, parent);
+}
+
+VirtualClockTimer* VirtualClock::nextDue() const {
+    VirtualClockTimer* next = nullptr;
+    for (VirtualClockTimer* timer : m_timers) {
+        if (!timer->m_active) continue;
+        if (!next || timer->m_dueMs < next->m_dueMs
+            || (timer->m_dueMs == next->m_dueMs && timer->m_sequence < next->m_sequence)) {
+            next = timer;
+        }
+    }
+    return next;
+}
+
+void VirtualClock::advance(qint64 ms) {
+    const qint64 target = m_monotonicMs + qMax<qint64>(0, ms);
+
+    // 每次只触发一个定时器：回调中可能启动/停止/删除其他定时器
+    while (VirtualClockTimer* timer = nextDue()) {
+        if (timer->m_dueMs > target) break;
+        m_monotonicMs = qMax(m_monotonicMs, timer->m_dueMs);
+        timer->m_active = false;
+        emit timer->timeout();
+    }
+    m_monotonicMs = target;
+}
+
+bool VirtualClock::advanceToNextTimer() {
+    VirtualClockTimer* timer = nextDue();
+    if (!timer) return false;
+    advance(timer->m_dueMs - m_monotonicMs);
+    return true;
+}
+
+int VirtualClock::activeTimerCount() const {
+    int count = 0;
+    for (VirtualClockTimer* timer : m_timers) {
+        if (timer->m_active) count++;
+    }
+    return count;
+}
+
+VirtualClockTimer::VirtualClockTimer(VirtualClock* clock, QObject* parent)
+    : ClockTimer(parent), m_clock(clock)
+{
+    m_clock->m_timers.append(this);
+}
+
+VirtualClockTimer::~VirtualClockTimer() {
+    if (m_clock) m_clock->m_timers.removeOne(this);
+}
+
+void VirtualClockTimer::start(qint64 ms) {
+    if (!m_clock) return;
+    m_dueMs = m_clock->m_monotonicMs + qMax<qint64>(0, ms);
+    m_sequence = m_clock->m_nextSequence++;
+    m_active = true;
+}
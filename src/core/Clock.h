@@ -0,0 +1,122 @@
+#pragma once
+
+#include <QObject>
+#include <QDateTime>
+#include <QList>
+
+// ========================================================================
+// Clock：可注入的时间源
+// ========================================================================
+// 作用：TimerEngine、ActivityLogger、ReminderScheduler 不再直接调用
+// QDateTime::currentDateTime() 或创建 QTimer，而是通过 Clock 获取时间
+// 与定时器。
+// - SystemClock：真实时间 (默认，Clock::system())
+// - VirtualClock：可手动推进的虚拟时间，用于自动化测试与基准测试，
+//   几秒内即可确定性地模拟数月的使用。
+// ========================================================================
+
+// 单次定时器 (由 Clock::createTimer 创建)
+class ClockTimer : public QObject
+{
+    Q_OBJECT
+public:
+    using QObject::QObject;
+
+    // 在 ms 毫秒后触发一次 timeout (重复调用会重新计时)
+    virtual void start(qint64 ms) = 0;
+    virtual void stop() = 0;
+    virtual bool isActive() const = 0;
+
+signals:
+    void timeout();
+};
+
+class Clock
+{
+public:
+    virtual ~Clock() = default;
+
+    // 单调时钟 (毫秒)，包含系统睡眠时间，只用于计算时间间隔
+    virtual qint64 monotonicMs() const = 0;
+
+    // 当前墙钟时间 (用于日志与显示)
+    virtual QDateTime now() const = 0;
+
+    // 创建一个单次定时器，所有权归 parent
+    virtual ClockTimer* createTimer(QObject* parent) = 0;
+
+    // 进程级默认时钟 (SystemClock)
+    static Clock* system();
+};
+
+// ========================================================================
+// SystemClock：真实时间
+// ========================================================================
+class SystemClock : public Clock
+{
+public:
+    qint64 monotonicMs() const override;
+    QDateTime now() const override;
+    ClockTimer* createTimer(QObject* parent) override;
+};
+
+// ========================================================================
+// VirtualClock：虚拟时间
+// ========================================================================
+// 时间只在调用 advance() / sleep() 时前进；advance() 会按到期顺序
+// (到期时间相同则按启动顺序) 同步触发期间到期的定时器，结果完全确定。
+// ========================================================================
+class VirtualClockTimer;
+
+class VirtualClock : public Clock
+{
+public:
+    explicit VirtualClock(const QDateTime& start = QDateTime(QDate(2026, 1, 5), QTime(9, 0)));
+    ~VirtualClock() override;
+
+    qint64 monotonicMs() const override { return m_monotonicMs; }
+    QDateTime now() const override { return m_start.addMSecs(m_monotonicMs); }
+    ClockTimer* createTimer(QObject* parent) override;
+
+    // 推进 ms 毫秒，并依次触发期间到期的定时器
+    void advance(qint64 ms);
+
+    // 推进到下一个定时器到期并触发它；没有活动定时器时返回 false
+    bool advanceToNextTimer();
+
+    // 模拟系统睡眠：时间前进但不触发定时器 (恢复后由下一次 advance 处理)
+    void sleep(qint64 ms) { m_monotonicMs += ms; }
+
+    // 模拟手动修改系统时间：只影响墙钟，单调时钟不变
+    void adjustWallTime(qint64 offsetMs) { m_start = m_start.addMSecs(offsetMs); }
+
+    int activeTimerCount() const;
+
+private:
+    friend class VirtualClockTimer;
+    VirtualClockTimer* nextDue() const;
+
+    QDateTime m_start;
+    qint64 m_monotonicMs = 0;
+    quint64 m_nextSequence = 0;
+    QList<VirtualClockTimer*> m_timers;
+};
+
+class VirtualClockTimer : public ClockTimer
+{
+    Q_OBJECT
+public:
+    VirtualClockTimer(VirtualClock* clock, QObject* parent);
+    ~VirtualClockTimer() override;
+
+    void start(qint64 ms) override;
+    void stop() override { m_active = false; }
+    bool isActive() const override { return m_active; }
+
+private:
+    friend class VirtualClock;
+    VirtualClock* m_clock;
+    bool m_active = false;
+    qint64 m_dueMs = 0;
+    quint64 m_sequence = 0;
+};
@@ -0,0 +1,30 @@
+#pragma once
+
+// ========================================================================
+// 本地控制协议 (单实例套接字上的 JSON Lines)
+// ========================================================================
+// 客户端连接 QLocalServer 后，每行发送一个 JSON 对象，服务端按顺序每个
+// 请求回复一行 JSON。连接可以保持，连续发送多条命令 (状态栏轮询无需重连)。
+//
+// 请求: {"cmd": "<命令>", ...参数}
+// 回复: {"ok": true, ...结果} 或 {"ok": false, "error": "<原因>"}
+//
+// 命令:
+//   status                          — 当前状态、剩余秒数、预计完成时间等
+//   start                           — 开始新一轮工作计时
+//   pause / resume / toggle         — 暂停 / 继续 / 切换
+//   snooze                          — 稍后提醒 (5 分钟)
+//   nap     [on: bool]              — 午休开关 (省略 on 时切换)
+//   stats   [date: "yyyy-MM-dd"]    — 某天的活动统计 (默认今天)
+//   export  [date, range: 0/1/2 (日/周/月), mode: 0/1 (完整/正式)] — 工作报告文本
+//   metrics                         — 性能指标快照 (计数器与耗时直方图)
+//   wake                            — 显示主窗口 (第二次启动时发送)
+//
+// 兼容旧版本：不带换行的纯文本 "WAKE_UP" 仍视为 wake。
+// ========================================================================
+namespace ControlProtocol {
+    // 与单实例锁共用同一个服务器名
+    constexpr const char *ServerName = "TraeAI_DeskCare_SingleInstance_Lock";
+    // 单行请求上限，超出视为异常客户端并断开
+    constexpr int MaxLineBytes = 64 * 1024;
+}
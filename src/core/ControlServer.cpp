@@ -0,0 +1,175 @@
+#include "ControlServer.h"
+#include "ControlProtocol.h"
+#include "TimerEngine.h"
+#include "ActivityLogger.h"
+#include "Metrics.h"
+#include "Logging.h"
+#include <QLocalServer>
+#include <QLocalSocket>
+#include <QJsonDocument>
+#include <QJsonParseError>
+#include <QMetaEnum>
+#include <QDate>
+
+ControlServer::ControlServer(TimerEngine *engine, ActivityLogger *logger, QObject *parent)
+    : QObject(parent), m_engine(engine), m_logger(logger), m_server(new QLocalServer(this))
+{
+    connect(m_server, &QLocalServer::newConnection, this, &ControlServer::onNewConnection);
+}
+
+ControlServer::~ControlServer() = default;
+
+void ControlServer::attach(TimerEngine *engine, ActivityLogger *logger) {
+    m_engine = engine;
+    m_logger = logger;
+}
+
+bool ControlServer::listen() {
+    // 上一个实例崩溃时 Unix 下会留下套接字文件
+    QLocalServer::removeServer(ControlProtocol::ServerName);
+    // 套接字提供活动历史，不允许其他本地用户连接
+    m_server->setSocketOptions(QLocalServer::UserAccessOption);
+    return m_server->listen(ControlProtocol::ServerName);
+}
+
+QString ControlServer::errorString() const {
+    return m_server->errorString();
+}
+
+void ControlServer::onNewConnection() {
+    while (QLocalSocket *socket = m_server->nextPendingConnection()) {
+        m_buffers.insert(socket, QByteArray());
+        connect(socket, &QLocalSocket::readyRead, this, [this, socket]() { onReadyRead(socket); });
+        connect(socket, &QLocalSocket::disconnected, this, [this, socket]() {
+            m_buffers.remove(socket);
+            socket->deleteLater();
+        });
+    }
+}
+
+void ControlServer::onReadyRead(QLocalSocket *socket) {
+    QByteArray &buffer = m_buffers[socket];
+    buffer += socket->readAll();
+
+    // 旧版本的第二个实例只发送 "WAKE_UP" (无换行) 后立即断开
+    if (buffer == "WAKE_UP") {
+        buffer.clear();
+        emit wakeRequested();
+        return;
+    }
+
+    int start = 0;
+    int newline;
+    while ((newline = buffer.indexOf('\n', start)) >= 0) {
+        const QByteArray line = buffer.mid(start, newline - start).trimmed();
+        start = newline + 1;
+        if (!line.isEmpty()) handleLine(socket, line);
+    }
+    buffer.remove(0, start);
+
+    if (buffer.size() > ControlProtocol::MaxLineBytes) {
+        qCWarning(lcUi) << "ControlServer: request line too long, dropping client";
+        buffer.clear();
+        socket->abort();
+    }
+}
+
+void ControlServer::handleLine(QLocalSocket *socket, const QByteArray &line) {
+    QJsonParseError error;
+    const QJsonDocument doc = QJsonDocument::fromJson(line, &error);
+    const QJsonObject reply = doc.isObject() ? handle(doc.object())
+                                             : errorReply(error.error != QJsonParseError::NoError
+                                                          ? error.errorString() : QStringLiteral("request must be a JSON object"));
+    socket->write(QJsonDocument(reply).toJson(QJsonDocument::Compact) + '\n');
+}
+
+// ========================================================================
+// 命令处理
+// ========================================================================
+
+QJsonObject ControlServer::handle(const QJsonObject &request) {
+    const QString cmd = request.value("cmd").toString();
+
+    if (cmd == "metrics") {
+        return QJsonObject{ { "ok", true }, { "metrics", Metrics::instance()->toJson() } };
+    }
+    if (cmd == "wake") {
+        emit wakeRequested();
+        return QJsonObject{ { "ok", true } };
+    }
+    if (!m_engine) return errorReply("starting up");
+
+    if (cmd == "status") {
+        return statusReply();
+    }
+    if (cmd == "start") {
+        m_engine->startWork();
+        return statusReply();
+    }
+    if (cmd == "pause") {
+        if (m_engine->isRunning()) m_engine->togglePause();
+        return statusReply();
+    }
+    if (cmd == "resume") {
+        if (m_engine->engineState() == TimerEngine::Engine_Paused) m_engine->togglePause();
+        return statusReply();
+    }
+    if (cmd == "toggle") {
+        m_engine->togglePause();
+        return statusReply();
+    }
+    if (cmd == "snooze") {
+        m_engine->snooze();
+        return statusReply();
+    }
+    if (cmd == "nap") {
+        const bool on = request.contains("on") ? request.value("on").toBool() : !m_engine->isNapMode();
+        if (on) m_engine->startNap();
+        else m_engine->stopNap();
+        return statusReply();
+    }
+    if (cmd == "stats" || cmd == "export") {
+        if (!m_logger) return errorReply("activity log unavailable");
+        QDate date = QDate::currentDate();
+        if (request.contains("date")) {
+            date = QDate::fromString(request.value("date").toString(), Qt::ISODate);
+            if (!date.isValid()) return errorReply("invalid date, expected yyyy-MM-dd");
+        }
+
+        QJsonObject reply{ { "ok", true }, { "date", date.toString(Qt::ISODate) } };
+        if (cmd == "stats") {
+            reply.insert("stats", QJsonObject::fromVariantMap(m_logger->getDailyStats(date)));
+            reply.insert("apps", QJsonValue::fromVariant(m_logger->getAppUsage(date)));
+            reply.insert("reminders", QJsonValue::fromVariant(m_logger->getReminders(date)));
+        } else {
+            const int range = qBound(0, request.value("range").toInt(0), 2);
+            const int mode = qBound(0, request.value("mode").toInt(0), 1);
+            reply.insert("report", m_logger->generateReport(date, range, mode));
+        }
+        return reply;
+    }
+
+    return errorReply(cmd.isEmpty() ? QStringLiteral("missing cmd") : QString("unknown cmd: %1").arg(cmd));
+}
+
+QJsonObject ControlServer::statusReply() const {
+    // 状态名取枚举名去掉前缀并转小写 (Engine_Working -> "working")
+    const char *key = QMetaEnum::fromType<TimerEngine::EngineState>().valueToKey(m_engine->engineState());
+    const QString state = key ? QString::fromLatin1(key).mid(7).toLower() : QString();
+
+    return QJsonObject{
+        { "ok", true },
+        { "state", state },
+        { "status", m_engine->statusText() },
+        { "remainingSeconds", m_engine->remainingSeconds() },
+        { "totalSeconds", m_engine->currentSessionTotalTime() },
+        { "running", m_engine->isRunning() },
+        { "nap", m_engine->isNapMode() },
+        { "estimatedFinish", m_engine->estimatedFinishTime() },
+        { "workMinutes", m_engine->workDurationMinutes() },
+    };
+}
+
+QJsonObject ControlServer::errorReply(const QString &message) {
+    return QJsonObject{ { "ok", false }, { "error", message } };
+}
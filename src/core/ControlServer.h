@@ -0,0 +1,57 @@
+#pragma once
+#include <QObject>
+#include <QJsonObject>
+#include <QHash>
+#include <QByteArray>
+
+class QLocalServer;
+class QLocalSocket;
+class TimerEngine;
+class ActivityLogger;
+
+// ========================================================================
+// ControlServer：单实例套接字上的本地控制服务
+// ========================================================================
+// 监听 ControlProtocol::ServerName，同时承担单实例锁与脚本控制接口
+// (协议见 ControlProtocol.h)。请求在主线程事件循环中处理，直接调用引擎
+// 与记录器的槽函数，不需要加锁。
+// 单实例探测失败后应立即 listen() (先于打开活动数据库)，核心模块创建后再
+// attach；此前除 wake / metrics 外的命令返回错误。
+// logger 可为空 (此时 stats / export 返回错误)。
+// 套接字只允许当前用户连接 (UserAccessOption)：stats / export 返回活动历史。
+// ========================================================================
+class ControlServer : public QObject {
+    Q_OBJECT
+public:
+    explicit ControlServer(TimerEngine *engine = nullptr, ActivityLogger *logger = nullptr, QObject *parent = nullptr);
+    ~ControlServer();
+
+    // 挂接引擎与记录器 (生命周期需长于事件循环)
+    void attach(TimerEngine *engine, ActivityLogger *logger);
+
+    // 清理残留的套接字文件后开始监听，失败时返回 false (程序可继续运行，只是失去单实例与控制功能)
+    bool listen();
+    QString errorString() const;
+
+    // 处理一条请求并返回回复 (不涉及套接字，便于在进程内复用)
+    QJsonObject handle(const QJsonObject &request);
+
+signals:
+    // 收到 wake 命令 (另一个实例启动)
+    void wakeRequested();
+
+private slots:
+    void onNewConnection();
+
+private:
+    void onReadyRead(QLocalSocket *socket);
+    void handleLine(QLocalSocket *socket, const QByteArray &line);
+    QJsonObject statusReply() const;
+
+    static QJsonObject errorReply(const QString &message);
+
+    TimerEngine *m_engine;
+    ActivityLogger *m_logger;
+    QLocalServer *m_server;
+    QHash<QLocalSocket *, QByteArray> m_buffers; // 每个连接未读完的半行
+};
@@ -0,0 +1,291 @@
+#include "HistoryGenerator.h"
+#include "SqliteActivityStore.h"
+#include "Logging.h"
+#include <QDir>
+#include <QFile>
+#include <QSaveFile>
+#include <QSqlDatabase>
+#include <QSqlQuery>
+#include <QSqlError>
+#include <QJsonDocument>
+#include <QJsonObject>
+#include <QRandomGenerator>
+#include <QVector>
+#include <QtMath>
+
+static const double kRowsPerDay = 40;      // 普通工作日的平均行数
+static const int kMaxDays = 3650;          // 最长 10 年
+static const int kCommitEveryRows = 50000; // 大事务分批提交，限制回滚日志大小
+
+// 工时日志素材 (中英混合，与真实记录相近)
+static const char* const kPhrases[] = {
+    "修复活动记录查询的分页问题", "评审合并请求并补充注释", "与产品讨论下个版本的需求",
+    "编写周报", "整理会议纪要", "重构计时引擎状态机", "排查线上崩溃日志", "阅读 Qt 文档: QSqlQuery",
+    "Write design doc for history sync", "Code review for the tray icon changes", "Update third-party dependencies",
+    "学习 SQLite 索引与查询计划", "准备季度汇报材料", "对接测试环境部署", "整理待办事项",
+    "Investigate flaky reminder timing", "Pair programming session", "优化启动速度", "补充单元测试用例",
+    "阅读论文并做笔记", "练习英语听力", "健身计划与饮食记录",
+};
+
+static QString phraseText(QRandomGenerator& rng, int targetChars) {
+    const int count = int(sizeof(kPhrases) / sizeof(kPhrases[0]));
+    QString text;
+    while (text.size() < targetChars) {
+        if (!text.isEmpty()) text += rng.bounded(4) == 0 ? QStringLiteral("\n") : QStringLiteral("；");
+        text += QString::fromUtf8(kPhrases[rng.bounded(count)]);
+    }
+    return text;
+}
+
+// 与界面保存的格式一致: {"formal":"...","learning":"...","personal":"..."}
+static QString workLogContent(QRandomGenerator& rng, const HistoryGenerator::Options& options, int* workType) {
+    const int roll = rng.bounded(10);
+    *workType = roll < 7 ? 0 : roll < 9 ? 1 : 2;
+    const bool isLong = rng.generateDouble() < options.longContentRatio;
+    const int chars = isLong ? int(options.longContentChars * (0.7 + 0.6 * rng.generateDouble()))
+                             : 20 + rng.bounded(60);
+
+    QJsonObject json;
+    json["formal"] = *workType == 0 ? phraseText(rng, chars) : QString();
+    json["learning"] = *workType == 1 ? phraseText(rng, chars) : QString();
+    json["personal"] = *workType == 2 ? phraseText(rng, chars) : QString();
+    return QString::fromUtf8(QJsonDocument(json).toJson(QJsonDocument::Compact));
+}
+
+// ========================================================================
+// 生成
+// ========================================================================
+
+namespace {
+
+struct Segment {
+    const char* state;
+    double weight; // 相对时长，最后按当天时间窗缩放
+};
+
+// 一天的会话序列 (首尾相接)
+QVector<Segment> daySegments(QRandomGenerator& rng, int rows, bool fragmented) {
+    QVector<Segment> segments;
+    segments.reserve(rows);
+    const int lunch = rows / 2 | 1; // 中间的一个休息位换成午休
+    const bool lunchOffline = rng.bounded(10) < 3;
+    for (int i = 0; i < rows; ++i) {
+        const double jitter = 0.4 + 1.2 * rng.generateDouble();
+        if (fragmented) {
+            // 频繁锁屏：几分钟专注、一两分钟锁屏
+            segments.append(i % 2 == 0 ? Segment{ "Focus", 6 * jitter } : Segment{ "Pause", 2 * jitter });
+        } else if (i % 2 == 0) {
+            segments.append({ "Focus", 40 * jitter });
+        } else if (i == lunch && rows > 6) {
+            segments.append(lunchOffline ? Segment{ "Offline", 60 * jitter } : Segment{ "Nap", 25 * jitter });
+        } else if (rng.bounded(10) == 0) {
+            segments.append({ "Pause", 8 * jitter });
+        } else {
+            segments.append({ "Rest", 5 * jitter });
+        }
+    }
+    return segments;
+}
+
+} // namespace
+
+bool HistoryGenerator::generate(const QString& dataDir, const Options& options, Result* result, QString* error) {
+    const auto fail = [error](const QString& message) {
+        if (error) *error = message;
+        qCWarning(lcDb) << "HistoryGenerator:" << message;
+        return false;
+    };
+
+    const QDir dir(dataDir);
+    if (dir.exists("activity_log.db")) return fail("activity_log.db already exists in " + dataDir);
+    if (!QDir().mkpath(dataDir)) return fail("cannot create " + dataDir);
+    if (options.rows <= 0) return fail("row count must be positive");
+
+    // 表结构 (含迁移) 与正式存储保持一致
+    {
+        SqliteActivityStore schema(dataDir, "history_generator_schema", false);
+        if (!schema.isOpen()) return fail("cannot create schema in " + dataDir);
+    }
+
+    *result = Result();
+    QRandomGenerator rng(options.seed);
+    const QDate endDate = options.endDate.isValid() ? options.endDate : QDate::currentDate().addDays(-1);
+    const int days = int(qBound<qint64>(1, qint64(qCeil(options.rows / kRowsPerDay)), kMaxDays));
+
+    // 按权重把总行数分到每一天：周末少，碎片化的日子多
+    QVector<bool> fragmented(days);
+    QVector<double> weights(days);
+    double totalWeight = 0;
+    for (int i = 0; i < days; ++i) {
+        const QDate date = endDate.addDays(i - days + 1);
+        fragmented[i] = rng.generateDouble() < options.fragmentedDayRatio;
+        const double base = fragmented[i] ? 4.0 : date.dayOfWeek() >= 6 ? 0.4 : 1.0;
+        weights[i] = base * (0.8 + 0.4 * rng.generateDouble());
+        totalWeight += weights[i];
+    }
+    QVector<qint64> rowsPerDay(days);
+    qint64 assigned = 0;
+    for (int i = 0; i < days; ++i) {
+        rowsPerDay[i] = qMax<qint64>(1, qint64(options.rows * weights[i] / totalWeight));
+        assigned += rowsPerDay[i];
+    }
+    // 取整误差补到 (或扣自) 最后几天
+    for (int i = days - 1; assigned != options.rows; i = (i + days - 1) % days) {
+        if (assigned < options.rows) {
+            rowsPerDay[i]++;
+            assigned++;
+        } else if (rowsPerDay[i] > 1) {
+            rowsPerDay[i]--;
+            assigned--;
+        }
+    }
+
+    bool ok = true;
+    {
+        QSqlDatabase db = QSqlDatabase::addDatabase("QSQLITE", "history_generator");
+        db.setDatabaseName(dir.filePath("activity_log.db"));
+        if (!db.open()) {
+            const QString message = db.lastError().text();
+            db = QSqlDatabase();
+            QSqlDatabase::removeDatabase("history_generator");
+            return fail("cannot open database: " + message);
+        }
+        QSqlQuery pragma(db);
+        pragma.exec("PRAGMA synchronous = OFF");
+        pragma.exec("PRAGMA journal_mode = MEMORY");
+
+        QSqlQuery insert(db);
+        insert.prepare("INSERT INTO activity_log (state, start_time, end_time, duration, content, work_type) "
+                       "VALUES (?, ?, ?, ?, ?, ?)");
+        db.transaction();
+        qint64 sinceCommit = 0;
+
+        for (int i = 0; i < days && ok; ++i) {
+            const QDate date = endDate.addDays(i - days + 1);
+            const bool weekend = date.dayOfWeek() >= 6;
+            const int rows = int(rowsPerDay[i]);
+
+            // 当天时间窗：8:30~9:30 开始，工作日约 9 小时，周末 4~6 小时；行数过多时按需延长
+            const qint64 dayStart = QDateTime(date, QTime(8, 30)).toSecsSinceEpoch() + rng.bounded(3600);
+            const qint64 window = qMax<qint64>(rows, weekend ? 4 * 3600 + rng.bounded(2 * 3600)
+                                                             : 8 * 3600 + rng.bounded(2 * 3600));
+
+            const QVector<Segment> segments = daySegments(rng, rows, fragmented[i]);
+            double sum = 0;
+            for (const Segment& segment : segments) sum += segment.weight;
+
+            // 按累计值取整，保证首尾相接且总长等于时间窗
+            double accumulated = 0;
+            qint64 start = dayStart;
+            for (const Segment& segment : segments) {
+                accumulated += segment.weight;
+                const qint64 end = qMax(start + 1, dayStart + qint64(window * accumulated / sum));
+
+                int workType = 0;
+                QString content;
+                if (qstrcmp(segment.state, "Focus") == 0 && rng.generateDouble() < options.contentRatio) {
+                    content = workLogContent(rng, options, &workType);
+                }
+                insert.addBindValue(QString::fromLatin1(segment.state));
+                insert.addBindValue(start);
+                insert.addBindValue(end);
+                insert.addBindValue(int(end - start));
+                insert.addBindValue(content.isEmpty() ? QVariant(QVariant::String) : QVariant(content));
+                insert.addBindValue(workType);
+                if (!insert.exec()) {
+                    fail("insert failed: " + insert.lastError().text());
+                    ok = false;
+                    break;
+                }
+                start = end;
+
+                if (++sinceCommit >= kCommitEveryRows) {
+                    db.commit();
+                    db.transaction();
+                    sinceCommit = 0;
+                }
+            }
+
+            result->rows += rows;
+            if (fragmented[i]) result->fragmentedDay = date;
+            else if (!weekend) result->typicalDay = date;
+        }
+
+        if (ok) ok = db.commit();
+        else db.rollback();
+        insert = QSqlQuery();
+        pragma = QSqlQuery();
+        db.close();
+        db = QSqlDatabase();
+        QSqlDatabase::removeDatabase("history_generator");
+    }
+    if (!ok) return false;
+
+    result->days = days;
+    result->firstDate = endDate.addDays(1 - days);
+    result->lastDate = endDate;
+    if (!result->typicalDay.isValid()) result->typicalDay = endDate;
+
+    // 再打开一次：往年的数据按正常流程归档
+    {
+        SqliteActivityStore rollover(dataDir, "history_generator_rollover", false);
+    }
+    qCDebug(lcDb) << "HistoryGenerator: generated" << result->rows << "rows over" << days << "days in" << dataDir;
+    return true;
+}
+
+// ========================================================================
+// generator.json
+// ========================================================================
+
+static QJsonObject optionsToJson(const HistoryGenerator::Options& options) {
+    QJsonObject json;
+    json["rows"] = double(options.rows);
+    json["endDate"] = options.endDate.toString(Qt::ISODate);
+    json["seed"] = double(options.seed);
+    json["fragmentedDayRatio"] = options.fragmentedDayRatio;
+    json["contentRatio"] = options.contentRatio;
+    json["longContentRatio"] = options.longContentRatio;
+    json["longContentChars"] = options.longContentChars;
+    return json;
+}
+
+bool HistoryGenerator::saveResult(const QString& dataDir, const Options& options, const Result& result) {
+    // 默认的结束日期 ("昨天") 记录为实际日期
+    Options resolved = options;
+    if (!resolved.endDate.isValid()) resolved.endDate = result.lastDate;
+
+    QJsonObject json;
+    json["options"] = optionsToJson(resolved);
+    json["rows"] = double(result.rows);
+    json["days"] = result.days;
+    json["firstDate"] = result.firstDate.toString(Qt::ISODate);
+    json["lastDate"] = result.lastDate.toString(Qt::ISODate);
+    json["typicalDay"] = result.typicalDay.toString(Qt::ISODate);
+    json["fragmentedDay"] = result.fragmentedDay.toString(Qt::ISODate);
+
+    QSaveFile file(QDir(dataDir).filePath("generator.json"));
+    if (!file.open(QIODevice::WriteOnly)) return false;
+    file.write(QJsonDocument(json).toJson());
+    return file.commit();
+}
+
+bool HistoryGenerator::loadResult(const QString& dataDir, const Options& options, Result* result) {
+    const QDir dir(dataDir);
+    QFile file(dir.filePath("generator.json"));
+    if (!dir.exists("activity_log.db") || !file.open(QIODevice::ReadOnly)) return false;
+
+    const QJsonObject json = QJsonDocument::fromJson(file.readAll()).object();
+    // 参数不同的目录不能复用；未指定结束日期时接受已生成的任意日期
+    Options resolved = options;
+    if (!resolved.endDate.isValid()) resolved.endDate = QDate::fromString(json["lastDate"].toString(), Qt::ISODate);
+    if (json["options"].toObject() != optionsToJson(resolved)) return false;
+
+    result->rows = qint64(json["rows"].toDouble());
+    result->days = json["days"].toInt();
+    result->firstDate = QDate::fromString(json["firstDate"].toString(), Qt::ISODate);
+    result->lastDate = QDate::fromString(json["lastDate"].toString(), Qt::ISODate);
+    result->typicalDay = QDate::fromString(json["typicalDay"].toString(), Qt::ISODate);
+    result->fragmentedDay = QDate::fromString(json["fragmentedDay"].toString(), Qt::ISODate);
+    return true;
+}
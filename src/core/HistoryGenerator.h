@@ -0,0 +1,51 @@
+#pragma once
+
+#include <QDate>
+#include <QString>
+
+// ========================================================================
+// HistoryGenerator：合成活动历史 (activity_log 数据库)
+// ========================================================================
+// 为基准测试 (tests/benchmarks) 与手工压测生成与真实安装结构一致的数据目录
+// (--generate-history=<目录> --rows=<行数>)：
+// - 从 endDate 往前逐天生成，工作日约 9 小时、周末较短，会话首尾相接：
+//   Focus / Rest 交替，夹杂锁屏 Pause、午休 Nap 与 Offline。
+// - 一部分日子是"碎片化"的：频繁锁屏/解锁，Focus 与 Pause 以几分钟为
+//   单位交替，行数是普通日子的数倍 (查询一天时最坏的情况)。
+// - 部分 Focus 会话带工时日志 (与界面写入的 JSON 格式相同)，其中少数是
+//   上千字的长文本。
+// - 行数较多时历史最长 10 年，超出部分提高每天的会话密度。
+//
+// 表结构由 SqliteActivityStore 创建，数据以大事务批量写入，结束后再打开
+// 一次存储，让往年数据按正常流程归档到 activity_log_<年份>.db。
+// 同样的参数 (seed) 总是生成同样的数据。
+// ========================================================================
+class HistoryGenerator
+{
+public:
+    struct Options {
+        qint64 rows = 100000;
+        QDate endDate;                  // 最后一天 (默认昨天)
+        quint32 seed = 1;
+        double fragmentedDayRatio = 0.15; // 碎片化日子的比例
+        double contentRatio = 0.5;        // 带工时日志的 Focus 会话比例
+        double longContentRatio = 0.05;   // 其中长文本的比例
+        int longContentChars = 2000;
+    };
+
+    struct Result {
+        qint64 rows = 0;
+        int days = 0;
+        QDate firstDate;
+        QDate lastDate;
+        QDate typicalDay;    // 最近一个普通工作日
+        QDate fragmentedDay; // 最近一个碎片化的日子 (没有时无效)
+    };
+
+    // 在 dataDir 中生成数据库 (目录中不能已有 activity_log.db)，失败时返回 false
+    static bool generate(const QString& dataDir, const Options& options, Result* result, QString* error = nullptr);
+
+    // 生成结果的描述文件 (generator.json)，供基准测试复用已生成的目录
+    static bool saveResult(const QString& dataDir, const Options& options, const Result& result);
+    static bool loadResult(const QString& dataDir, const Options& options, Result* result);
+};
@@ -0,0 +1,381 @@
+#include "HistoryHttpServer.h"
+#include "ActivityLogger.h"
+#include "Clock.h"
+#include "Metrics.h"
+#include "Logging.h"
+#include <QTcpServer>
+#include <QTcpSocket>
+#include <QHostAddress>
+#include <QSettings>
+#include <QFile>
+#include <QUrl>
+#include <QUrlQuery>
+#include <QJsonDocument>
+#include <QJsonObject>
+#include <QJsonArray>
+#include <QRandomGenerator>
+#include <QPointer>
+
+static QByteArray statusLine(int status) {
+    switch (status) {
+        case 200: return "200 OK";
+        case 304: return "304 Not Modified";
+        case 400: return "400 Bad Request";
+        case 403: return "403 Forbidden";
+        case 404: return "404 Not Found";
+        case 405: return "405 Method Not Allowed";
+        case 431: return "431 Request Header Fields Too Large";
+        default:  return QByteArray::number(status);
+    }
+}
+
+static QByteArray jsonError(const QString &message) {
+    return QJsonDocument(QJsonObject{ { "error", message } }).toJson(QJsonDocument::Compact);
+}
+
+// yyyy-MM-dd，缺省时取 fallback
+static QDate parseDate(const QUrlQuery &query, const QString &key, const QDate &fallback) {
+    if (!query.hasQueryItem(key)) return fallback;
+    return QDate::fromString(query.queryItemValue(key), Qt::ISODate);
+}
+
+HistoryHttpServer::HistoryHttpServer(ActivityLogger *logger, QObject *parent)
+    : QObject(parent), m_logger(logger), m_server(new QTcpServer(this))
+{
+    m_etagPrefix = "\"" + QByteArray::number(QRandomGenerator::global()->generate64(), 36) + "-r";
+    connect(m_server, &QTcpServer::newConnection, this, &HistoryHttpServer::onNewConnection);
+
+    QSettings settings("TraeAI", "DeskCare");
+    m_enabled = settings.value("Http/enabled", false).toBool();
+    m_port = settings.value("Http/port", m_port).toInt();
+    restart();
+}
+
+HistoryHttpServer::~HistoryHttpServer() = default;
+
+void HistoryHttpServer::setEnabled(bool enabled) {
+    if (m_enabled == enabled) return;
+    m_enabled = enabled;
+    QSettings settings("TraeAI", "DeskCare");
+    settings.setValue("Http/enabled", enabled);
+    restart();
+    emit enabledChanged();
+}
+
+void HistoryHttpServer::setPort(int port) {
+    if (port < 1 || port > 65535 || m_port == port) return;
+    m_port = port;
+    QSettings settings("TraeAI", "DeskCare");
+    settings.setValue("Http/port", port);
+    restart();
+    emit portChanged();
+}
+
+bool HistoryHttpServer::isListening() const {
+    return m_server->isListening();
+}
+
+QString HistoryHttpServer::url() const {
+    return isListening() ? QString("http://127.0.0.1:%1/").arg(m_server->serverPort()) : QString();
+}
+
+void HistoryHttpServer::restart() {
+    const bool wasListening = m_server->isListening();
+    if (wasListening) m_server->close();
+
+    if (m_enabled) {
+        // 只绑定回环地址，局域网内其他机器无法访问
+        if (m_server->listen(QHostAddress::LocalHost, quint16(m_port))) {
+            qCDebug(lcUi) << "HistoryHttpServer: listening on" << url();
+        } else {
+            qCWarning(lcUi) << "HistoryHttpServer: cannot listen on port" << m_port << m_server->errorString();
+        }
+    }
+
+    if (wasListening || m_server->isListening()) emit listeningChanged();
+}
+
+void HistoryHttpServer::onNewConnection() {
+    while (QTcpSocket *socket = m_server->nextPendingConnection()) {
+        m_connections.insert(socket, Connection());
+        connect(socket, &QTcpSocket::readyRead, this, [this, socket]() { onReadyRead(socket); });
+        connect(socket, &QTcpSocket::bytesWritten, this, [this, socket]() { pumpStream(socket); });
+        connect(socket, &QTcpSocket::disconnected, this, [this, socket]() {
+            m_connections.remove(socket);
+            socket->deleteLater();
+        });
+    }
+}
+
+void HistoryHttpServer::onReadyRead(QTcpSocket *socket) {
+    auto it = m_connections.find(socket);
+    if (it == m_connections.end()) return;
+    it->buffer += socket->readAll();
+    processRequests(socket);
+}
+
+// ========================================================================
+// 请求解析
+// ========================================================================
+
+void HistoryHttpServer::processRequests(QTcpSocket *socket) {
+    while (true) {
+        auto it = m_connections.find(socket);
+        if (it == m_connections.end() || it->streaming || !it->keepAlive) return;
+
+        const int headerEnd = it->buffer.indexOf("\r\n\r\n");
+        if (headerEnd < 0) {
+            if (it->buffer.size() > MAX_HEADER_BYTES) {
+                it->keepAlive = false;
+                writeResponse(socket, 431, "application/json", jsonError("request header too large"));
+            }
+            return;
+        }
+
+        const QList<QByteArray> lines = it->buffer.left(headerEnd).split('\n');
+        it->buffer.remove(0, headerEnd + 4);
+
+        const QList<QByteArray> requestLine = lines.value(0).trimmed().split(' ');
+        if (requestLine.size() != 3) {
+            it->keepAlive = false;
+            writeResponse(socket, 400, "application/json", jsonError("malformed request line"));
+            return;
+        }
+
+        QHash<QByteArray, QByteArray> headers;
+        for (int i = 1; i < lines.size(); ++i) {
+            const int colon = lines.at(i).indexOf(':');
+            if (colon <= 0) continue;
+            headers.insert(lines.at(i).left(colon).trimmed().toLower(), lines.at(i).mid(colon + 1).trimmed());
+        }
+
+        // HTTP/1.1 默认保持连接，HTTP/1.0 需要显式 keep-alive
+        const QByteArray connection = headers.value("connection").toLower();
+        it->keepAlive = requestLine.at(2) == "HTTP/1.1" ? connection != "close" : connection == "keep-alive";
+
+        // 只接受 GET：不读取请求体，带请求体的连接无法继续解析，直接关闭
+        if (requestLine.at(0) != "GET") {
+            it->keepAlive = false;
+            writeResponse(socket, 405, "application/json", jsonError("only GET is supported"));
+            return;
+        }
+
+        handleRequest(socket, requestLine.at(1), headers);
+    }
+}
+
+bool HistoryHttpServer::hostAllowed(const QByteArray &host) const {
+    // 防御 DNS 重绑定：只接受以回环地址或 localhost 访问
+    const QByteArray port = ":" + QByteArray::number(m_server->serverPort());
+    for (const QByteArray &name : { QByteArray("127.0.0.1"), QByteArray("localhost") }) {
+        if (host == name || host == name + port) return true;
+    }
+    return false;
+}
+
+// ========================================================================
+// 路由
+// ========================================================================
+
+void HistoryHttpServer::handleRequest(QTcpSocket *socket, const QByteArray &target,
+                                      const QHash<QByteArray, QByteArray> &headers) {
+    static MetricHistogram *s_latency = Metrics::instance()->histogram("http.request");
+    MetricTimer timer(s_latency);
+    if (!hostAllowed(headers.value("host"))) {
+        writeResponse(socket, 403, "application/json", jsonError("forbidden host"));
+        return;
+    }
+
+    const QUrl url = QUrl::fromEncoded("http://localhost" + target);
+    const QString path = url.path();
+    const QUrlQuery query(url);
+    const QDate today = m_logger->clock()->now().date();
+    const QByteArray ifNoneMatch = headers.value("if-none-match");
+
+    if (path == "/" || path == "/index.html") {
+        QFile page(":/assets/web/dashboard.html");
+        if (!page.open(QIODevice::ReadOnly)) {
+            writeResponse(socket, 404, "application/json", jsonError("dashboard not bundled"));
+            return;
+        }
+        writeResponse(socket, 200, "text/html; charset=utf-8", page.readAll());
+        return;
+    }
+
+    if (path == "/api/metrics") {
+        writeResponse(socket, 200, "application/json",
+                      QJsonDocument(Metrics::instance()->toJson()).toJson(QJsonDocument::Compact));
+        return;
+    }
+
+    if (path == "/api/revision") {
+        const QJsonObject body{ { "revision", QString::number(m_logger->dataRevision()) } };
+        writeResponse(socket, 200, "application/json", QJsonDocument(body).toJson(QJsonDocument::Compact));
+        return;
+    }
+
+    if (path == "/api/day") {
+        const QDate date = parseDate(query, "date", today);
+        if (!date.isValid()) {
+            writeResponse(socket, 400, "application/json", jsonError("invalid date, expected yyyy-MM-dd"));
+            return;
+        }
+        const QByteArray etag = etagFor(date, date);
+        if (ifNoneMatch == etag) {
+            writeResponse(socket, 304, QByteArray(), QByteArray(), etag);
+            return;
+        }
+        const QJsonObject body{
+            { "date", date.toString(Qt::ISODate) },
+            { "activities", QJsonArray::fromVariantList(m_logger->getDailyActivities(date)) },
+            { "stats", QJsonObject::fromVariantMap(m_logger->getDailyStats(date)) },
+            { "apps", QJsonArray::fromVariantList(m_logger->getAppUsage(date)) },
+            { "reminders", QJsonArray::fromVariantList(m_logger->getReminders(date)) },
+        };
+        writeResponse(socket, 200, "application/json", QJsonDocument(body).toJson(QJsonDocument::Compact), etag);
+        return;
+    }
+
+    if (path == "/api/range" || path == "/api/search") {
+        const QDate to = parseDate(query, "to", today);
+        const QDate from = parseDate(query, "from", to.isValid() ? to.addDays(-6) : QDate());
+        if (!from.isValid() || !to.isValid() || from > to || from.daysTo(to) >= MAX_RANGE_DAYS) {
+            writeResponse(socket, 400, "application/json",
+                          jsonError(QString("invalid range, expected from <= to within %1 days").arg(MAX_RANGE_DAYS)));
+            return;
+        }
+        const QByteArray etag = etagFor(from, to);
+        if (ifNoneMatch == etag) {
+            writeResponse(socket, 304, QByteArray(), QByteArray(), etag);
+            return;
+        }
+
+        if (path == "/api/range") {
+            Connection &connection = m_connections[socket];
+            connection.streaming = true;
+            connection.firstDay = true;
+            connection.nextDate = from;
+            connection.lastDate = to;
+            writeHead(socket, 200, "application/json", etag, -1);
+            writeChunk(socket, QString("{\"from\":\"%1\",\"to\":\"%2\",\"days\":[")
+                                   .arg(from.toString(Qt::ISODate), to.toString(Qt::ISODate)).toUtf8());
+            pumpStream(socket);
+            return;
+        }
+
+        // 搜索：SQL 中先筛出有工作日志的记录，再按关键字 (不区分大小写) 过滤
+        const QString needle = query.queryItemValue("q", QUrl::FullyDecoded).trimmed();
+        if (needle.isEmpty()) {
+            writeResponse(socket, 400, "application/json", jsonError("missing q"));
+            return;
+        }
+        const int limit = qBound(1, query.hasQueryItem("limit") ? query.queryItemValue("limit").toInt() : 200, 1000);
+        const QVariantMap filter{
+            { "startMs", QDateTime(from, QTime(0, 0)).toMSecsSinceEpoch() },
+            { "endMs", QDateTime(to, QTime(23, 59, 59)).toMSecsSinceEpoch() },
+            { "hasContent", true },
+        };
+        QJsonArray results;
+        bool truncated = false;
+        const QVariantList records = m_logger->queryActivities(filter);
+        for (const QVariant &record : records) {
+            const QVariantMap map = record.toMap();
+            if (!map.value("content").toString().contains(needle, Qt::CaseInsensitive)) continue;
+            if (results.size() >= limit) {
+                truncated = true;
+                break;
+            }
+            results.append(QJsonObject::fromVariantMap(map));
+        }
+        const QJsonObject body{ { "q", needle }, { "results", results }, { "truncated", truncated } };
+        writeResponse(socket, 200, "application/json", QJsonDocument(body).toJson(QJsonDocument::Compact), etag);
+        return;
+    }
+
+    writeResponse(socket, 404, "application/json", jsonError("not found"));
+}
+
+// ========================================================================
+// 流式响应
+// ========================================================================
+
+void HistoryHttpServer::pumpStream(QTcpSocket *socket) {
+    auto it = m_connections.find(socket);
+    if (it == m_connections.end() || !it->streaming) return;
+
+    // 发送缓冲区低于阈值时才生成下一天，慢客户端不会让内存无限增长
+    while (socket->bytesToWrite() < STREAM_LOW_WATER_BYTES && it->nextDate <= it->lastDate) {
+        const QDate date = it->nextDate;
+        const QJsonObject day{
+            { "date", date.toString(Qt::ISODate) },
+            { "activities", QJsonArray::fromVariantList(m_logger->getDailyActivities(date)) },
+        };
+        QByteArray data = QJsonDocument(day).toJson(QJsonDocument::Compact);
+        if (!it->firstDay) data.prepend(',');
+        it->firstDay = false;
+        it->nextDate = date.addDays(1);
+        writeChunk(socket, data);
+    }
+    if (it->nextDate <= it->lastDate) return;
+
+    writeChunk(socket, "]}");
+    socket->write("0\r\n\r\n");
+    it->streaming = false;
+
+    if (!it->keepAlive) {
+        socket->disconnectFromHost();
+        return;
+    }
+    // 客户端可能已经流水线发送了下一个请求。排队到下一轮事件循环再处理：
+    // 直接调用会形成 processRequests -> pumpStream -> processRequests 递归，
+    // 流水线很长时栈深度随请求数增长
+    QPointer<QTcpSocket> guard(socket);
+    QMetaObject::invokeMethod(this, [this, guard]() {
+        if (guard) processRequests(guard);
+    }, Qt::QueuedConnection);
+}
+
+QByteArray HistoryHttpServer::etagFor(const QDate &from, const QDate &to) const {
+    QByteArray etag = m_etagPrefix + QByteArray::number(m_logger->dataRevision());
+    // 进行中的会话覆盖开始那天到今天 (跨过午夜时今天的数据也在变化)，时长按分钟刷新
+    const QDateTime ongoingStart = m_logger->currentSessionStart();
+    const QDateTime now = m_logger->clock()->now();
+    if (ongoingStart.isValid() && ongoingStart.date() <= to && now.date() >= from) {
+        etag += "-m" + QByteArray::number(now.toSecsSinceEpoch() / 60);
+    }
+    return etag + '"';
+}
+
+// ========================================================================
+// 输出
+// ========================================================================
+
+void HistoryHttpServer::writeResponse(QTcpSocket *socket, int status, const QByteArray &contentType,
+                                      const QByteArray &body, const QByteArray &etag) {
+    writeHead(socket, status, contentType, etag, body.size());
+    socket->write(body);
+    auto it = m_connections.constFind(socket);
+    if (it == m_connections.constEnd() || !it->keepAlive) socket->disconnectFromHost();
+}
+
+// contentLength < 0 表示分块传输
+void HistoryHttpServer::writeHead(QTcpSocket *socket, int status, const QByteArray &contentType,
+                                  const QByteArray &etag, qint64 contentLength) {
+    const bool keepAlive = m_connections.value(socket).keepAlive;
+
+    QByteArray head = "HTTP/1.1 " + statusLine(status) + "\r\n";
+    if (!contentType.isEmpty()) head += "Content-Type: " + contentType + "\r\n";
+    if (contentLength < 0) head += "Transfer-Encoding: chunked\r\n";
+    else if (status != 304) head += "Content-Length: " + QByteArray::number(contentLength) + "\r\n";
+    if (!etag.isEmpty()) head += "ETag: " + etag + "\r\n";
+    // 浏览器每次都带 If-None-Match 重新验证
+    head += "Cache-Control: no-cache\r\n";
+    head += keepAlive ? "Connection: keep-alive\r\n" : "Connection: close\r\n";
+    head += "\r\n";
+    socket->write(head);
+}
+
+void HistoryHttpServer::writeChunk(QTcpSocket *socket, const QByteArray &data) {
+    if (data.isEmpty()) return; // 空块表示结束，由调用方单独写出
+    socket->write(QByteArray::number(data.size(), 16) + "\r\n" + data + "\r\n");
+}
@@ -0,0 +1,103 @@
+#pragma once
+#include <QObject>
+#include <QHash>
+#include <QDate>
+#include <QByteArray>
+
+class QTcpServer;
+class QTcpSocket;
+class ActivityLogger;
+
+// ========================================================================
+// HistoryHttpServer：本机 HTTP 历史数据接口 (可选，默认关闭)
+// ========================================================================
+// 只监听 127.0.0.1，供浏览器与本地工具查看活动历史：
+//   GET /                                  — 静态仪表盘页面 (qrc:/assets/web/dashboard.html)
+//   GET /api/revision                      — {"revision": n}
+//   GET /api/metrics                       — 性能指标快照 (Metrics::toJson)
+//   GET /api/day?date=yyyy-MM-dd           — 某天的活动列表与统计
+//   GET /api/range?from=...&to=...         — 按天分块流式输出 (Transfer-Encoding: chunked)
+//   GET /api/search?q=...&from=&to=&limit= — 在工作日志内容中搜索
+//
+// 缓存：ETag 由本进程的随机前缀与 ActivityLogger::dataRevision() 生成
+// (修订号每次启动从 0 开始，前缀保证重启后不会与旧的 ETag 相同)；进行中
+// 会话覆盖的日期 (开始那天到现在，可能跨过午夜) 落在请求范围内时再加上
+// 当前分钟 (进行中会话的时长随时间增长)。时间取自 ActivityLogger 的 Clock。
+// 轮询客户端带 If-None-Match 请求时，数据未变直接回 304，不查询数据库。
+//
+// 大范围响应按天生成，每次套接字发送缓冲区低于阈值时才生成下一天，
+// 不会一次性把整段历史读进内存，也不会长时间阻塞事件循环。
+//
+// 设置保存在 QSettings("TraeAI", "DeskCare") 的 Http/enabled 与 Http/port。
+// ========================================================================
+class HistoryHttpServer : public QObject {
+    Q_OBJECT
+
+    Q_PROPERTY(bool enabled READ isEnabled WRITE setEnabled NOTIFY enabledChanged)
+    Q_PROPERTY(int port READ port WRITE setPort NOTIFY portChanged)
+    Q_PROPERTY(bool listening READ isListening NOTIFY listeningChanged)
+    Q_PROPERTY(QString url READ url NOTIFY listeningChanged)
+
+public:
+    explicit HistoryHttpServer(ActivityLogger *logger, QObject *parent = nullptr);
+    ~HistoryHttpServer();
+
+    bool isEnabled() const { return m_enabled; }
+    void setEnabled(bool enabled);
+
+    int port() const { return m_port; }
+    void setPort(int port);
+
+    bool isListening() const;
+    QString url() const;
+
+signals:
+    void enabledChanged();
+    void portChanged();
+    void listeningChanged();
+
+private slots:
+    void onNewConnection();
+
+private:
+    // 每个连接的状态 (HTTP/1.1 keep-alive，请求按顺序处理)
+    struct Connection {
+        QByteArray buffer;   // 未处理的请求数据
+        bool keepAlive = true;
+        // 进行中的分块响应 (/api/range)
+        bool streaming = false;
+        bool firstDay = true;
+        QDate nextDate;
+        QDate lastDate;
+    };
+
+    void restart();
+    void onReadyRead(QTcpSocket *socket);
+    // 处理缓冲区中完整的请求，直到遇到流式响应或数据不足
+    void processRequests(QTcpSocket *socket);
+    void handleRequest(QTcpSocket *socket, const QByteArray &target,
+                       const QHash<QByteArray, QByteArray> &headers);
+    // 在发送缓冲区允许时继续输出分块响应
+    void pumpStream(QTcpSocket *socket);
+
+    // 请求的时间范围 [from, to] 对应的 ETag
+    QByteArray etagFor(const QDate &from, const QDate &to) const;
+    bool hostAllowed(const QByteArray &host) const;
+
+    void writeResponse(QTcpSocket *socket, int status, const QByteArray &contentType,
+                       const QByteArray &body, const QByteArray &etag = QByteArray());
+    void writeHead(QTcpSocket *socket, int status, const QByteArray &contentType,
+                   const QByteArray &etag, qint64 contentLength);
+    static void writeChunk(QTcpSocket *socket, const QByteArray &data);
+
+    static const int STREAM_LOW_WATER_BYTES = 64 * 1024;
+    static const int MAX_HEADER_BYTES = 16 * 1024;
+    static const int MAX_RANGE_DAYS = 3660;
+
+    ActivityLogger *m_logger;
+    QByteArray m_etagPrefix;  // 每个进程不同
+    QTcpServer *m_server;
+    QHash<QTcpSocket *, Connection> m_connections;
+    bool m_enabled = false;
+    int m_port = 17345;
+};
@@ -0,0 +1,271 @@
+#include "InputTrace.h"
+#include "Clock.h"
+#include "TimerEngine.h"
+#include "ActivityLogger.h"
+#include "MemoryActivityStore.h"
+#include "Calendar.h"
+#include "Logging.h"
+#include <QtEndian>
+#include <cstring>
+#include <climits>
+
+static const char kTraceMagic[4] = { 'D', 'C', 'T', 'R' };
+
+// ========================================================================
+// varint 编解码 (LEB128)，有符号数先做 zigzag 变换
+// ========================================================================
+
+static void appendVarint(QByteArray* out, quint64 value) {
+    while (value >= 0x80) {
+        out->append(char((value & 0x7F) | 0x80));
+        value >>= 7;
+    }
+    out->append(char(value));
+}
+
+static bool readVarint(const QByteArray& data, int* pos, quint64* value) {
+    quint64 result = 0;
+    for (int shift = 0; shift < 64; shift += 7) {
+        if (*pos >= data.size()) return false;
+        const quint8 byte = quint8(data.at((*pos)++));
+        result |= quint64(byte & 0x7F) << shift;
+        if (!(byte & 0x80)) {
+            *value = result;
+            return true;
+        }
+    }
+    return false;
+}
+
+static quint64 zigzag(qint64 v) { return (quint64(v) << 1) ^ quint64(v >> 63); }
+static qint64 unzigzag(quint64 v) { return qint64(v >> 1) ^ -qint64(v & 1); }
+
+// ========================================================================
+// InputTrace
+// ========================================================================
+
+bool InputTrace::hasArgument(EventType type) {
+    return type == RecordExercise || type == SetWorkDuration || type == ClockSync || type == MeetingDeferred;
+}
+
+QString InputTrace::typeName(EventType type) {
+    switch (type) {
+        case StartWork: return "startWork";
+        case Snooze: return "snooze";
+        case TogglePause: return "togglePause";
+        case Stop: return "stop";
+        case StartNap: return "startNap";
+        case StopNap: return "stopNap";
+        case RecordExercise: return "recordExercise";
+        case SetWorkDuration: return "setWorkDuration";
+        case SystemLock: return "lock";
+        case SystemUnlock: return "unlock";
+        case ClockSync: return "clockSync";
+        case MeetingDeferred: return "meetingDeferred";
+        case End: return "end";
+    }
+    return "unknown";
+}
+
+bool InputTrace::read(const QString& path, Header* header, QVector<Event>* events) {
+    QFile file(path);
+    if (!file.open(QIODevice::ReadOnly)) {
+        qCWarning(lcEngine) << "InputTrace: cannot open" << path << file.errorString();
+        return false;
+    }
+
+    const QByteArray data = file.readAll();
+    const quint8 version = data.size() >= HEADER_SIZE ? quint8(data.at(4)) : 0;
+    if (data.size() < HEADER_SIZE || std::memcmp(data.constData(), kTraceMagic, 4) != 0
+        || version < 1 || version > VERSION) {
+        qCWarning(lcEngine) << "InputTrace: not a trace file" << path;
+        return false;
+    }
+    *header = Header();
+    header->startWall = QDateTime::fromMSecsSinceEpoch(qFromLittleEndian<qint64>(data.constData() + 8));
+    if (version >= 2) {
+        header->engineState = quint8(data.at(5));
+        header->workDurationSecs = qFromLittleEndian<qint32>(data.constData() + 16);
+        header->remainingMs = qFromLittleEndian<qint32>(data.constData() + 20);
+    }
+
+    events->clear();
+    qint64 time = 0;
+    int pos = HEADER_SIZE;
+    while (pos < data.size()) {
+        Event event;
+        event.type = EventType(quint8(data.at(pos++)));
+
+        quint64 delta = 0;
+        if (!readVarint(data, &pos, &delta)) break; // 写到一半被中断
+        time += qint64(delta);
+        event.monotonicMs = time;
+
+        if (hasArgument(event.type)) {
+            quint64 raw = 0;
+            if (!readVarint(data, &pos, &raw)) break;
+            event.arg = unzigzag(raw);
+        }
+        events->append(event);
+    }
+    return true;
+}
+
+// ========================================================================
+// InputTraceRecorder
+// ========================================================================
+
+InputTraceRecorder::InputTraceRecorder(const QString& path, Clock* clock)
+    : m_file(path), m_clock(clock)
+{
+}
+
+InputTraceRecorder::~InputTraceRecorder() {
+    if (m_file.isOpen()) {
+        record(InputTrace::End);
+        m_file.close();
+    }
+}
+
+bool InputTraceRecorder::open(const TimerEngine* engine) {
+    if (!m_file.open(QIODevice::WriteOnly | QIODevice::Truncate)) {
+        qCWarning(lcEngine) << "InputTrace: cannot create" << m_file.fileName() << m_file.errorString();
+        return false;
+    }
+
+    m_startMonotonicMs = m_clock->monotonicMs();
+    m_startWallMs = m_clock->now().toMSecsSinceEpoch();
+
+    char header[InputTrace::HEADER_SIZE] = {};
+    std::memcpy(header, kTraceMagic, 4);
+    header[4] = char(InputTrace::VERSION);
+    header[5] = char(engine->engineState());
+    qToLittleEndian<qint64>(m_startWallMs, header + 8);
+    qToLittleEndian<qint32>(engine->workDurationMinutes() * 60, header + 16);
+    qToLittleEndian<qint32>(qint32(qMin<qint64>(engine->remainingMs(), INT_MAX)), header + 20);
+    m_file.write(header, InputTrace::HEADER_SIZE);
+    m_file.flush();
+
+    qCDebug(lcEngine) << "Recording input trace to" << m_file.fileName();
+    return true;
+}
+
+void InputTraceRecorder::record(InputTrace::EventType type, qint64 arg) {
+    if (!m_file.isOpen()) return;
+
+    // 墙钟与单调时钟的对应关系变化时 (改时间、时区、睡眠差异) 补一条时钟读数
+    const qint64 now = m_clock->monotonicMs() - m_startMonotonicMs;
+    const qint64 wallOffset = m_clock->now().toMSecsSinceEpoch() - (m_startWallMs + now);
+    if (qAbs(wallOffset - m_wallOffsetMs) > 1000) {
+        m_wallOffsetMs = wallOffset;
+        writeEvent(InputTrace::ClockSync, wallOffset);
+    }
+    writeEvent(type, arg);
+}
+
+void InputTraceRecorder::writeEvent(InputTrace::EventType type, qint64 arg) {
+    const qint64 now = qMax(m_lastMs, m_clock->monotonicMs() - m_startMonotonicMs);
+
+    QByteArray event;
+    event.append(char(type));
+    appendVarint(&event, quint64(now - m_lastMs));
+    if (InputTrace::hasArgument(type)) appendVarint(&event, zigzag(arg));
+    m_lastMs = now;
+
+    // 事件很少 (人工操作频率)，逐条落盘以便崩溃后仍可回放
+    m_file.write(event);
+    m_file.flush();
+}
+
+// ========================================================================
+// InputTraceReplayer
+// ========================================================================
+
+bool InputTraceReplayer::replay(const QString& path, Result* result) {
+    InputTrace::Header header;
+    QVector<InputTrace::Event> events;
+    if (!InputTrace::read(path, &header, &events)) return false;
+
+    // 录制时发生的会议顺延还原为忙碌时段：[顺延时刻, 顺延时刻 + 时长)，
+    // 墙钟按与回放相同的方式推算，引擎到期时会在同一时刻自行顺延。
+    // 引擎在推进到事件时刻的途中到期，同一时刻的 ClockSync 此时尚未生效
+    QVector<BusyInterval> meetings;
+    qint64 offset = 0;
+    qint64 syncOffset = 0;
+    qint64 syncAtMs = -1;
+    for (const InputTrace::Event& event : qAsConst(events)) {
+        if (syncAtMs >= 0 && syncAtMs < event.monotonicMs) offset = syncOffset;
+        if (event.type == InputTrace::ClockSync) {
+            syncOffset = event.arg;
+            syncAtMs = event.monotonicMs;
+        }
+        if (event.type != InputTrace::MeetingDeferred) continue;
+        BusyInterval interval;
+        interval.startMs = header.startWall.toMSecsSinceEpoch() + event.monotonicMs + offset;
+        interval.endMs = interval.startMs + event.arg;
+        meetings.append(interval);
+    }
+    CalendarIndex calendar;
+    calendar.rebuild(meetings);
+
+    VirtualClock clock(header.startWall);
+    TimerEngine engine(&clock);
+    engine.setPersistStats(false);
+    engine.setCalendar(&calendar);
+    if (header.engineState >= 0) {
+        engine.restoreState(TimerEngine::EngineState(header.engineState), header.workDurationSecs, header.remainingMs);
+    }
+    ActivityLogger logger(&engine, new MemoryActivityStore());
+
+    *result = Result();
+    QObject::connect(&engine, &TimerEngine::reminderTriggered, [result]() { result->reminders++; });
+    QObject::connect(&engine, &TimerEngine::reminderDeferred, [result]() { result->deferrals++; });
+
+    qint64 wallOffset = 0;
+    for (const InputTrace::Event& event : qAsConst(events)) {
+        // 推进到事件时刻，期间到期的定时器按顺序触发
+        clock.advance(event.monotonicMs - clock.monotonicMs());
+        result->events++;
+
+        switch (event.type) {
+            case InputTrace::StartWork: engine.startWork(); break;
+            case InputTrace::Snooze: engine.snooze(); break;
+            case InputTrace::TogglePause: engine.togglePause(); break;
+            case InputTrace::Stop: engine.stop(); break;
+            case InputTrace::StartNap: engine.startNap(); break;
+            case InputTrace::StopNap: engine.stopNap(); break;
+            case InputTrace::RecordExercise: engine.recordExercise(int(event.arg)); break;
+            case InputTrace::SetWorkDuration: engine.setWorkDurationMinutes(int(event.arg)); break;
+            case InputTrace::SystemLock: engine.handleSystemLock(true); break;
+            case InputTrace::SystemUnlock: engine.handleSystemLock(false); break;
+            case InputTrace::ClockSync:
+                clock.adjustWallTime(event.arg - wallOffset);
+                wallOffset = event.arg;
+                break;
+            case InputTrace::MeetingDeferred: break; // 已还原为忙碌时段，由引擎自行顺延
+            case InputTrace::End: break;
+            default:
+                qCWarning(lcEngine) << "InputTrace: unknown event type" << int(event.type);
+                break;
+        }
+    }
+
+    result->simulatedMs = clock.monotonicMs();
+    result->records = logger.store()->scan(ActivityQuery());
+    return true;
+}
+
+QString InputTraceReplayer::format(const Result& result) {
+    QString text;
+    text += QString("events=%1 simulated=%2s reminders=%3 deferrals=%4 records=%5\n")
+                .arg(result.events).arg(result.simulatedMs / 1000).arg(result.reminders)
+                .arg(result.deferrals).arg(result.records.size());
+    for (const ActivityRecord& record : result.records) {
+        text += QString("%1\t%2\t%3\t%4\n")
+                    .arg(record.state)
+                    .arg(QDateTime::fromSecsSinceEpoch(record.startTime).toString(Qt::ISODate))
+                    .arg(QDateTime::fromSecsSinceEpoch(record.endTime).toString(Qt::ISODate))
+                    .arg(record.duration);
+    }
+    return text;
+}
@@ -0,0 +1,117 @@
+#pragma once
+
+#include <QFile>
+#include <QString>
+#include <QVector>
+#include <QDateTime>
+#include "ActivityStore.h"
+
+class Clock;
+class TimerEngine;
+
+// ========================================================================
+// InputTrace：核心输入事件的录制与回放
+// ========================================================================
+// 作用：现场问题 (例如手动运动记录导致 Rest 重复、奇怪的锁屏/解锁顺序)
+// 难以复现。开启录制后 (--record-trace=<文件>)，TimerEngine 收到的每个
+// 外部输入都会连同时钟读数写入一个紧凑的二进制文件；回放时
+// (--replay-trace=<文件>) 用 VirtualClock 驱动全新的 TimerEngine 与
+// ActivityLogger 全速重演，结果完全确定。回放只依赖 trace 文件本身：
+// 录制开始时的引擎状态写在头部，日历导致的提醒顺延也作为事件录下。
+//
+// 文件格式 (小端)：
+//   头部 24 字节: "DCTR" | version(u8) | engineState(u8) | reserved(u8 x2) | startWallMs(i64)
+//                 | workDurationSecs(i32) | remainingMs(i32)
+//   事件: type(u8) | deltaMs(varint，距上一事件的单调时间) | [参数(zigzag varint)]
+// 只有当墙钟与单调时钟的对应关系变化超过 1 秒 (手动改时间、睡眠) 时，
+// 才额外写入一条 ClockSync 事件。版本 1 的头部没有引擎状态，按引擎默认值回放。
+// ========================================================================
+class InputTrace
+{
+public:
+    enum EventType : quint8 {
+        StartWork = 1,
+        Snooze,
+        TogglePause,
+        Stop,
+        StartNap,
+        StopNap,
+        RecordExercise,      // 参数：时长 (秒)
+        SetWorkDuration,     // 参数：分钟
+        SystemLock,
+        SystemUnlock,
+        ClockSync,           // 参数：墙钟相对单调时钟推算值的偏移 (毫秒)
+        MeetingDeferred,     // 参数：倒计时因会议顺延的时长 (毫秒)
+        End = 0xFF           // 录制结束 (回放时推进到该时刻)
+    };
+
+    struct Event {
+        EventType type = End;
+        qint64 monotonicMs = 0; // 相对录制开始的单调时间
+        qint64 arg = 0;
+    };
+
+    // 录制开始时的引擎状态
+    struct Header {
+        QDateTime startWall;
+        int engineState = -1;      // TimerEngine::EngineState，-1 表示未记录 (版本 1)
+        int workDurationSecs = 0;
+        qint64 remainingMs = 0;
+    };
+
+    static bool hasArgument(EventType type);
+    static QString typeName(EventType type);
+
+    // 读取整个 trace 文件
+    static bool read(const QString& path, Header* header, QVector<Event>* events);
+
+    static const quint8 VERSION = 2;
+    static const int HEADER_SIZE = 24;
+};
+
+// ========================================================================
+// InputTraceRecorder：录制器 (挂在 TimerEngine 上)
+// ========================================================================
+class InputTraceRecorder
+{
+public:
+    InputTraceRecorder(const QString& path, Clock* clock);
+    ~InputTraceRecorder(); // 写入 End 事件
+
+    // 写入头部 (记下 engine 当前的状态、工作时长与剩余时间)
+    bool open(const TimerEngine* engine);
+    bool isOpen() const { return m_file.isOpen(); }
+
+    void record(InputTrace::EventType type, qint64 arg = 0);
+
+private:
+    void writeEvent(InputTrace::EventType type, qint64 arg);
+
+    QFile m_file;
+    Clock* m_clock;
+    qint64 m_startMonotonicMs = 0;
+    qint64 m_startWallMs = 0;
+    qint64 m_lastMs = 0;       // 上一事件的单调时间 (相对开始)
+    qint64 m_wallOffsetMs = 0; // 已记录的墙钟偏移
+};
+
+// ========================================================================
+// InputTraceReplayer：回放器
+// ========================================================================
+class InputTraceReplayer
+{
+public:
+    struct Result {
+        int events = 0;
+        qint64 simulatedMs = 0;          // 回放覆盖的时间跨度
+        int reminders = 0;               // 期间触发的运动提醒次数
+        int deferrals = 0;               // 其中因会议顺延的次数
+        QVector<ActivityRecord> records; // 回放产生的活动记录 (按开始时间)
+    };
+
+    // 用全新的引擎与内存存储回放，失败时返回 false
+    static bool replay(const QString& path, Result* result);
+
+    // 以文本形式输出结果 (每行一条记录)，便于两次回放之间 diff
+    static QString format(const Result& result);
+};
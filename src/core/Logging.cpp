@@ -0,0 +1,418 @@
+#include "Logging.h"
+#include "Metrics.h"
+#include <QCoreApplication>
+#include <QDateTime>
+#include <QDir>
+#include <QThread>
+#include <QDebug>
+#include <cstring>
+
+#ifdef Q_OS_WIN
+#include <windows.h>
+#include <csignal>
+#else
+#include <csignal>
+#include <fcntl.h>
+#include <unistd.h>
+#endif
+
+// Release 构建默认不输出 debug 级别
+#ifdef QT_NO_DEBUG
+#define DESKCARE_LOG_LEVEL QtInfoMsg
+#else
+#define DESKCARE_LOG_LEVEL QtDebugMsg
+#endif
+
+Q_LOGGING_CATEGORY(lcEngine, "deskcare.engine", DESKCARE_LOG_LEVEL)
+Q_LOGGING_CATEGORY(lcDb, "deskcare.db", DESKCARE_LOG_LEVEL)
+Q_LOGGING_CATEGORY(lcUpdate, "deskcare.update", DESKCARE_LOG_LEVEL)
+Q_LOGGING_CATEGORY(lcUi, "deskcare.ui", DESKCARE_LOG_LEVEL)
+
+static const qint64 kMaxFileBytes = 1024 * 1024;
+static const int kRotatedFiles = 2; // deskcare.1.log、deskcare.2.log
+
+static char levelChar(QtMsgType type) {
+    switch (type) {
+    case QtDebugMsg: return 'D';
+    case QtInfoMsg: return 'I';
+    case QtWarningMsg: return 'W';
+    case QtCriticalMsg: return 'C';
+    case QtFatalMsg: return 'F';
+    }
+    return '?';
+}
+
+// ========================================================================
+// 崩溃记录 (只使用系统调用)
+// ========================================================================
+// 路径在 start() 时准备好；崩溃时不能分配内存，也不能假设 Qt 仍可用。
+
+namespace {
+
+char s_crashPath[1024];
+#ifdef Q_OS_WIN
+wchar_t s_crashPathW[1024];
+#endif
+std::atomic<bool> s_crashDumped{false};
+
+class CrashWriter {
+public:
+    bool open() {
+#ifdef Q_OS_WIN
+        m_handle = CreateFileW(s_crashPathW, FILE_APPEND_DATA, FILE_SHARE_READ, nullptr, OPEN_ALWAYS,
+                               FILE_ATTRIBUTE_NORMAL, nullptr);
+        return m_handle != INVALID_HANDLE_VALUE;
+#else
+        m_fd = ::open(s_crashPath, O_WRONLY | O_CREAT | O_APPEND, 0644);
+        return m_fd >= 0;
+#endif
+    }
+
+    ~CrashWriter() {
+        flush();
+#ifdef Q_OS_WIN
+        if (m_handle != INVALID_HANDLE_VALUE) CloseHandle(m_handle);
+#else
+        if (m_fd >= 0) ::close(m_fd);
+#endif
+    }
+
+    void append(const char *data, size_t size) {
+        while (size > 0) {
+            if (m_used == sizeof(m_buffer)) flush();
+            const size_t n = qMin(size, sizeof(m_buffer) - m_used);
+            memcpy(m_buffer + m_used, data, n);
+            m_used += n;
+            data += n;
+            size -= n;
+        }
+    }
+    void append(const char *text) { append(text, strlen(text)); }
+
+    // 定宽十进制 (左侧补零)
+    void number(quint64 value, int width) {
+        char digits[20];
+        int n = 0;
+        do {
+            digits[n++] = char('0' + value % 10);
+            value /= 10;
+        } while (value && n < 20);
+        while (n < width && n < 20) digits[n++] = '0';
+        while (n > 0) append(&digits[--n], 1);
+    }
+
+private:
+    void flush() {
+        if (m_used == 0) return;
+#ifdef Q_OS_WIN
+        DWORD written = 0;
+        if (m_handle != INVALID_HANDLE_VALUE) WriteFile(m_handle, m_buffer, DWORD(m_used), &written, nullptr);
+#else
+        if (m_fd >= 0) {
+            const ssize_t written = ::write(m_fd, m_buffer, m_used);
+            (void)written;
+        }
+#endif
+        m_used = 0;
+    }
+
+    char m_buffer[4096];
+    size_t m_used = 0;
+#ifdef Q_OS_WIN
+    HANDLE m_handle = INVALID_HANDLE_VALUE;
+#else
+    int m_fd = -1;
+#endif
+};
+
+#ifdef Q_OS_WIN
+LONG WINAPI onUnhandledException(EXCEPTION_POINTERS *info) {
+    char reason[] = "exception 0x00000000";
+    DWORD code = info && info->ExceptionRecord ? info->ExceptionRecord->ExceptionCode : 0;
+    for (int i = int(sizeof(reason)) - 2; i >= 12; --i, code >>= 4) reason[i] = "0123456789ABCDEF"[code & 0xF];
+    LogSink::dumpCrash(reason);
+    return EXCEPTION_CONTINUE_SEARCH;
+}
+
+void onAbortSignal(int) {
+    // CRT 调用处理函数前已恢复默认处理，返回后 abort() 照常结束进程
+    LogSink::dumpCrash("SIGABRT");
+}
+
+void installCrashHandlers() {
+    SetUnhandledExceptionFilter(onUnhandledException);
+    signal(SIGABRT, onAbortSignal);
+}
+#else
+void onCrashSignal(int sig) {
+    const char *name = sig == SIGSEGV ? "SIGSEGV"
+                     : sig == SIGABRT ? "SIGABRT"
+                     : sig == SIGBUS ? "SIGBUS"
+                     : sig == SIGFPE ? "SIGFPE"
+                     : sig == SIGILL ? "SIGILL" : "signal";
+    LogSink::dumpCrash(name);
+    // SA_RESETHAND 已恢复默认处理，重新发出信号以正常终止 (生成 core dump)
+    raise(sig);
+}
+
+void installCrashHandlers() {
+    // 栈溢出时原栈不可用，在备用栈上运行处理函数 (只对主线程生效)
+    static char s_altStack[64 * 1024];
+    stack_t stack = {};
+    stack.ss_sp = s_altStack;
+    stack.ss_size = sizeof(s_altStack);
+    sigaltstack(&stack, nullptr);
+
+    struct sigaction action = {};
+    action.sa_handler = onCrashSignal;
+    sigemptyset(&action.sa_mask);
+    action.sa_flags = SA_RESETHAND | SA_ONSTACK;
+    for (int sig : { SIGSEGV, SIGABRT, SIGBUS, SIGFPE, SIGILL }) sigaction(sig, &action, nullptr);
+}
+#endif
+
+} // namespace
+
+void LogSink::dumpCrash(const char *reason) {
+    if (s_crashDumped.exchange(true) || !s_crashPath[0]) return;
+    LogSink *sink = instance();
+
+    CrashWriter out;
+    if (!out.open()) return;
+    out.append("==== DeskCare crashed: ");
+    out.append(reason);
+    out.append(" (last messages, UTC) ====\n");
+
+    // 最近的槽位：已写入未取走 (序号 pos+1) 或已写入文件但尚未复用 (序号 pos+CAPACITY)；
+    // 正在写入的跳过
+    const quint64 end = sink->m_enqueuePos.load();
+    const quint64 begin = end > quint64(CRASH_ENTRIES) ? end - CRASH_ENTRIES : 0;
+    for (quint64 pos = begin; pos < end; ++pos) {
+        const Entry &entry = sink->m_entries[pos & (CAPACITY - 1)];
+        const quint64 sequence = entry.sequence.load(std::memory_order_acquire);
+        if (sequence != pos + 1 && sequence != pos + CAPACITY) continue;
+
+        const quint64 msOfDay = quint64(entry.msecsSinceEpoch) % (24 * 3600 * 1000);
+        out.number(msOfDay / 3600000, 2);
+        out.append(":", 1);
+        out.number(msOfDay / 60000 % 60, 2);
+        out.append(":", 1);
+        out.number(msOfDay / 1000 % 60, 2);
+        out.append(".", 1);
+        out.number(msOfDay % 1000, 3);
+        const char level[] = { ' ', entry.level, ' ' };
+        out.append(level, sizeof(level));
+        out.append(entry.text, qMin<size_t>(entry.length, TEXT_BYTES));
+        out.append("\n", 1);
+    }
+    out.append("\n", 1);
+}
+
+// ========================================================================
+// LogSink
+// ========================================================================
+
+LogSink *LogSink::instance() {
+    // 静态存储：崩溃时与进程退出阶段都可以访问
+    static LogSink s_sink;
+    return &s_sink;
+}
+
+LogSink::LogSink() {
+    // 有界队列 (Vyukov)：槽位 i 的初始序号为 i，表示可供第 i 条消息写入
+    for (int i = 0; i < CAPACITY; ++i) m_entries[i].sequence.store(quint64(i), std::memory_order_relaxed);
+}
+
+bool LogSink::start(const QString &directory) {
+    if (m_thread) return true;
+
+    const QDir dir(directory);
+    if (!QDir().mkpath(directory)) {
+        qWarning() << "LogSink: cannot create log directory" << directory;
+        return false;
+    }
+    m_file.setFileName(dir.filePath("deskcare.log"));
+    if (!m_file.open(QIODevice::WriteOnly | QIODevice::Append | QIODevice::Text)) {
+        qWarning() << "LogSink: cannot open" << m_file.fileName() << m_file.errorString();
+        return false;
+    }
+
+    const QString crashPath = QDir::toNativeSeparators(dir.filePath("crash.log"));
+    qstrncpy(s_crashPath, QFile::encodeName(crashPath).constData(), sizeof(s_crashPath));
+#ifdef Q_OS_WIN
+    const int length = crashPath.toWCharArray(s_crashPathW);
+    s_crashPathW[qMin(length, int(sizeof(s_crashPathW) / sizeof(wchar_t)) - 1)] = 0;
+#endif
+    installCrashHandlers();
+
+    m_droppedCounter = Metrics::instance()->counter("log.dropped");
+    m_stopping = false;
+    m_thread = QThread::create([this]() { drainLoop(); });
+    m_thread->setObjectName("LogSink");
+    m_thread->start(QThread::LowPriority);
+
+    m_previousHandler = qInstallMessageHandler(messageHandler);
+
+    static bool s_postRoutineAdded = false;
+    if (!s_postRoutineAdded) {
+        qAddPostRoutine([]() { LogSink::instance()->stop(); });
+        s_postRoutineAdded = true;
+    }
+    return true;
+}
+
+void LogSink::stop() {
+    if (!m_thread) return;
+    qInstallMessageHandler(m_previousHandler);
+
+    {
+        QMutexLocker locker(&m_wakeMutex);
+        m_stopping = true;
+        m_wake.wakeOne();
+    }
+    m_thread->wait();
+    delete m_thread;
+    m_thread = nullptr;
+
+    // 后台线程结束后可能还有最后几条 (消息处理函数恢复之前写入的)
+    const QByteArray rest = takePending();
+    if (!rest.isEmpty()) writeToFile(rest);
+    m_file.close();
+}
+
+// ========================================================================
+// 记录路径 (任意线程)
+// ========================================================================
+
+void LogSink::messageHandler(QtMsgType type, const QMessageLogContext &context, const QString &message) {
+    LogSink *sink = instance();
+    if (sink->enqueue(type, context.category, message)) {
+        // 只有后台线程在等待时才需要加锁唤醒
+        if (sink->m_drainerIdle.load()) {
+            QMutexLocker locker(&sink->m_wakeMutex);
+            sink->m_wake.wakeOne();
+        }
+    } else {
+        sink->m_dropped.fetch_add(1, std::memory_order_relaxed);
+        if (sink->m_droppedCounter) sink->m_droppedCounter->add();
+    }
+
+    // qFatal 之后进程就会结束，来不及等后台线程
+    if (type == QtFatalMsg) dumpCrash("qFatal");
+    if (sink->m_previousHandler) sink->m_previousHandler(type, context, message);
+}
+
+bool LogSink::enqueue(QtMsgType type, const char *category, const QString &message) {
+    const QByteArray utf8 = message.toUtf8();
+
+    quint64 pos = m_enqueuePos.load(std::memory_order_relaxed);
+    Entry *entry;
+    for (;;) {
+        entry = &m_entries[pos & (CAPACITY - 1)];
+        const qint64 diff = qint64(entry->sequence.load(std::memory_order_acquire)) - qint64(pos);
+        if (diff == 0) {
+            if (m_enqueuePos.compare_exchange_weak(pos, pos + 1, std::memory_order_relaxed)) break;
+        } else if (diff < 0) {
+            return false; // 满了：后台线程还没有取走上一轮的消息
+        } else {
+            pos = m_enqueuePos.load(std::memory_order_relaxed);
+        }
+    }
+
+    entry->msecsSinceEpoch = QDateTime::currentMSecsSinceEpoch();
+    entry->level = levelChar(type);
+    size_t length = 0;
+    const auto appendText = [&](const char *data, size_t size) {
+        size = qMin(size, size_t(TEXT_BYTES) - length);
+        memcpy(entry->text + length, data, size);
+        length += size;
+    };
+    if (category && qstrcmp(category, "default") != 0) {
+        appendText(category, strlen(category));
+        appendText(": ", 2);
+    }
+    appendText(utf8.constData(), size_t(utf8.size()));
+    // 截断时不留半个 UTF-8 字符
+    if (length == size_t(TEXT_BYTES)) {
+        while (length > 0 && (uchar(entry->text[length - 1]) & 0xC0) == 0x80) --length;
+        if (length > 0 && uchar(entry->text[length - 1]) >= 0xC0) --length;
+    }
+    entry->length = quint16(length);
+
+    // 顺序一致：与后台线程的 m_drainerIdle / hasPending() 配对，不会漏掉唤醒
+    entry->sequence.store(pos + 1);
+    return true;
+}
+
+// ========================================================================
+// 后台线程
+// ========================================================================
+
+bool LogSink::hasPending() const {
+    return m_entries[m_dequeuePos & (CAPACITY - 1)].sequence.load() == m_dequeuePos + 1;
+}
+
+QByteArray LogSink::takePending() {
+    QByteArray lines;
+    for (;;) {
+        Entry &entry = m_entries[m_dequeuePos & (CAPACITY - 1)];
+        if (entry.sequence.load(std::memory_order_acquire) != m_dequeuePos + 1) break;
+
+        lines += QDateTime::fromMSecsSinceEpoch(entry.msecsSinceEpoch).toString("yyyy-MM-dd HH:mm:ss.zzz").toLatin1();
+        lines += ' ';
+        lines += entry.level;
+        lines += ' ';
+        lines.append(entry.text, entry.length);
+        lines += '\n';
+
+        // 释放给下一轮写入；内容保留到被覆盖，供崩溃记录使用
+        entry.sequence.store(m_dequeuePos + CAPACITY, std::memory_order_release);
+        ++m_dequeuePos;
+    }
+
+    const quint64 dropped = m_dropped.exchange(0);
+    if (dropped) {
+        lines += QDateTime::currentDateTime().toString("yyyy-MM-dd HH:mm:ss.zzz").toLatin1()
+                 + " W " + QByteArray::number(dropped) + " messages dropped (log buffer full)\n";
+    }
+    return lines;
+}
+
+void LogSink::drainLoop() {
+    for (;;) {
+        const QByteArray lines = takePending();
+        if (!lines.isEmpty()) {
+            writeToFile(lines);
+            continue;
+        }
+
+        QMutexLocker locker(&m_wakeMutex);
+        if (m_stopping) return;
+        m_drainerIdle.store(true);
+        if (!hasPending()) m_wake.wait(&m_wakeMutex);
+        m_drainerIdle.store(false);
+    }
+}
+
+void LogSink::writeToFile(const QByteArray &lines) {
+    // 文件不可用时直接丢弃 (这里的警告也会进入日志，不能形成循环)
+    if (!m_file.isOpen()) return;
+    m_file.write(lines);
+    m_file.flush();
+    if (m_file.size() > kMaxFileBytes) rotate();
+}
+
+void LogSink::rotate() {
+    const QString path = m_file.fileName();
+    const QString base = path.left(path.size() - 4); // 去掉 ".log"
+    m_file.close();
+
+    QFile::remove(QString("%1.%2.log").arg(base).arg(kRotatedFiles));
+    for (int i = kRotatedFiles - 1; i >= 1; --i) {
+        QFile::rename(QString("%1.%2.log").arg(base).arg(i), QString("%1.%2.log").arg(base).arg(i + 1));
+    }
+    QFile::rename(path, base + ".1.log");
+
+    m_file.setFileName(path);
+    m_file.open(QIODevice::WriteOnly | QIODevice::Append | QIODevice::Text);
+}
@@ -0,0 +1,96 @@
+#pragma once
+#include <QLoggingCategory>
+#include <QMutex>
+#include <QWaitCondition>
+#include <QFile>
+#include <QString>
+#include <atomic>
+
+class QThread;
+class MetricCounter;
+
+// ========================================================================
+// 日志分类
+// ========================================================================
+// 用 qCDebug(lcEngine) << ... 代替 qDebug()：分类关闭时整条语句只是一次
+// isDebugEnabled() 判断，参数 (包括 JSON 序列化之类的开销) 不会被求值。
+// Release 构建默认只输出 info 及以上，Debug 构建全部输出；可以用环境变量
+// 临时打开，例如 QT_LOGGING_RULES="deskcare.db.debug=true"。
+//
+//   engine  计时引擎、提醒、日历、在场检测、输入录制
+//   db      活动记录与数据库 (会话写入、日志回放、归档)
+//   update  版本检查、下载更新、统计上报
+//   ui      界面、窗口工具、本地控制接口与 HTTP 接口、诊断工具
+Q_DECLARE_LOGGING_CATEGORY(lcEngine)
+Q_DECLARE_LOGGING_CATEGORY(lcDb)
+Q_DECLARE_LOGGING_CATEGORY(lcUpdate)
+Q_DECLARE_LOGGING_CATEGORY(lcUi)
+
+// ========================================================================
+// LogSink：日志文件输出 (进程级单例)
+// ========================================================================
+// start() 后接管 Qt 消息处理 (原处理函数照常调用，控制台/调试器输出不变)：
+// - 记录路径无锁：消息连同时间、级别写入固定大小的环形缓冲 (多生产者
+//   有界队列，每个槽位一个序号)，不做文件 IO；缓冲满时丢弃并计数
+//   (Metrics 计数器 log.dropped)。
+// - 后台线程把缓冲写入 <目录>/deskcare.log，超过 1 MB 轮转为
+//   deskcare.1.log / deskcare.2.log。后台线程空闲时阻塞等待，有新消息才唤醒。
+// - 崩溃 (SIGSEGV/SIGABRT 等、Windows 未处理异常) 或 qFatal 时，把环形
+//   缓冲中最近的消息 (包括已写入文件的) 追加到 <目录>/crash.log。崩溃
+//   处理只使用预先准备好的路径与系统调用，不分配内存、不调用 Qt。
+//
+// QCoreApplication 析构时自动 stop()，写完缓冲中剩余的消息。
+// ========================================================================
+class LogSink {
+public:
+    static LogSink *instance();
+
+    // 在 QCoreApplication 创建之后调用 (目录不存在时创建)，失败时返回 false
+    bool start(const QString &directory);
+    // 恢复原消息处理函数，写完剩余消息并结束后台线程
+    void stop();
+
+    bool isRunning() const { return m_thread != nullptr; }
+    QString filePath() const { return m_file.fileName(); }
+
+    static const int CAPACITY = 512;     // 环形缓冲槽位数 (2 的幂)
+    static const int TEXT_BYTES = 1000;  // 单条消息上限 (UTF-8 字节，超出截断)
+    static const int CRASH_ENTRIES = 200;// 崩溃时输出的最近消息条数
+
+    // 把最近的消息追加到 crash.log (只写一次)；只用系统调用，可在信号处理函数中调用
+    static void dumpCrash(const char *reason);
+
+private:
+    LogSink();
+
+    struct Entry {
+        std::atomic<quint64> sequence{0};
+        qint64 msecsSinceEpoch = 0;
+        char level = 0;
+        quint16 length = 0;
+        char text[TEXT_BYTES]; // "分类: 消息"
+    };
+
+    static void messageHandler(QtMsgType type, const QMessageLogContext &context, const QString &message);
+    bool enqueue(QtMsgType type, const char *category, const QString &message);
+    bool hasPending() const;
+    QByteArray takePending();
+    void drainLoop();
+    void writeToFile(const QByteArray &lines);
+    void rotate();
+
+    Entry m_entries[CAPACITY];
+    std::atomic<quint64> m_enqueuePos{0};
+    quint64 m_dequeuePos = 0; // 只由后台线程 (或 stop() 中线程结束后) 访问
+    std::atomic<quint64> m_dropped{0};
+    MetricCounter *m_droppedCounter = nullptr;
+
+    QThread *m_thread = nullptr;
+    QMutex m_wakeMutex;
+    QWaitCondition m_wake;
+    std::atomic<bool> m_drainerIdle{false};
+    bool m_stopping = false; // m_wakeMutex 保护
+
+    QFile m_file;
+    QtMessageHandler m_previousHandler = nullptr;
+};
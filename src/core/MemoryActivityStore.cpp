@@ -0,0 +1,113 @@
+#include "MemoryActivityStore.h"
+#include <algorithm>
+
+int MemoryActivityStore::appendSession(const ActivityRecord& record) {
+    ActivityRecord stored = record;
+    stored.id = m_nextId++;
+
+    // 会话几乎总是按时间顺序追加，从尾部插入代价为 O(1)
+    auto pos = std::upper_bound(m_records.begin(), m_records.end(), stored.startTime,
+                                [](qint64 ts, const ActivityRecord& r) { return ts < r.startTime; });
+    m_records.insert(pos, stored);
+    return stored.id;
+}
+
+int MemoryActivityStore::lowerBound(qint64 startTs) const {
+    auto it = std::lower_bound(m_records.begin(), m_records.end(), startTs,
+                               [](const ActivityRecord& r, qint64 ts) { return r.startTime < ts; });
+    return int(it - m_records.begin());
+}
+
+bool MemoryActivityStore::matches(const ActivityRecord& record, const ActivityQuery& query) {
+    if (!query.states.isEmpty() || query.includeOtherStates) {
+        bool known = record.state == "Focus" || record.state == "Rest" || record.state == "Nap" || record.state == "Pause";
+        bool stateMatch = query.states.contains(record.state) || (query.includeOtherStates && !known);
+        if (!stateMatch) return false;
+    }
+    if (query.minDuration >= 0 && record.duration <= query.minDuration) return false;
+    if (query.maxDuration >= 0 && record.duration > query.maxDuration) return false;
+    if (query.exactStartMs >= 0 && qAbs(record.startTime * 1000 - query.exactStartMs) >= 1000) return false;
+    if (query.hasContent && record.content.isEmpty()) return false;
+    return true;
+}
+
+QVector<ActivityRecord> MemoryActivityStore::scan(const ActivityQuery& query) {
+    QVector<ActivityRecord> result;
+    int i = query.startTs >= 0 ? lowerBound(query.startTs) : 0;
+    for (; i < m_records.size(); ++i) {
+        const ActivityRecord& record = m_records.at(i);
+        if (query.endTs >= 0 && record.startTime > query.endTs) break;
+        if (matches(record, query)) result.append(record);
+    }
+    return result;
+}
+
+QHash<QString, ActivityAggregate> MemoryActivityStore::aggregate(qint64 startTs, qint64 endTs, int longThreshold) {
+    QHash<QString, ActivityAggregate> result;
+    for (int i = lowerBound(startTs); i < m_records.size(); ++i) {
+        const ActivityRecord& record = m_records.at(i);
+        if (record.startTime > endTs) break;
+
+        ActivityAggregate& agg = result[record.state];
+        agg.totalSeconds += record.duration;
+        agg.count++;
+        if (record.duration > longThreshold) agg.longCount++;
+        if (record.duration > agg.maxSeconds) {
+            agg.maxSeconds = record.duration;
+            agg.maxStart = record.startTime;
+        }
+    }
+    return result;
+}
+
+bool MemoryActivityStore::updateContent(int id, const QString& content, int workType) {
+    for (ActivityRecord& record : m_records) {
+        if (record.id == id) {
+            record.content = content;
+            record.workType = workType;
+            return true;
+        }
+    }
+    return false;
+}
+
+bool MemoryActivityStore::appendAppUsage(qint64 sessionStart, const QVector<AppUsage>& usage) {
+    for (const AppUsage& entry : usage) m_appUsage.append(qMakePair(sessionStart, entry));
+    return true;
+}
+
+QVector<AppUsage> MemoryActivityStore::appUsage(qint64 startTs, qint64 endTs) {
+    QHash<QString, int> totals;
+    for (const auto& row : qAsConst(m_appUsage)) {
+        if (row.first < startTs || row.first > endTs) continue;
+        totals[row.second.app] += row.second.seconds;
+    }
+
+    QVector<AppUsage> result;
+    for (auto it = totals.constBegin(); it != totals.constEnd(); ++it) {
+        AppUsage entry;
+        entry.app = it.key();
+        entry.seconds = it.value();
+        result.append(entry);
+    }
+    std::sort(result.begin(), result.end(), [](const AppUsage& a, const AppUsage& b) {
+        return a.seconds > b.seconds || (a.seconds == b.seconds && a.app < b.app);
+    });
+    return result;
+}
+
+bool MemoryActivityStore::appendReminder(const ReminderRecord& record) {
+    m_reminders.append(record);
+    return true;
+}
+
+QVector<ReminderRecord> MemoryActivityStore::reminders(qint64 startTs, qint64 endTs) {
+    QVector<ReminderRecord> result;
+    for (const ReminderRecord& record : qAsConst(m_reminders)) {
+        if (record.startTime >= startTs && record.startTime <= endTs) result.append(record);
+    }
+    std::sort(result.begin(), result.end(), [](const ReminderRecord& a, const ReminderRecord& b) {
+        return a.startTime < b.startTime;
+    });
+    return result;
+}
@@ -0,0 +1,37 @@
+#pragma once
+
+#include "ActivityStore.h"
+
+// ========================================================================
+// MemoryActivityStore：纯内存实现
+// ========================================================================
+// 记录按 start_time 有序保存在连续数组中，范围扫描用二分查找定位起点。
+// 不做任何持久化，用于基准测试、模拟运行以及逻辑验证。
+// ========================================================================
+class MemoryActivityStore : public ActivityStore {
+public:
+    MemoryActivityStore() = default;
+
+    bool isOpen() const override { return true; }
+    int appendSession(const ActivityRecord& record) override;
+    QVector<ActivityRecord> scan(const ActivityQuery& query) override;
+    QHash<QString, ActivityAggregate> aggregate(qint64 startTs, qint64 endTs, int longThreshold) override;
+    bool updateContent(int id, const QString& content, int workType) override;
+    bool appendAppUsage(qint64 sessionStart, const QVector<AppUsage>& usage) override;
+    QVector<AppUsage> appUsage(qint64 startTs, qint64 endTs) override;
+    bool appendReminder(const ReminderRecord& record) override;
+    QVector<ReminderRecord> reminders(qint64 startTs, qint64 endTs) override;
+
+    int size() const { return m_records.size(); }
+    void clear() { m_records.clear(); m_appUsage.clear(); m_reminders.clear(); m_nextId = 1; }
+
+private:
+    // 返回第一条 start_time >= startTs 的下标
+    int lowerBound(qint64 startTs) const;
+    static bool matches(const ActivityRecord& record, const ActivityQuery& query);
+
+    QVector<ActivityRecord> m_records; // 按 startTime 升序
+    QVector<QPair<qint64, AppUsage>> m_appUsage; // (会话开始时间, 应用时长)
+    QVector<ReminderRecord> m_reminders; // 按写入顺序 (即结束时间) 保存
+    int m_nextId = 1;
+};
@@ -0,0 +1,161 @@
+#include "Metrics.h"
+#include <QMutexLocker>
+#include <QtAlgorithms>
+#include <QStringList>
+#include <algorithm>
+
+// ========================================================================
+// MetricHistogram
+// ========================================================================
+
+void MetricHistogram::record(qint64 micros) {
+    const quint64 value = micros > 0 ? quint64(micros) : 0;
+    // 0 -> 桶 0；[2^(i-1), 2^i) -> 桶 i
+    const int bucket = qMin(BUCKETS - 1, value ? 64 - int(qCountLeadingZeroBits(value)) : 0);
+    m_buckets[bucket].fetch_add(1, std::memory_order_relaxed);
+    m_count.fetch_add(1, std::memory_order_relaxed);
+    m_sum.fetch_add(value, std::memory_order_relaxed);
+
+    quint64 max = m_max.load(std::memory_order_relaxed);
+    while (value > max && !m_max.compare_exchange_weak(max, value, std::memory_order_relaxed)) {
+    }
+}
+
+double MetricHistogram::meanMicros() const {
+    const quint64 n = count();
+    return n ? double(m_sum.load(std::memory_order_relaxed)) / double(n) : 0.0;
+}
+
+quint64 MetricHistogram::percentileMicros(double p) const {
+    // 读取期间可能有并发写入，各桶之和与 count 不一定完全一致，以桶为准
+    quint64 counts[BUCKETS];
+    quint64 total = 0;
+    for (int i = 0; i < BUCKETS; ++i) {
+        counts[i] = m_buckets[i].load(std::memory_order_relaxed);
+        total += counts[i];
+    }
+    if (total == 0) return 0;
+
+    const quint64 rank = qMax<quint64>(1, quint64(p * double(total) + 0.5));
+    quint64 seen = 0;
+    for (int i = 0; i < BUCKETS; ++i) {
+        seen += counts[i];
+        if (seen >= rank) {
+            const quint64 upper = i == 0 ? 0 : (quint64(1) << i) - 1;
+            return qMin(upper, maxMicros());
+        }
+    }
+    return maxMicros();
+}
+
+// ========================================================================
+// Metrics
+// ========================================================================
+
+Metrics *Metrics::instance() {
+    // 不设父对象：随进程存在，热点路径缓存的指针始终有效
+    static Metrics *s_instance = new Metrics;
+    return s_instance;
+}
+
+Metrics::Metrics(QObject *parent) : QObject(parent) {
+    m_clock.start();
+}
+
+MetricCounter *Metrics::counter(const QString &name) {
+    QMutexLocker locker(&m_mutex);
+    MetricCounter *&slot = m_counters[name];
+    if (!slot) {
+        m_counterStorage.emplace_back(new MetricCounter);
+        slot = m_counterStorage.back().get();
+    }
+    return slot;
+}
+
+MetricHistogram *Metrics::histogram(const QString &name) {
+    QMutexLocker locker(&m_mutex);
+    MetricHistogram *&slot = m_histograms[name];
+    if (!slot) {
+        m_histogramStorage.emplace_back(new MetricHistogram);
+        slot = m_histogramStorage.back().get();
+    }
+    return slot;
+}
+
+void Metrics::markStart(const QString &name) {
+    QMutexLocker locker(&m_mutex);
+    m_marks.insert(name, m_clock.nsecsElapsed());
+}
+
+void Metrics::markEnd(const QString &name) {
+    qint64 startNs;
+    {
+        QMutexLocker locker(&m_mutex);
+        auto it = m_marks.find(name);
+        if (it == m_marks.end()) return;
+        startNs = it.value();
+        m_marks.erase(it);
+    }
+    histogram(name)->record((m_clock.nsecsElapsed() - startNs) / 1000);
+}
+
+static double toMs(double micros) {
+    return qRound(micros / 10.0) / 100.0; // 保留两位小数
+}
+
+QVariantList Metrics::snapshot() const {
+    QMutexLocker locker(&m_mutex);
+    QStringList names = m_counters.keys() + m_histograms.keys();
+    std::sort(names.begin(), names.end());
+
+    QVariantList list;
+    for (const QString &name : names) {
+        QVariantMap entry;
+        entry["name"] = name;
+        if (const MetricCounter *c = m_counters.value(name)) {
+            entry["type"] = "counter";
+            entry["value"] = c->value();
+        } else {
+            const MetricHistogram *h = m_histograms.value(name);
+            entry["type"] = "histogram";
+            entry["count"] = h->count();
+            entry["meanMs"] = toMs(h->meanMicros());
+            entry["p50Ms"] = toMs(h->percentileMicros(0.50));
+            entry["p90Ms"] = toMs(h->percentileMicros(0.90));
+            entry["p99Ms"] = toMs(h->percentileMicros(0.99));
+            entry["maxMs"] = toMs(h->maxMicros());
+        }
+        list.append(entry);
+    }
+    return list;
+}
+
+QJsonObject Metrics::toJson() const {
+    QJsonObject json;
+    for (const QVariant &entry : snapshot()) {
+        QVariantMap map = entry.toMap();
+        const QString name = map.take("name").toString();
+        json.insert(name, QJsonObject::fromVariantMap(map));
+    }
+    return json;
+}
+
+QString Metrics::dump() const {
+    QString text;
+    for (const QVariant &entry : snapshot()) {
+        const QVariantMap m = entry.toMap();
+        if (m.value("type") == "counter") {
+            text += QString("%1  %2\n").arg(m.value("name").toString(), -36).arg(m.value("value").toULongLong());
+        } else {
+            text += QString("%1  n=%2  mean=%3ms  p50=%4ms  p90=%5ms  p99=%6ms  max=%7ms\n")
+                        .arg(m.value("name").toString(), -36)
+                        .arg(m.value("count").toULongLong())
+                        .arg(m.value("meanMs").toDouble())
+                        .arg(m.value("p50Ms").toDouble())
+                        .arg(m.value("p90Ms").toDouble())
+                        .arg(m.value("p99Ms").toDouble())
+                        .arg(m.value("maxMs").toDouble());
+        }
+    }
+    return text;
+}
@@ -0,0 +1,102 @@
+#pragma once
+#include <QObject>
+#include <QElapsedTimer>
+#include <QHash>
+#include <QMutex>
+#include <QVariant>
+#include <QJsonObject>
+#include <atomic>
+#include <memory>
+#include <vector>
+
+// ========================================================================
+// 进程内性能指标 (计数器 + 固定分桶直方图)
+// ========================================================================
+// 记录路径无锁：计数器与直方图的桶都是 std::atomic，使用 relaxed 序，
+// 一次记录只是几次原子加法，可以放在每秒触发的路径上。
+// 只有按名称注册时加锁，调用方应把返回的指针缓存在静态变量里：
+//
+//     static MetricHistogram *s_latency = Metrics::instance()->histogram("activity.getDailyActivities");
+//     MetricTimer timer(s_latency);
+//
+// 直方图单位统一为微秒，桶按 2 的幂划分 (第 i 个桶为 [2^(i-1), 2^i) µs)，
+// 分位数取所在桶的上界，误差不超过 2 倍，足够发现数量级问题。
+// ========================================================================
+
+class MetricCounter {
+public:
+    void add(quint64 n = 1) { m_value.fetch_add(n, std::memory_order_relaxed); }
+    quint64 value() const { return m_value.load(std::memory_order_relaxed); }
+
+private:
+    std::atomic<quint64> m_value{0};
+};
+
+class MetricHistogram {
+public:
+    static const int BUCKETS = 32; // 最后一个桶收纳 >= 2^30 µs (约 18 分钟)
+
+    void record(qint64 micros);
+
+    quint64 count() const { return m_count.load(std::memory_order_relaxed); }
+    quint64 maxMicros() const { return m_max.load(std::memory_order_relaxed); }
+    double meanMicros() const;
+    // 分位数估计 (p 取 0~1)，返回所在桶的上界，不超过最大值
+    quint64 percentileMicros(double p) const;
+
+private:
+    std::atomic<quint64> m_buckets[BUCKETS] = {};
+    std::atomic<quint64> m_count{0};
+    std::atomic<quint64> m_sum{0};
+    std::atomic<quint64> m_max{0};
+};
+
+// 作用域计时：析构时把耗时记入直方图
+class MetricTimer {
+public:
+    explicit MetricTimer(MetricHistogram *histogram) : m_histogram(histogram) { m_timer.start(); }
+    ~MetricTimer() { m_histogram->record(m_timer.nsecsElapsed() / 1000); }
+
+private:
+    MetricHistogram *m_histogram;
+    QElapsedTimer m_timer;
+};
+
+// ========================================================================
+// Metrics：指标注册表 (进程级单例)
+// ========================================================================
+// 除 C++ 热点路径外，QML 也可以通过 markStart/markEnd 测量跨越 C++ 与
+// QML 的时延 (例如 reminderTriggered 到全屏提醒窗口第一帧)。
+class Metrics : public QObject {
+    Q_OBJECT
+public:
+    static Metrics *instance();
+
+    // 按名称取得 (必要时创建) 指标，返回的指针在进程生命周期内有效
+    MetricCounter *counter(const QString &name);
+    MetricHistogram *histogram(const QString &name);
+
+    // 开始/结束一段跨模块的计时 (同名未结束的计时会被新的开始覆盖，
+    // 没有对应开始的结束被忽略)，结果记入同名直方图
+    Q_INVOKABLE void markStart(const QString &name);
+    Q_INVOKABLE void markEnd(const QString &name);
+
+    // 所有指标的快照，按名称排序:
+    // [{name, type: "counter", value} | {name, type: "histogram", count, meanMs, p50Ms, p90Ms, p99Ms, maxMs}]
+    Q_INVOKABLE QVariantList snapshot() const;
+    // 同上，JSON 对象 (名称 -> 数据)，供控制接口与 HTTP 接口
+    QJsonObject toJson() const;
+    // 便于阅读的文本表格
+    Q_INVOKABLE QString dump() const;
+
+private:
+    explicit Metrics(QObject *parent = nullptr);
+
+    mutable QMutex m_mutex; // 只保护注册表与 m_marks，不在记录路径上
+    QHash<QString, MetricCounter *> m_counters;
+    QHash<QString, MetricHistogram *> m_histograms;
+    std::vector<std::unique_ptr<MetricCounter>> m_counterStorage;
+    std::vector<std::unique_ptr<MetricHistogram>> m_histogramStorage;
+    QHash<QString, qint64> m_marks; // markStart 的时间点 (纳秒，m_clock)
+    QElapsedTimer m_clock;
+};
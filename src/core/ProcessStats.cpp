@@ -0,0 +1,86 @@
+#include "ProcessStats.h"
+#include <QObject>
+#include <atomic>
+
+#ifdef Q_OS_WIN
+#include <windows.h>
+#include <psapi.h>
+#elif defined(Q_OS_LINUX)
+#include <QDir>
+#include <QFile>
+#include <unistd.h>
+#endif
+
+// QtCore 为调试工具导出的钩子表 (qhooks_p.h)，这里只用到对象增删两项
+extern quintptr Q_CORE_EXPORT qtHookData[];
+
+namespace {
+
+enum HookIndex { HookAddQObject = 3, HookRemoveQObject = 4 };
+typedef void (*QObjectHook)(QObject*);
+
+std::atomic<qint64> s_liveObjects{0};
+std::atomic<bool> s_tracking{false};
+QObjectHook s_previousAdd = nullptr;
+QObjectHook s_previousRemove = nullptr;
+
+void onAddQObject(QObject* object) {
+    s_liveObjects.fetch_add(1, std::memory_order_relaxed);
+    if (s_previousAdd) s_previousAdd(object);
+}
+
+void onRemoveQObject(QObject* object) {
+    s_liveObjects.fetch_sub(1, std::memory_order_relaxed);
+    if (s_previousRemove) s_previousRemove(object);
+}
+
+} // namespace
+
+qint64 ProcessStats::residentBytes() {
+#ifdef Q_OS_WIN
+    PROCESS_MEMORY_COUNTERS counters = {};
+    if (!GetProcessMemoryInfo(GetCurrentProcess(), &counters, sizeof(counters))) return -1;
+    return qint64(counters.WorkingSetSize);
+#elif defined(Q_OS_LINUX)
+    // statm: 总页数 常驻页数 ...
+    QFile statm("/proc/self/statm");
+    if (!statm.open(QIODevice::ReadOnly)) return -1;
+    const QList<QByteArray> fields = statm.readAll().split(' ');
+    if (fields.size() < 2) return -1;
+    return fields.at(1).toLongLong() * sysconf(_SC_PAGESIZE);
+#else
+    return -1;
+#endif
+}
+
+int ProcessStats::openHandles() {
+#ifdef Q_OS_WIN
+    DWORD count = 0;
+    return GetProcessHandleCount(GetCurrentProcess(), &count) ? int(count) : -1;
+#elif defined(Q_OS_LINUX)
+    // 不含 "." 与 ".."；列目录本身占用的描述符也会被计入，对比增量时可以忽略
+    return int(QDir("/proc/self/fd").entryList(QDir::AllEntries | QDir::NoDotAndDotDot | QDir::System).size());
+#else
+    return -1;
+#endif
+}
+
+int ProcessStats::guiObjects() {
+#ifdef Q_OS_WIN
+    return int(GetGuiResources(GetCurrentProcess(), GR_GDIOBJECTS) + GetGuiResources(GetCurrentProcess(), GR_USEROBJECTS));
+#else
+    return -1;
+#endif
+}
+
+void ProcessStats::trackQObjects() {
+    if (s_tracking.exchange(true)) return;
+    s_previousAdd = reinterpret_cast<QObjectHook>(qtHookData[HookAddQObject]);
+    s_previousRemove = reinterpret_cast<QObjectHook>(qtHookData[HookRemoveQObject]);
+    qtHookData[HookAddQObject] = reinterpret_cast<quintptr>(&onAddQObject);
+    qtHookData[HookRemoveQObject] = reinterpret_cast<quintptr>(&onRemoveQObject);
+}
+
+qint64 ProcessStats::liveQObjects() {
+    return s_tracking.load() ? s_liveObjects.load(std::memory_order_relaxed) : -1;
+}
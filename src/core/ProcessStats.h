@@ -0,0 +1,25 @@
+#pragma once
+#include <QtGlobal>
+
+// ========================================================================
+// ProcessStats：进程资源读数 (长时间运行检查用)
+// ========================================================================
+// 只读取操作系统提供的计数，不做采样线程；无法获得时返回 -1。
+// - residentBytes: 常驻内存 (Linux /proc/self/statm，Windows 工作集)
+// - openHandles:   打开的文件描述符 (Linux /proc/self/fd) / 内核句柄 (Windows)
+// - guiObjects:    GDI + USER 对象 (仅 Windows；窗口反复创建销毁时最容易泄漏)
+// - liveQObjects:  存活的 QObject 数量。通过 QtCore 为调试工具导出的对象
+//                  创建/销毁钩子 (qtHookData，GammaRay 使用的同一机制) 计数，
+//                  需先调用 trackQObjects()；之前创建的对象不计入，只适合看增量。
+// ========================================================================
+class ProcessStats
+{
+public:
+    static qint64 residentBytes();
+    static int openHandles();
+    static int guiObjects();
+
+    // 安装 QObject 计数钩子 (可重复调用，越早越好)
+    static void trackQObjects();
+    static qint64 liveQObjects();
+};
@@ -0,0 +1,313 @@
+#include "ReminderScheduler.h"
+#include "TimerEngine.h"
+#include "Clock.h"
+#include "Logging.h"
+#include <QSettings>
+#include <algorithm>
+
+const QString ReminderScheduler::MovementKind = QStringLiteral("movement");
+
+ReminderScheduler::ReminderScheduler(TimerEngine* engine, QObject* parent)
+    : QObject(parent), m_engine(engine), m_clock(engine ? engine->clock() : Clock::system())
+{
+    m_timer = m_clock->createTimer(this);
+    connect(m_timer, &ClockTimer::timeout, this, &ReminderScheduler::onTimer);
+
+    // 内置提醒类型 (可通过设置覆盖)
+    ReminderKind eyeRest;
+    eyeRest.id = "eyeRest";
+    eyeRest.title = "护眼提醒";
+    eyeRest.message = "看向 6 米外的地方，放松 20 秒";
+    eyeRest.logState = "EyeRest";
+    eyeRest.intervalSecs = 20 * 60;
+    eyeRest.durationSecs = 20;
+    eyeRest.resetByBreak = true;
+    m_kinds.append(eyeRest);
+
+    ReminderKind hydration;
+    hydration.id = "hydration";
+    hydration.title = "喝水提醒";
+    hydration.message = "起身喝杯水吧";
+    hydration.logState = "Hydration";
+    hydration.intervalSecs = 90 * 60;
+    hydration.durationSecs = 60;
+    m_kinds.append(hydration);
+
+    ReminderKind longBreak;
+    longBreak.id = "longBreak";
+    longBreak.title = "长休息";
+    longBreak.message = "已连续完成多轮工作，这次多休息一会儿";
+    longBreak.logState = "LongBreak";
+    longBreak.everyNthCycle = 4;
+    longBreak.durationSecs = 15 * 60;
+    m_kinds.append(longBreak);
+
+    m_generations.fill(0, m_kinds.size());
+    loadSettings();
+
+    const qint64 now = m_clock->monotonicMs();
+    m_paused = m_engine && !m_engine->isRunning();
+    m_pausedAtMs = now;
+    for (int i = 0; i < m_kinds.size(); ++i) schedule(i, now);
+
+    if (m_engine) {
+        connect(m_engine, &TimerEngine::reminderTriggered, this, &ReminderScheduler::onMovementReminder);
+        connect(m_engine, &TimerEngine::isRunningChanged, this, &ReminderScheduler::onEngineRunningChanged);
+    }
+    arm();
+}
+
+// 最小堆比较器：到期时间早的在堆顶
+bool ReminderScheduler::laterThan(const HeapEntry& a, const HeapEntry& b) {
+    return a.dueMs > b.dueMs;
+}
+
+int ReminderScheduler::indexOf(const QString& id) const {
+    for (int i = 0; i < m_kinds.size(); ++i) {
+        if (m_kinds.at(i).id == id) return i;
+    }
+    return -1;
+}
+
+void ReminderScheduler::addKind(const ReminderKind& kind) {
+    int index = indexOf(kind.id);
+    if (index < 0) {
+        m_kinds.append(kind);
+        m_generations.append(0);
+        index = m_kinds.size() - 1;
+    } else {
+        m_kinds[index] = kind;
+    }
+    schedule(index, m_clock->monotonicMs());
+    arm();
+}
+
+QString ReminderScheduler::title(const QString& id) const {
+    if (id == MovementKind) return "运动提醒";
+    int index = indexOf(id);
+    return index >= 0 ? m_kinds.at(index).title : QString();
+}
+
+QString ReminderScheduler::message(const QString& id) const {
+    if (id == MovementKind) return "起来活动一下吧";
+    int index = indexOf(id);
+    return index >= 0 ? m_kinds.at(index).message : QString();
+}
+
+// ========================================================================
+// 配置
+// ========================================================================
+
+void ReminderScheduler::loadSettings() {
+    QSettings settings("TraeAI", "DeskCare");
+    for (ReminderKind& kind : m_kinds) {
+        const QString prefix = "Reminders/" + kind.id + "/";
+        kind.enabled = settings.value(prefix + "enabled", kind.enabled).toBool();
+        if (kind.intervalSecs > 0) {
+            kind.intervalSecs = qMax(1, settings.value(prefix + "intervalMinutes", kind.intervalSecs / 60).toInt()) * 60;
+        }
+        if (kind.everyNthCycle > 0) {
+            kind.everyNthCycle = qMax(1, settings.value(prefix + "everyNthCycle", kind.everyNthCycle).toInt());
+        }
+    }
+}
+
+void ReminderScheduler::saveSettings(const ReminderKind& kind) const {
+    QSettings settings("TraeAI", "DeskCare");
+    const QString prefix = "Reminders/" + kind.id + "/";
+    settings.setValue(prefix + "enabled", kind.enabled);
+    if (kind.intervalSecs > 0) settings.setValue(prefix + "intervalMinutes", kind.intervalSecs / 60);
+    if (kind.everyNthCycle > 0) settings.setValue(prefix + "everyNthCycle", kind.everyNthCycle);
+}
+
+void ReminderScheduler::setEnabled(const QString& id, bool enabled) {
+    int index = indexOf(id);
+    if (index < 0 || m_kinds.at(index).enabled == enabled) return;
+
+    m_kinds[index].enabled = enabled;
+    saveSettings(m_kinds.at(index));
+    schedule(index, m_clock->monotonicMs());
+    arm();
+}
+
+void ReminderScheduler::setIntervalMinutes(const QString& id, int minutes) {
+    int index = indexOf(id);
+    if (index < 0 || m_kinds.at(index).intervalSecs <= 0) return;
+
+    m_kinds[index].intervalSecs = qMax(1, minutes) * 60;
+    saveSettings(m_kinds.at(index));
+    schedule(index, m_clock->monotonicMs());
+    arm();
+}
+
+// ========================================================================
+// 最小堆
+// ========================================================================
+
+void ReminderScheduler::schedule(int index, qint64 now) {
+    // 递增代数，使该类型已在堆中的条目失效 (惰性删除)
+    quint32 generation = ++m_generations[index];
+
+    const ReminderKind& kind = m_kinds.at(index);
+    if (!kind.enabled || kind.intervalSecs <= 0) return;
+
+    // 暂停期间排期的条目从暂停时刻算起，恢复时与其他条目一起顺延
+    const qint64 base = m_paused ? m_pausedAtMs : now;
+    pushEntry({ base + qint64(kind.intervalSecs) * 1000, index, generation });
+}
+
+void ReminderScheduler::pushEntry(const HeapEntry& entry) {
+    m_heap.append(entry);
+    std::push_heap(m_heap.begin(), m_heap.end(), laterThan);
+}
+
+void ReminderScheduler::popEntry() {
+    std::pop_heap(m_heap.begin(), m_heap.end(), laterThan);
+    m_heap.removeLast();
+}
+
+void ReminderScheduler::dropStale() {
+    while (!m_heap.isEmpty() && m_heap.first().generation != m_generations.at(m_heap.first().kind)) {
+        popEntry();
+    }
+}
+
+void ReminderScheduler::arm() {
+    dropStale();
+    if (m_paused || m_heap.isEmpty()) {
+        m_timer->stop();
+        return;
+    }
+
+    const qint64 wait = m_heap.first().dueMs - m_clock->monotonicMs();
+    m_timer->start(qBound<qint64>(0, wait, MAX_WAIT_MS));
+}
+
+// ========================================================================
+// 触发与合并
+// ========================================================================
+
+void ReminderScheduler::onTimer() {
+    if (m_paused) return;
+
+    const qint64 now = m_clock->monotonicMs();
+    dropStale();
+    if (m_heap.isEmpty() || m_heap.first().dueMs > now) {
+        arm(); // 分段等待尚未到期
+        return;
+    }
+
+    // 取出合并窗口内到期的全部提醒
+    QVector<int> due;
+    while (!m_heap.isEmpty() && m_heap.first().dueMs <= now + COALESCE_WINDOW_MS) {
+        const HeapEntry entry = m_heap.first();
+        popEntry();
+        if (entry.generation == m_generations.at(entry.kind) && !due.contains(entry.kind)) {
+            due.append(entry.kind);
+        }
+        dropStale();
+    }
+
+    // 会议中：顺延到会议结束，届时落在同一合并窗口内一起弹出
+    const CalendarIndex* calendar = m_engine ? m_engine->calendar() : nullptr;
+    if (calendar && !due.isEmpty()) {
+        const qint64 wallNow = m_clock->now().toMSecsSinceEpoch();
+        const qint64 freeAt = calendar->nextFreeSlot(wallNow);
+        if (freeAt > wallNow) {
+            for (int index : due) pushEntry({ now + (freeAt - wallNow), index, ++m_generations[index] });
+            arm();
+            return;
+        }
+    }
+
+    for (int index : due) schedule(index, now);
+
+    // 运动提醒即将到来：并入运动提醒，避免连续弹出两次
+    const bool movementSoon = m_engine && m_engine->isRunning()
+                              && qint64(m_engine->remainingSeconds()) * 1000 <= COALESCE_WINDOW_MS;
+    if (movementSoon) {
+        for (int index : due) m_deferred.insert(index);
+    } else if (!due.isEmpty()) {
+        QStringList ids;
+        for (int index : due) ids << m_kinds.at(index).id;
+        activate(ids);
+    }
+
+    arm();
+}
+
+void ReminderScheduler::onMovementReminder() {
+    const qint64 now = m_clock->monotonicMs();
+    m_cycle++;
+
+    QStringList ids;
+    ids << MovementKind;
+
+    for (int i = 0; i < m_kinds.size(); ++i) {
+        const ReminderKind& kind = m_kinds.at(i);
+        if (!kind.enabled) continue;
+
+        const bool cycleDue = kind.everyNthCycle > 0 && m_cycle % kind.everyNthCycle == 0;
+        if (cycleDue || m_deferred.contains(i)) ids << kind.id;
+
+        // 运动休息同样满足该提醒，重新计时
+        if (kind.resetByBreak) schedule(i, now);
+    }
+    m_deferred.clear();
+
+    activate(ids);
+    arm();
+}
+
+void ReminderScheduler::onEngineRunningChanged() {
+    const bool running = m_engine->isRunning();
+    const qint64 now = m_clock->monotonicMs();
+
+    if (!running && !m_paused) {
+        // 暂停 / 午休 / 锁屏 / 休息中：冻结所有提醒
+        m_paused = true;
+        m_pausedAtMs = now;
+        m_timer->stop();
+    } else if (running && m_paused) {
+        // 整体顺延暂停时长 (统一平移不破坏堆序)
+        const qint64 delta = now - m_pausedAtMs;
+        for (HeapEntry& entry : m_heap) entry.dueMs += delta;
+        m_paused = false;
+
+        // 计时恢复意味着本轮运动休息已结束
+        if (m_active.contains(MovementKind)) {
+            completeReminder(MovementKind);
+            for (const ReminderKind& kind : qAsConst(m_kinds)) {
+                if (kind.everyNthCycle > 0) completeReminder(kind.id);
+            }
+        }
+        arm();
+    }
+}
+
+void ReminderScheduler::activate(const QStringList& ids) {
+    for (const QString& id : ids) {
+        if (m_active.contains(id)) continue;
+        m_active.append(id);
+
+        int index = indexOf(id);
+        emit reminderStarted(id, index >= 0 ? m_kinds.at(index).logState : QString());
+    }
+
+    qCDebug(lcEngine) << "Reminders due:" << ids;
+    emit activeRemindersChanged();
+    emit remindersDue(ids);
+}
+
+void ReminderScheduler::completeReminder(const QString& id) {
+    if (!m_active.removeOne(id)) return;
+
+    int index = indexOf(id);
+    emit reminderFinished(id, index >= 0 ? m_kinds.at(index).durationSecs : 0);
+    emit activeRemindersChanged();
+}
+
+void ReminderScheduler::completeAll() {
+    const QStringList active = m_active;
+    for (const QString& id : active) completeReminder(id);
+}
@@ -0,0 +1,123 @@
+#pragma once
+
+#include <QObject>
+#include <QVector>
+#include <QStringList>
+#include <QSet>
+
+class TimerEngine;
+class Clock;
+class ClockTimer;
+
+// ========================================================================
+// ReminderScheduler：多种提醒的统一调度器
+// ========================================================================
+// 作用：在 TimerEngine 的运动提醒之外，管理任意数量独立配置的提醒类型
+// (20-20-20 护眼、定时喝水、每 N 轮一次的长休息等)。
+// 原理：
+// - 按间隔触发的提醒放在一个按到期时间排序的最小堆中，只启动一个
+//   单次定时器，指向堆顶的到期时间 (与 TimerEngine 共用同一个 Clock)。
+// - 运动提醒仍由 TimerEngine 倒计时驱动，按轮次触发的提醒 (长休息)
+//   在运动提醒到来时计数。
+// - 合并：同一窗口 (COALESCE_WINDOW_MS) 内到期的提醒合并为一次通知；
+//   若运动提醒即将到来，其余提醒并入运动提醒一起弹出。
+// - 计时器暂停 (手动暂停、午休、锁屏) 时整体顺延。
+// - 到期时若处于会议中 (TimerEngine::calendar())，顺延到会议结束。
+// 配置保存在 QSettings("TraeAI", "DeskCare") 的 Reminders/<id>/ 下。
+// ========================================================================
+
+// 一种提醒的配置
+struct ReminderKind {
+    QString id;            // 唯一标识，如 "eyeRest"
+    QString title;         // 通知标题
+    QString message;       // 通知内容
+    QString logState;      // 写入提醒记录表的名称 (为空表示不单独记录)
+    int intervalSecs = 0;  // 按时间间隔触发 (0 表示不按时间触发)
+    int everyNthCycle = 0; // 每 N 次运动提醒触发一次 (0 表示不按轮次触发)
+    int durationSecs = 0;  // 建议时长 (秒)，也是日志记录的时长上限
+    bool resetByBreak = false; // 运动休息也满足该提醒 (休息后重新计时)
+    bool enabled = true;
+};
+
+class ReminderScheduler : public QObject
+{
+    Q_OBJECT
+
+    // 当前这次提醒包含的类型 (供提醒界面显示)
+    Q_PROPERTY(QStringList activeReminders READ activeReminders NOTIFY activeRemindersChanged)
+
+public:
+    // 运动提醒的固定 id (由 TimerEngine 驱动)
+    static const QString MovementKind;
+
+    explicit ReminderScheduler(TimerEngine* engine, QObject* parent = nullptr);
+
+    // 注册一种提醒类型 (已存在则覆盖配置)
+    void addKind(const ReminderKind& kind);
+    QVector<ReminderKind> kinds() const { return m_kinds; }
+
+    QStringList activeReminders() const { return m_active; }
+
+    Q_INVOKABLE QString title(const QString& id) const;
+    Q_INVOKABLE QString message(const QString& id) const;
+
+    // 修改配置 (立即生效并保存)
+    Q_INVOKABLE void setEnabled(const QString& id, bool enabled);
+    Q_INVOKABLE void setIntervalMinutes(const QString& id, int minutes);
+
+    // 用户确认完成某项提醒
+    Q_INVOKABLE void completeReminder(const QString& id);
+    // 确认完成当前所有提醒
+    Q_INVOKABLE void completeAll();
+
+signals:
+    // 一组 (合并后的) 提醒到期
+    void remindersDue(const QStringList& kinds);
+    void activeRemindersChanged();
+
+    // 某类提醒开始/结束，ActivityLogger 据此为每种提醒维护独立的会话
+    void reminderStarted(const QString& id, const QString& logState);
+    void reminderFinished(const QString& id, int maxSeconds);
+
+private slots:
+    void onTimer();
+    void onMovementReminder();
+    void onEngineRunningChanged();
+
+private:
+    struct HeapEntry {
+        qint64 dueMs;
+        int kind;         // m_kinds 下标
+        quint32 generation; // 与 m_generations 不一致时表示已失效
+    };
+
+    static bool laterThan(const HeapEntry& a, const HeapEntry& b);
+    int indexOf(const QString& id) const;
+    void loadSettings();
+    void saveSettings(const ReminderKind& kind) const;
+
+    // 以 now 为起点为第 index 种提醒重新排期 (旧的堆条目惰性失效)
+    void schedule(int index, qint64 now);
+    void pushEntry(const HeapEntry& entry);
+    void popEntry();
+    void dropStale();
+    void arm();
+
+    void activate(const QStringList& kinds);
+
+    static const int COALESCE_WINDOW_MS = 60 * 1000;
+    static const int MAX_WAIT_MS = 5 * 60 * 1000; // 与 TimerEngine 相同的分段等待
+
+    TimerEngine* m_engine;
+    Clock* m_clock;
+    ClockTimer* m_timer; // 唯一的唤醒源
+    QVector<ReminderKind> m_kinds;
+    QVector<quint32> m_generations;
+    QVector<HeapEntry> m_heap;
+
+    bool m_paused = false;
+    qint64 m_pausedAtMs = 0;
+    int m_cycle = 0;          // 已触发的运动提醒次数
+    QSet<int> m_deferred;     // 并入下一次运动提醒的提醒类型
+    QStringList m_active;
+};
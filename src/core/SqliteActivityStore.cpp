@@ -0,0 +1,700 @@
+#include "SqliteActivityStore.h"
+#include "StartupTracer.h"
+#include "Logging.h"
+#include <QSqlQuery>
+#include <QSqlError>
+#include <QDir>
+#include <QFile>
+#include <QUrl>
+#include <QDateTime>
+#include <algorithm>
+
+// 各分库共用的列清单，UNION ALL 时按此顺序取列
+static const char* const kActivityColumns = "id, state, start_time, end_time, duration, content, work_type";
+
+SqliteActivityStore::SqliteActivityStore(const QString& dataDir, const QString& connectionName, bool useJournal)
+    : m_connectionName(connectionName), m_dataDir(dataDir), m_useJournal(useJournal)
+{
+    initDatabase();
+}
+
+SqliteActivityStore::~SqliteActivityStore() {
+    flush();
+    m_journal.reset();
+
+    if (m_db.isOpen()) {
+        m_db.close();
+    }
+    m_db = QSqlDatabase();
+    QSqlDatabase::removeDatabase(m_connectionName);
+}
+
+void SqliteActivityStore::initDatabase() {
+    QDir dir(m_dataDir);
+    if (!dir.exists()) {
+        dir.mkpath(".");
+    }
+
+    QString dbPath = dir.filePath("activity_log.db");
+    m_dataDir = dir.absolutePath();
+    m_currentYear = QDate::currentDate().year();
+    m_db = QSqlDatabase::addDatabase("QSQLITE", m_connectionName);
+    m_db.setDatabaseName(dbPath);
+    // 允许 ATTACH 时使用 file: URI (mode=ro&immutable=1)
+    m_db.setConnectOptions("QSQLITE_OPEN_URI");
+
+    TraceSpan span("db.open");
+    if (!m_db.open()) {
+        qCCritical(lcDb) << "Error opening database:" << m_db.lastError();
+        return;
+    }
+    span.next("db.migrate");
+
+    QSqlQuery query(m_db);
+    // Create table if not exists
+    // id, state (text), start_time (int timestamp), end_time (int timestamp), duration (int seconds)
+    QString createTable = R"(
+        CREATE TABLE IF NOT EXISTS activity_log (
+            id INTEGER PRIMARY KEY AUTOINCREMENT,
+            state TEXT,
+            start_time INTEGER,
+            end_time INTEGER,
+            duration INTEGER
+        )
+    )";
+
+    if (!query.exec(createTable)) {
+        qCCritical(lcDb) << "Error creating table:" << query.lastError();
+    } else {
+        m_initialized = true;
+        
+        // Check and add new columns if they don't exist (Migration)
+        // content TEXT, work_type INTEGER
+        // SQLite doesn't support IF NOT EXISTS for ADD COLUMN, so we just try and ignore error
+        // or check pragma, but try-catch is simpler here since we just want to ensure they exist.
+        
+        query.exec("ALTER TABLE activity_log ADD COLUMN content TEXT");
+        query.exec("ALTER TABLE activity_log ADD COLUMN work_type INTEGER DEFAULT 0");
+
+        // 所有查询都按 start_time 过滤，建立索引避免全表扫描
+        query.exec("CREATE INDEX IF NOT EXISTS idx_activity_log_start_time ON activity_log(start_time)");
+
+        // 记录已压实进数据库的最大日志序号 (单行表)
+        query.exec("CREATE TABLE IF NOT EXISTS journal_meta (id INTEGER PRIMARY KEY CHECK (id = 0), last_seq INTEGER)");
+
+        // 前台应用：名称字典 + 每会话每应用一行
+        query.exec("CREATE TABLE IF NOT EXISTS app_names (id INTEGER PRIMARY KEY, name TEXT NOT NULL UNIQUE)");
+        query.exec(R"(
+            CREATE TABLE IF NOT EXISTS app_usage (
+                session_start INTEGER NOT NULL,
+                app_id INTEGER NOT NULL,
+                seconds INTEGER NOT NULL,
+                PRIMARY KEY (session_start, app_id)
+            ) WITHOUT ROWID
+        )");
+
+        // 附加提醒 (护眼、喝水、长休息)：与主状态会话重叠，单独成表
+        query.exec(R"(
+            CREATE TABLE IF NOT EXISTS reminder_log (
+                kind TEXT NOT NULL,
+                start_time INTEGER NOT NULL,
+                end_time INTEGER NOT NULL,
+                duration INTEGER NOT NULL
+            )
+        )");
+        query.exec("CREATE INDEX IF NOT EXISTS idx_reminder_log_start_time ON reminder_log(start_time)");
+
+        // 先重放上次未压实的日志，再做跨年迁移，确保记录落到正确的分库
+        span.next("db.journalReplay");
+        if (m_useJournal) initJournal();
+
+        // 跨年后首次启动：把往年记录迁出主库
+        span.next("db.archives");
+        scanArchives();
+        rollOverClosedYears();
+    }
+}
+
+QString SqliteActivityStore::archivePath(int year) const {
+    return QDir(m_dataDir).filePath(QString("activity_log_%1.db").arg(year));
+}
+
+void SqliteActivityStore::scanArchives() {
+    m_archiveYears.clear();
+    const QStringList files = QDir(m_dataDir).entryList({"activity_log_*.db"}, QDir::Files);
+    for (const QString& file : files) {
+        bool ok = false;
+        int year = file.mid(13, file.length() - 16).toInt(&ok); // "activity_log_" + YYYY + ".db"
+        if (ok && year < m_currentYear) m_archiveYears.append(year);
+    }
+    std::sort(m_archiveYears.begin(), m_archiveYears.end());
+}
+
+void SqliteActivityStore::rollOverClosedYears() {
+    qint64 yearStartTs = QDateTime(QDate(m_currentYear, 1, 1), QTime(0, 0, 0)).toSecsSinceEpoch();
+
+    QSqlQuery query(m_db);
+    query.prepare("SELECT MIN(start_time) FROM activity_log WHERE start_time < ?");
+    query.addBindValue(yearStartTs);
+    if (!query.exec() || !query.next() || query.value(0).isNull()) return;
+
+    int firstYear = QDateTime::fromSecsSinceEpoch(query.value(0).toLongLong()).date().year();
+    query.finish();
+
+    bool archived = false;
+    for (int year = firstYear; year < m_currentYear; ++year) {
+        qint64 fromTs = QDateTime(QDate(year, 1, 1), QTime(0, 0, 0)).toSecsSinceEpoch();
+        qint64 toTs = QDateTime(QDate(year + 1, 1, 1), QTime(0, 0, 0)).toSecsSinceEpoch();
+
+        QSqlQuery count(m_db);
+        count.prepare("SELECT COUNT(*) FROM activity_log WHERE start_time >= ? AND start_time < ?");
+        count.addBindValue(fromTs);
+        count.addBindValue(toTs);
+        if (!count.exec() || !count.next() || count.value(0).toInt() == 0) continue;
+        count.finish();
+
+        // 归档文件平时是只读的，迁移期间临时恢复可写
+        QString path = archivePath(year);
+        QFile::Permissions readOnly = QFileDevice::ReadOwner | QFileDevice::ReadGroup | QFileDevice::ReadOther;
+        if (QFile::exists(path)) QFile::setPermissions(path, readOnly | QFileDevice::WriteOwner);
+
+        QSqlQuery attach(m_db);
+        attach.prepare("ATTACH DATABASE ? AS archive_rw");
+        attach.addBindValue(path);
+        if (!attach.exec()) {
+            qCWarning(lcDb) << "Failed to attach archive for year" << year << attach.lastError();
+            continue;
+        }
+
+        QSqlQuery move(m_db);
+        bool ok = move.exec(R"(
+            CREATE TABLE IF NOT EXISTS archive_rw.activity_log (
+                id INTEGER PRIMARY KEY,
+                state TEXT,
+                start_time INTEGER,
+                end_time INTEGER,
+                duration INTEGER,
+                content TEXT,
+                work_type INTEGER DEFAULT 0
+            )
+        )");
+        ok = ok && move.exec("CREATE INDEX IF NOT EXISTS archive_rw.idx_activity_log_start_time ON activity_log(start_time)");
+
+        ok = ok && m_db.transaction();
+        if (ok) {
+            move.prepare(QString("INSERT OR REPLACE INTO archive_rw.activity_log (%1) SELECT %1 FROM main.activity_log WHERE start_time >= ? AND start_time < ?").arg(kActivityColumns));
+            move.addBindValue(fromTs);
+            move.addBindValue(toTs);
+            bool copied = move.exec();
+
+            move.prepare("DELETE FROM main.activity_log WHERE start_time >= ? AND start_time < ?");
+            move.addBindValue(fromTs);
+            move.addBindValue(toTs);
+            bool deleted = copied && move.exec();
+
+            if (deleted) {
+                ok = m_db.commit();
+            } else {
+                m_db.rollback();
+                ok = false;
+            }
+        }
+        if (!ok) qCWarning(lcDb) << "Failed to archive year" << year << move.lastError();
+        move.finish();
+
+        QSqlQuery detach(m_db);
+        detach.exec("DETACH DATABASE archive_rw");
+        QFile::setPermissions(path, readOnly);
+
+        if (ok) {
+            archived = true;
+            if (!m_archiveYears.contains(year)) m_archiveYears.append(year);
+            qCDebug(lcDb) << "Archived activity log year" << year << "to" << path;
+        }
+    }
+
+    if (archived) {
+        std::sort(m_archiveYears.begin(), m_archiveYears.end());
+        // 主库一年只收缩一次
+        QSqlQuery vacuum(m_db);
+        vacuum.exec("VACUUM");
+    }
+}
+
+bool SqliteActivityStore::ensureYearAttached(int year, const QList<int>& pinned) {
+    if (!m_archiveYears.contains(year)) return false;
+
+    if (m_attachedYears.contains(year)) {
+        m_attachedYears.removeOne(year);
+        m_attachedYears.append(year);
+        return true;
+    }
+
+    if (m_attachedYears.size() >= MAX_ATTACHED_YEARS) {
+        // 淘汰最久未用、且不属于正在构建的查询的年份
+        int evict = -1;
+        for (int attached : qAsConst(m_attachedYears)) {
+            if (!pinned.contains(attached)) {
+                evict = attached;
+                break;
+            }
+        }
+        if (evict < 0) return false; // 调用方保证一批不超过 MAX_ATTACHED_YEARS
+        m_attachedYears.removeOne(evict);
+        QSqlQuery detach(m_db);
+        detach.exec(QString("DETACH DATABASE y%1").arg(evict));
+    }
+
+    // 归档库不会再变化：immutable 省去加锁和变更检测，mmap 减少读拷贝
+    QString uri = QUrl::fromLocalFile(archivePath(year)).toString() + "?mode=ro&immutable=1";
+    QSqlQuery attach(m_db);
+    attach.prepare(QString("ATTACH DATABASE ? AS y%1").arg(year));
+    attach.addBindValue(uri);
+    if (!attach.exec()) {
+        qCWarning(lcDb) << "Failed to attach archive year" << year << attach.lastError();
+        return false;
+    }
+    attach.exec(QString("PRAGMA y%1.mmap_size = 268435456").arg(year));
+
+    m_attachedYears.append(year);
+    return true;
+}
+
+QVector<QList<int>> SqliteActivityStore::archiveBatches(qint64 startTs, qint64 endTs) const {
+    int firstYear = startTs >= 0 ? QDateTime::fromSecsSinceEpoch(startTs).date().year() : 0;
+    int lastYear = endTs >= 0 ? QDateTime::fromSecsSinceEpoch(endTs).date().year() : m_currentYear;
+
+    QVector<QList<int>> batches(1);
+    for (int year : m_archiveYears) {
+        if (year < firstYear || year > lastYear) continue;
+        if (batches.last().size() >= MAX_ATTACHED_YEARS) batches.append(QList<int>());
+        batches.last().append(year);
+    }
+    return batches;
+}
+
+QString SqliteActivityStore::activitySource(const QList<int>& years, bool withMain) {
+    // 整批固定：挂载后面的年份时不能淘汰同一条查询已引用的年份
+    QStringList parts;
+    for (int year : years) {
+        if (ensureYearAttached(year, years)) {
+            parts << QString("SELECT %1 FROM y%2.activity_log").arg(kActivityColumns).arg(year);
+        }
+    }
+
+    // 主库总是参与查询 (跨年未重启时可能仍含上一年的记录)
+    if (!withMain) return parts.isEmpty() ? QString() : "(" + parts.join(" UNION ALL ") + ")";
+    if (parts.isEmpty()) return "activity_log";
+    parts << QString("SELECT %1 FROM main.activity_log").arg(kActivityColumns);
+    return "(" + parts.join(" UNION ALL ") + ")";
+}
+
+QStringList SqliteActivityStore::databaseFiles() const {
+    QStringList paths;
+    for (int year : m_archiveYears) paths << archivePath(year);
+    paths << m_db.databaseName();
+    return paths;
+}
+
+// ============================================================================
+// 追加写日志 (主写入路径)
+// ============================================================================
+
+quint32 SqliteActivityStore::lastCompactedSeq() {
+    QSqlQuery query(m_db);
+    if (query.exec("SELECT last_seq FROM journal_meta WHERE id = 0") && query.next()) {
+        return quint32(query.value(0).toLongLong());
+    }
+    return 0;
+}
+
+void SqliteActivityStore::initJournal() {
+    m_journal.reset(new ActivityJournal(QDir(m_dataDir).filePath("activity_log.journal")));
+    if (!m_journal->open()) {
+        qCWarning(lcDb) << "Activity journal unavailable, falling back to direct inserts";
+        m_journal.reset();
+        return;
+    }
+
+    const quint32 lastSeq = lastCompactedSeq();
+    m_nextSeq = lastSeq + 1;
+
+    // 序号不超过 last_seq 的记录已在上次压实的事务中提交，跳过即可
+    const QVector<ActivityJournal::Entry> entries = m_journal->readAll();
+    for (const ActivityJournal::Entry& entry : entries) {
+        if (entry.seq <= lastSeq) continue;
+        ActivityRecord record;
+        record.state = ActivityJournal::stateName(entry.state);
+        record.startTime = entry.start;
+        record.endTime = entry.end;
+        record.duration = int(entry.end - entry.start);
+        m_pending.append(record);
+        m_nextSeq = qMax(m_nextSeq, entry.seq + 1);
+    }
+
+    if (!entries.isEmpty()) {
+        qCDebug(lcDb) << "Replaying activity journal:" << m_pending.size() << "of" << entries.size() << "records";
+        flush();
+        // 全部已压实 (例如上次在 reset 前退出)：直接清空
+        if (m_pending.isEmpty()) m_journal->reset();
+    }
+}
+
+int SqliteActivityStore::insertDirect(const ActivityRecord& record) {
+    QSqlQuery query(m_db);
+    query.prepare("INSERT INTO activity_log (state, start_time, end_time, duration) VALUES (?, ?, ?, ?)");
+    query.addBindValue(record.state);
+    query.addBindValue(record.startTime);
+    query.addBindValue(record.endTime);
+    query.addBindValue(record.duration);
+
+    if (!query.exec()) {
+        qCWarning(lcDb) << "Failed to log session:" << query.lastError();
+        return -1;
+    }
+    return query.lastInsertId().toInt();
+}
+
+int SqliteActivityStore::appendSession(const ActivityRecord& record) {
+    if (!m_initialized) return -1;
+
+    // 日志不可用或状态无法编码时退回直接写库
+    const quint8 code = ActivityJournal::stateCode(record.state);
+    if (!m_journal || code == 255) {
+        flush(); // 保持 id 与时间顺序一致
+        return insertDirect(record);
+    }
+
+    if (m_journal->isFull()) flush();
+
+    ActivityJournal::Entry entry;
+    entry.seq = m_nextSeq;
+    entry.state = code;
+    entry.start = record.startTime;
+    entry.end = record.endTime;
+
+    if (!m_journal->append(entry)) {
+        flush();
+        return insertDirect(record);
+    }
+
+    m_nextSeq++;
+    m_pending.append(record);
+    if (m_pending.size() >= COMPACT_BATCH) flush();
+
+    // id 在压实时才分配
+    return 0;
+}
+
+void SqliteActivityStore::flush() {
+    if (m_pending.isEmpty() || !m_initialized) return;
+
+    // 单个事务写入整批记录，并同时推进 last_seq (保证重放幂等)
+    if (!m_db.transaction()) {
+        qCWarning(lcDb) << "Journal compaction: cannot begin transaction" << m_db.lastError();
+        return;
+    }
+
+    QSqlQuery insert(m_db);
+    insert.prepare("INSERT INTO activity_log (state, start_time, end_time, duration) VALUES (?, ?, ?, ?)");
+
+    bool ok = true;
+    for (const ActivityRecord& record : qAsConst(m_pending)) {
+        insert.bindValue(0, record.state);
+        insert.bindValue(1, record.startTime);
+        insert.bindValue(2, record.endTime);
+        insert.bindValue(3, record.duration);
+        if (!insert.exec()) {
+            qCWarning(lcDb) << "Journal compaction: insert failed" << insert.lastError();
+            ok = false;
+            break;
+        }
+    }
+
+    if (ok) {
+        QSqlQuery meta(m_db);
+        meta.prepare("INSERT OR REPLACE INTO journal_meta (id, last_seq) VALUES (0, ?)");
+        meta.addBindValue(qint64(m_nextSeq - 1));
+        ok = meta.exec();
+        if (!ok) qCWarning(lcDb) << "Journal compaction: meta update failed" << meta.lastError();
+    }
+
+    if (!ok || !m_db.commit()) {
+        m_db.rollback();
+        return; // 记录仍在日志与内存中，下次再试
+    }
+
+    m_pending.clear();
+    if (m_journal) m_journal->reset();
+}
+
+QVector<ActivityRecord> SqliteActivityStore::scan(const ActivityQuery& q) {
+    QVector<ActivityRecord> result;
+    if (!m_initialized) return result;
+    flush();
+
+    QStringList where;
+    QVariantList binds;
+
+    if (!q.states.isEmpty() || q.includeOtherStates) {
+        QStringList placeholders;
+        for (const QString& state : q.states) {
+            placeholders << "?";
+            binds << state;
+        }
+        QString typeClause = placeholders.isEmpty() ? QString("0") : QString("state IN (%1)").arg(placeholders.join(","));
+        if (q.includeOtherStates) {
+            typeClause = QString("(%1 OR state NOT IN ('Focus','Rest','Nap','Pause'))").arg(typeClause);
+        }
+        where << typeClause;
+    }
+    if (q.minDuration >= 0) {
+        where << "duration > ?";
+        binds << q.minDuration;
+    }
+    if (q.maxDuration >= 0) {
+        where << "duration <= ?";
+        binds << q.maxDuration;
+    }
+    if (q.startTs >= 0) {
+        where << "start_time >= ?";
+        binds << q.startTs;
+    }
+    if (q.endTs >= 0) {
+        where << "start_time <= ?";
+        binds << q.endTs;
+    }
+    if (q.exactStartMs >= 0) {
+        // 与前端一致，允许 1 秒的换算误差
+        where << "ABS(start_time * 1000 - ?) < 1000";
+        binds << q.exactStartMs;
+    }
+    if (q.hasContent) {
+        where << "content IS NOT NULL AND content != ''";
+    }
+
+    const QString filter = where.isEmpty() ? QString() : " WHERE " + where.join(" AND ");
+
+    // 按年份分批执行 (批次升序，主库在最后一批)，各批结果依次拼接仍按时间有序
+    const QVector<QList<int>> batches = archiveBatches(q.startTs, q.endTs);
+    for (int i = 0; i < batches.size(); ++i) {
+        const QString source = activitySource(batches.at(i), i == batches.size() - 1);
+        if (source.isEmpty()) continue;
+
+        QSqlQuery query(m_db);
+        query.setForwardOnly(true);
+        query.prepare(QString("SELECT %1 FROM %2").arg(kActivityColumns, source) + filter + " ORDER BY start_time ASC");
+        for (const QVariant& v : binds) query.addBindValue(v);
+
+        if (!query.exec()) {
+            qCWarning(lcDb) << "Activity scan failed:" << query.lastError();
+            return QVector<ActivityRecord>();
+        }
+
+        while (query.next()) {
+            ActivityRecord record;
+            record.id = query.value(0).toInt();
+            record.state = query.value(1).toString();
+            record.startTime = query.value(2).toLongLong();
+            record.endTime = query.value(3).toLongLong();
+            record.duration = query.value(4).toInt();
+            record.content = query.value(5).toString();
+            record.workType = query.value(6).toInt();
+            result.append(record);
+        }
+    }
+    return result;
+}
+
+QHash<QString, ActivityAggregate> SqliteActivityStore::aggregate(qint64 startTs, qint64 endTs, int longThreshold) {
+    QHash<QString, ActivityAggregate> result;
+    if (!m_initialized) return result;
+    flush();
+
+    // 按年份分批聚合后合并 (同一状态：合计相加，最长一段取较大者)
+    const QVector<QList<int>> batches = archiveBatches(startTs, endTs);
+    for (int i = 0; i < batches.size(); ++i) {
+        const QString source = activitySource(batches.at(i), i == batches.size() - 1);
+        if (source.isEmpty()) continue;
+
+        // SQLite 规定：与单个 MAX() 同时出现的裸列取自最大值所在的行，
+        // 因此 start_time 即为最长一段的开始时间
+        QSqlQuery query(m_db);
+        query.setForwardOnly(true);
+        query.prepare("SELECT state, SUM(duration), COUNT(*), MAX(duration), start_time, SUM(duration > ?) FROM "
+                      + source + " WHERE start_time >= ? AND start_time <= ? GROUP BY state");
+        query.addBindValue(longThreshold);
+        query.addBindValue(startTs);
+        query.addBindValue(endTs);
+
+        if (!query.exec()) {
+            qCWarning(lcDb) << "Activity aggregate failed:" << query.lastError();
+            return QHash<QString, ActivityAggregate>();
+        }
+
+        while (query.next()) {
+            ActivityAggregate& agg = result[query.value(0).toString()];
+            const int maxSeconds = query.value(3).toInt();
+            agg.totalSeconds += query.value(1).toInt();
+            agg.count += query.value(2).toInt();
+            agg.longCount += query.value(5).toInt();
+            if (maxSeconds > agg.maxSeconds) {
+                agg.maxSeconds = maxSeconds;
+                agg.maxStart = query.value(4).toLongLong();
+            }
+        }
+    }
+    return result;
+}
+
+bool SqliteActivityStore::updateContent(int id, const QString& content, int workType) {
+    if (!m_initialized) return false;
+    flush();
+
+    QSqlQuery query(m_db);
+    query.prepare("UPDATE activity_log SET content = ?, work_type = ? WHERE id = ?");
+    query.addBindValue(content);
+    query.addBindValue(workType);
+    query.addBindValue(id);
+
+    if (!query.exec()) {
+        qCWarning(lcDb) << "Failed to update activity content:" << query.lastError();
+        return false;
+    }
+    if (query.numRowsAffected() == 0) {
+        // 往年记录已归档为只读
+        qCWarning(lcDb) << "Activity" << id << "not found in current year database (archived records are read-only)";
+        return false;
+    }
+    return true;
+}
+
+// ============================================================================
+// 前台应用时长
+// ============================================================================
+
+int SqliteActivityStore::internAppName(const QString& name) {
+    auto cached = m_appIds.constFind(name);
+    if (cached != m_appIds.constEnd()) return cached.value();
+
+    QSqlQuery query(m_db);
+    query.prepare("INSERT OR IGNORE INTO app_names (name) VALUES (?)");
+    query.addBindValue(name);
+    if (!query.exec()) {
+        qCWarning(lcDb) << "Failed to intern app name:" << query.lastError();
+        return -1;
+    }
+
+    query.prepare("SELECT id FROM app_names WHERE name = ?");
+    query.addBindValue(name);
+    if (!query.exec() || !query.next()) return -1;
+
+    const int id = query.value(0).toInt();
+    m_appIds.insert(name, id);
+    return id;
+}
+
+bool SqliteActivityStore::appendAppUsage(qint64 sessionStart, const QVector<AppUsage>& usage) {
+    if (!m_initialized || usage.isEmpty()) return false;
+
+    if (!m_db.transaction()) {
+        qCWarning(lcDb) << "App usage: cannot begin transaction" << m_db.lastError();
+        return false;
+    }
+
+    // 同一会话被拆分 (手动运动记录截断) 后再次写入时累加
+    QSqlQuery insert(m_db);
+    insert.prepare("INSERT INTO app_usage (session_start, app_id, seconds) VALUES (?, ?, ?) "
+                   "ON CONFLICT (session_start, app_id) DO UPDATE SET seconds = seconds + excluded.seconds");
+
+    bool ok = true;
+    for (const AppUsage& entry : usage) {
+        const int appId = internAppName(entry.app);
+        if (appId < 0) {
+            ok = false;
+            break;
+        }
+        insert.bindValue(0, sessionStart);
+        insert.bindValue(1, appId);
+        insert.bindValue(2, entry.seconds);
+        if (!insert.exec()) {
+            qCWarning(lcDb) << "App usage: insert failed" << insert.lastError();
+            ok = false;
+            break;
+        }
+    }
+
+    if (!ok || !m_db.commit()) {
+        m_db.rollback();
+        m_appIds.clear(); // 回滚可能撤销了新分配的字典 id
+        return false;
+    }
+    return true;
+}
+
+QVector<AppUsage> SqliteActivityStore::appUsage(qint64 startTs, qint64 endTs) {
+    QVector<AppUsage> result;
+    if (!m_initialized) return result;
+
+    QSqlQuery query(m_db);
+    query.setForwardOnly(true);
+    query.prepare("SELECT n.name, SUM(u.seconds) AS total FROM app_usage u "
+                  "JOIN app_names n ON n.id = u.app_id "
+                  "WHERE u.session_start >= ? AND u.session_start <= ? "
+                  "GROUP BY u.app_id ORDER BY total DESC, n.name ASC");
+    query.addBindValue(startTs);
+    query.addBindValue(endTs);
+
+    if (!query.exec()) {
+        qCWarning(lcDb) << "App usage query failed:" << query.lastError();
+        return result;
+    }
+    while (query.next()) {
+        AppUsage entry;
+        entry.app = query.value(0).toString();
+        entry.seconds = query.value(1).toInt();
+        result.append(entry);
+    }
+    return result;
+}
+
+bool SqliteActivityStore::appendReminder(const ReminderRecord& record) {
+    if (!m_initialized) return false;
+
+    QSqlQuery query(m_db);
+    query.prepare("INSERT INTO reminder_log (kind, start_time, end_time, duration) VALUES (?, ?, ?, ?)");
+    query.addBindValue(record.kind);
+    query.addBindValue(record.startTime);
+    query.addBindValue(record.endTime);
+    query.addBindValue(record.duration);
+    if (!query.exec()) {
+        qCWarning(lcDb) << "Reminder insert failed:" << query.lastError();
+        return false;
+    }
+    return true;
+}
+
+QVector<ReminderRecord> SqliteActivityStore::reminders(qint64 startTs, qint64 endTs) {
+    QVector<ReminderRecord> result;
+    if (!m_initialized) return result;
+
+    QSqlQuery query(m_db);
+    query.setForwardOnly(true);
+    query.prepare("SELECT kind, start_time, end_time, duration FROM reminder_log "
+                  "WHERE start_time >= ? AND start_time <= ? ORDER BY start_time ASC");
+    query.addBindValue(startTs);
+    query.addBindValue(endTs);
+    if (!query.exec()) {
+        qCWarning(lcDb) << "Reminder query failed:" << query.lastError();
+        return result;
+    }
+    while (query.next()) {
+        ReminderRecord record;
+        record.kind = query.value(0).toString();
+        record.startTime = query.value(1).toLongLong();
+        record.endTime = query.value(2).toLongLong();
+        record.duration = query.value(3).toInt();
+        result.append(record);
+    }
+    return result;
+}
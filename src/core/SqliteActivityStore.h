@@ -0,0 +1,85 @@
+#pragma once
+
+#include "ActivityStore.h"
+#include "ActivityJournal.h"
+#include <QSqlDatabase>
+#include <QScopedPointer>
+
+// ========================================================================
+// SqliteActivityStore：基于 SQLite 的持久化实现 (默认后端)
+// ========================================================================
+// 按年份分库：activity_log.db 只保存当年数据 (可写)；往年数据归档到
+// activity_log_<年份>.db (只读)，查询时按需 ATTACH，并将跨年范围用
+// UNION ALL 联合查询，调用方看到的仍是一张逻辑表。
+//
+// 写入路径：appendSession 先追加到 ActivityJournal (activity_log.journal)，
+// 再由 flush() 以单个事务批量压实进 SQLite；读操作前会先压实，保证可见性。
+// 压实时在同一事务中记录已压实的最大序号 (journal_meta)，重放天然幂等。
+//
+// 前台应用时长：应用名存入字典表 app_names，每段专注会话每个应用一行
+// (session_start, app_id, seconds)，WITHOUT ROWID 表按主键紧凑存储。
+// 该表只在主库中，不参与按年份归档 (体积很小)。
+// ========================================================================
+class SqliteActivityStore : public ActivityStore {
+public:
+    // dataDir: 数据库所在目录；connectionName: QSqlDatabase 连接名 (允许多个实例共存)
+    // useJournal: 是否启用追加写日志作为主写入路径
+    explicit SqliteActivityStore(const QString& dataDir, const QString& connectionName = "activity_log",
+                                 bool useJournal = true);
+    ~SqliteActivityStore() override;
+
+    bool isOpen() const override { return m_initialized; }
+    int appendSession(const ActivityRecord& record) override;
+    QVector<ActivityRecord> scan(const ActivityQuery& query) override;
+    QHash<QString, ActivityAggregate> aggregate(qint64 startTs, qint64 endTs, int longThreshold) override;
+    bool updateContent(int id, const QString& content, int workType) override;
+    QStringList databaseFiles() const override;
+    void flush() override;
+    bool appendAppUsage(qint64 sessionStart, const QVector<AppUsage>& usage) override;
+    QVector<AppUsage> appUsage(qint64 startTs, qint64 endTs) override;
+    bool appendReminder(const ReminderRecord& record) override;
+    QVector<ReminderRecord> reminders(qint64 startTs, qint64 endTs) override;
+
+    // 尚未压实的记录数
+    int pendingCount() const { return m_pending.size(); }
+
+private:
+    void initDatabase();
+    void initJournal();           // 打开日志并重放未压实的尾部
+    int insertDirect(const ActivityRecord& record); // 直接写库，返回新 id 或 -1
+    quint32 lastCompactedSeq();
+    int internAppName(const QString& name); // 应用名字典，返回 id 或 -1
+
+    // ---- 按年份分库 ----
+    QString archivePath(int year) const;
+    void scanArchives();
+    void rollOverClosedYears();       // 将 main 中往年的记录迁移到对应年份的归档库
+    // 按需以 immutable 只读方式挂载归档库 (LRU 淘汰，pinned 中的年份不淘汰)
+    bool ensureYearAttached(int year, const QList<int>& pinned);
+    // 覆盖 [startTs, endTs] 的归档年份 (startTs/endTs < 0 表示不限)，按升序每
+    // MAX_ATTACHED_YEARS 个一批；查询逐批执行，至少有一批 (可能为空)
+    QVector<QList<int>> archiveBatches(qint64 startTs, qint64 endTs) const;
+    // 挂载一批年份并返回其表表达式，withMain 时包含主库 (最后一批)；
+    // 该批没有可用的表时返回空
+    QString activitySource(const QList<int>& years, bool withMain);
+
+    QSqlDatabase m_db;
+    QString m_connectionName;
+    QString m_dataDir;
+    bool m_initialized = false;
+
+    int m_currentYear = 0;
+    QList<int> m_archiveYears;  // 磁盘上存在的归档年份 (升序)
+    QList<int> m_attachedYears; // 当前已挂载的归档年份 (末尾为最近使用)
+    static const int MAX_ATTACHED_YEARS = 8; // SQLite 默认最多挂载 10 个库
+
+    // ---- 追加写日志 ----
+    bool m_useJournal;
+    QScopedPointer<ActivityJournal> m_journal;
+    QVector<ActivityRecord> m_pending; // 已写入日志、尚未压实的记录
+    quint32 m_nextSeq = 1;             // 下一条日志记录的序号
+    static const int COMPACT_BATCH = 256;      // 累积到该数量时立即压实
+
+    // ---- 前台应用 ----
+    QHash<QString, int> m_appIds; // app_names 的内存缓存
+};
@@ -0,0 +1,88 @@
+#include "StartupTracer.h"
+#include "Logging.h"
+#include <QCoreApplication>
+#include <QSaveFile>
+#include <QThread>
+
+StartupTracer *StartupTracer::instance() {
+    static StartupTracer s_tracer;
+    return &s_tracer;
+}
+
+void StartupTracer::enable(const QString &path) {
+    m_path = path;
+    m_events.reserve(64);
+    m_timer.start();
+    m_enabled = true;
+}
+
+void StartupTracer::complete(const char *name, qint64 startUs, qint64 endUs) {
+    if (!m_enabled) return;
+    QMutexLocker locker(&m_mutex);
+    m_events.append({ name, 'X', startUs, endUs - startUs, quint64(quintptr(QThread::currentThreadId())) });
+}
+
+void StartupTracer::instant(const char *name) {
+    if (!m_enabled) return;
+    const qint64 now = nowUs();
+    QMutexLocker locker(&m_mutex);
+    m_events.append({ name, 'i', now, 0, quint64(quintptr(QThread::currentThreadId())) });
+}
+
+// 名称只包含标识符与点号，不需要 JSON 转义
+bool StartupTracer::finish() {
+    if (!m_enabled.exchange(false)) return false;
+
+    QMutexLocker locker(&m_mutex);
+    // 主线程显示为 1，其他线程按出现顺序编号
+    const quint64 mainThread = quint64(quintptr(QThread::currentThreadId()));
+    QVector<quint64> threads{ mainThread };
+
+    const qint64 pid = QCoreApplication::applicationPid();
+    QByteArray json = "{\"displayTimeUnit\":\"ms\",\"traceEvents\":[\n";
+    json += QString("{\"name\":\"process_name\",\"ph\":\"M\",\"pid\":%1,\"tid\":1,\"args\":{\"name\":\"DeskCare startup\"}}")
+                .arg(pid).toUtf8();
+    for (const Event &e : m_events) {
+        int tid = threads.indexOf(e.threadId);
+        if (tid < 0) {
+            threads.append(e.threadId);
+            tid = threads.size() - 1;
+        }
+        json += QString(",\n{\"name\":\"%1\",\"cat\":\"startup\",\"ph\":\"%2\",\"ts\":%3,\"pid\":%4,\"tid\":%5")
+                    .arg(QLatin1String(e.name)).arg(QLatin1Char(e.phase)).arg(e.startUs).arg(pid).arg(tid + 1).toUtf8();
+        json += e.phase == 'X' ? QString(",\"dur\":%1}").arg(e.durationUs).toUtf8() : QByteArray(",\"s\":\"g\"}");
+    }
+    json += "\n]}\n";
+
+    QSaveFile file(m_path);
+    if (!file.open(QIODevice::WriteOnly) || file.write(json) != json.size() || !file.commit()) {
+        qCWarning(lcUi) << "StartupTracer: cannot write" << m_path << file.errorString();
+        return false;
+    }
+    qCDebug(lcUi) << "StartupTracer: wrote" << m_events.size() << "events to" << m_path;
+    m_events.clear();
+    return true;
+}
+
+// ========================================================================
+// TraceSpan
+// ========================================================================
+
+TraceSpan::TraceSpan(const char *name) : m_name(name) {
+    StartupTracer *tracer = StartupTracer::instance();
+    if (tracer->isEnabled()) m_startUs = tracer->nowUs();
+}
+
+void TraceSpan::next(const char *name) {
+    finish();
+    m_name = name;
+    StartupTracer *tracer = StartupTracer::instance();
+    if (tracer->isEnabled()) m_startUs = tracer->nowUs();
+}
+
+void TraceSpan::finish() {
+    if (m_startUs < 0) return;
+    StartupTracer *tracer = StartupTracer::instance();
+    tracer->complete(m_name, m_startUs, tracer->nowUs());
+    m_startUs = -1;
+}
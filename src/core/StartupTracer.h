@@ -0,0 +1,74 @@
+#pragma once
+#include <QString>
+#include <QVector>
+#include <QElapsedTimer>
+#include <QMutex>
+#include <atomic>
+
+// ========================================================================
+// StartupTracer：启动阶段追踪 (Chrome trace-event JSON)
+// ========================================================================
+// 由 --trace-startup=<文件> 开启 (默认关闭，关闭时每个 TraceSpan 只是一次
+// 布尔判断)。记录 main.cpp 各阶段、核心对象构造、数据库打开与迁移、
+// QML 加载与首帧，finish() 时写出 JSON，可直接拖进 chrome://tracing 或
+// https://ui.perfetto.dev 查看。
+//
+// 同一线程内的 span 按包含关系嵌套显示；时间戳为 enable() 之后的微秒数。
+// ========================================================================
+class StartupTracer {
+public:
+    static StartupTracer *instance();
+
+    // 开始记录，输出到 path (在 QApplication 创建之前调用)
+    void enable(const QString &path);
+    bool isEnabled() const { return m_enabled; }
+
+    // 已完成的区间 ("X" 事件)
+    void complete(const char *name, qint64 startUs, qint64 endUs);
+    // 瞬时事件 ("i" 事件)，例如首帧
+    void instant(const char *name);
+    // 自 enable() 起的微秒数
+    qint64 nowUs() const { return m_timer.nsecsElapsed() / 1000; }
+
+    // 写出文件并停止记录 (只写一次)，失败时返回 false
+    bool finish();
+
+private:
+    StartupTracer() = default;
+
+    struct Event {
+        const char *name; // 只接受字符串字面量，记录时不复制
+        char phase;
+        qint64 startUs;
+        qint64 durationUs;
+        quint64 threadId;
+    };
+
+    std::atomic<bool> m_enabled{false}; // 工作线程 (数据库打开等) 也会读取
+    QString m_path;
+    QElapsedTimer m_timer;
+    QMutex m_mutex;
+    QVector<Event> m_events;
+};
+
+// 作用域 span：构造时开始，析构或 finish() 时结束；next() 结束当前并开始下一个，
+// 便于给连续声明的对象逐个计时:
+//     TraceSpan span("TimerEngine");
+//     TimerEngine timerEngine;
+//     span.next("ActivityLogger");
+//     ActivityLogger activityLogger(&timerEngine);
+//     span.finish();
+class TraceSpan {
+public:
+    explicit TraceSpan(const char *name);
+    ~TraceSpan() { finish(); }
+
+    void next(const char *name);
+    void finish();
+
+private:
+    const char *m_name;
+    qint64 m_startUs = -1; // -1 表示未记录 (追踪关闭或已结束)
+
+    Q_DISABLE_COPY(TraceSpan)
+};
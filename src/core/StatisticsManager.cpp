@@ -1,12 +1,12 @@
 #include "StatisticsManager.h"
 #include "Version.h"
+#include "Logging.h"
 #include <QNetworkRequest>
 #include <QNetworkReply>
 #include <QNetworkInterface>
 #include <QCryptographicHash>
 #include <QCoreApplication>
 #include <QTimer>
-#include <QDebug>
 #include <QUrlQuery>
 
 StatisticsManager::StatisticsManager(QObject *parent) : QObject(parent) {
@@ -31,7 +31,7 @@ void StatisticsManager::reportStartup() {
         // 设置 User-Agent 方便日志识别
         request.setHeader(QNetworkRequest::UserAgentHeader, "DeskCare-Client/1.0");
 
-        qDebug() << "Reporting stats to:" << url.toString();
+        qCDebug(lcUpdate) << "Reporting stats to:" << url.toString();
 
         // 发送 GET 请求 (日志统计模式)
         QNetworkReply *reply = m_networkManager->get(request);
@@ -39,9 +39,9 @@ void StatisticsManager::reportStartup() {
         connect(reply, &QNetworkReply::finished, this, [reply]() {
             int statusCode = reply->attribute(QNetworkRequest::HttpStatusCodeAttribute).toInt();
             if (reply->error() == QNetworkReply::NoError) {
-                qDebug() << "Stats reported successfully. Status:" << statusCode;
+                qCDebug(lcUpdate) << "Stats reported successfully. Status:" << statusCode;
             } else {
-                qWarning() << "Stats report failed:" << reply->errorString() << "Status:" << statusCode;
+                qCWarning(lcUpdate) << "Stats report failed:" << reply->errorString() << "Status:" << statusCode;
             }
             reply->deleteLater();
         });
@@ -1,32 +1,225 @@
 #include "TimerEngine.h"
-#include <QDebug>
+#include "Metrics.h"
+#include "Logging.h"
 #include <QSettings>
 #include <QDate>
 #include <QVariant>
 #include <QLocale>
 
+// 外部输入作用域 (见 InputTrace)
+class TimerEngine::InputScope {
+public:
+    InputScope(TimerEngine* engine, InputTrace::EventType type, qint64 arg = 0) : m_engine(engine) {
+        if (m_engine->m_inputDepth++ == 0 && m_engine->m_recorder) {
+            m_engine->m_recorder->record(type, arg);
+        }
+    }
+    ~InputScope() { m_engine->m_inputDepth--; }
+
+private:
+    TimerEngine* m_engine;
+};
+
+// ========================================================================
+// 状态机
+// ========================================================================
+// 状态迁移表：kTransitions[当前状态][事件] = { 目标状态, 动作 }。
+// 所有控制流都由此表决定，不再比较状态文本；状态文本只用于显示。
+namespace {
+
+enum Action : quint8 {
+    Action_Ignore = 0,  // 该状态下忽略此事件
+    Action_Restart,     // 以工作时长重新开始倒计时
+    Action_Snooze,      // 以贪睡时长重新开始倒计时
+    Action_Freeze,      // 停止计时，冻结剩余时间
+    Action_Resume,      // 从冻结的剩余时间继续计时
+    Action_BeginBreak,  // 倒计时结束，进入休息
+    Action_BeginNap     // 停止计时，进入午休
+};
+
+struct Transition {
+    TimerEngine::EngineState target;
+    Action action;
+};
+
+#define TE_GO(state, action) { TimerEngine::Engine_##state, Action_##action }
+#define TE_NO                { TimerEngine::Engine_Ready, Action_Ignore }
+
+constexpr Transition kTransitions[TimerEngine::Engine_StateCount][TimerEngine::Event_Count] = {
+    //                StartWork              Snooze                Stop                 TogglePause            Lock                          Unlock                  Deadline                   StartNap              StopNap
+    /* Ready */     { TE_GO(Working, Restart), TE_GO(Snoozed, Snooze), TE_GO(Paused, Freeze), TE_GO(Working, Restart), TE_NO,                        TE_NO,                  TE_NO,                     TE_GO(Nap, BeginNap), TE_NO },
+    /* Working */   { TE_GO(Working, Restart), TE_GO(Snoozed, Snooze), TE_GO(Paused, Freeze), TE_GO(Paused, Freeze),   TE_GO(LockedWorking, Freeze), TE_NO,                  TE_GO(Break, BeginBreak), TE_GO(Nap, BeginNap), TE_NO },
+    /* Snoozed */   { TE_GO(Working, Restart), TE_GO(Snoozed, Snooze), TE_GO(Paused, Freeze), TE_GO(Paused, Freeze),   TE_GO(LockedSnoozed, Freeze), TE_NO,                  TE_GO(Break, BeginBreak), TE_GO(Nap, BeginNap), TE_NO },
+    /* Paused */    { TE_GO(Working, Restart), TE_GO(Snoozed, Snooze), TE_GO(Paused, Freeze), TE_GO(Working, Resume),  TE_NO,                        TE_NO,                  TE_NO,                     TE_GO(Nap, BeginNap), TE_NO },
+    /* LockedWork */{ TE_GO(Working, Restart), TE_GO(Snoozed, Snooze), TE_GO(Paused, Freeze), TE_GO(Working, Restart), TE_NO,                        TE_GO(Working, Resume), TE_NO,                     TE_GO(Nap, BeginNap), TE_NO },
+    /* LockedSnz */ { TE_GO(Working, Restart), TE_GO(Snoozed, Snooze), TE_GO(Paused, Freeze), TE_GO(Working, Restart), TE_NO,                        TE_GO(Snoozed, Resume), TE_NO,                     TE_GO(Nap, BeginNap), TE_NO },
+    /* Break */     { TE_GO(Working, Restart), TE_GO(Snoozed, Snooze), TE_GO(Paused, Freeze), TE_GO(Working, Restart), TE_NO,                        TE_NO,                  TE_NO,                     TE_GO(Nap, BeginNap), TE_NO },
+    /* Nap */       { TE_GO(Working, Restart), TE_GO(Snoozed, Snooze), TE_GO(Paused, Freeze), TE_GO(Working, Restart), TE_NO,                        TE_NO,                  TE_NO,                     TE_NO,                TE_GO(Working, Restart) },
+};
+
+#undef TE_GO
+#undef TE_NO
+
+// 每个状态对应的活动状态 (供 ActivityLogger 记录)
+constexpr TimerEngine::ActivityState kActivityOf[TimerEngine::Engine_StateCount] = {
+    TimerEngine::State_Ready,  // Ready
+    TimerEngine::State_Focus,  // Working
+    TimerEngine::State_Focus,  // Snoozed (贪睡本质上还是在倒计时)
+    TimerEngine::State_Pause,  // Paused
+    TimerEngine::State_Pause,  // LockedWorking
+    TimerEngine::State_Pause,  // LockedSnoozed
+    TimerEngine::State_Rest,   // Break
+    TimerEngine::State_Nap     // Nap
+};
+
+// 显示文本下标：锁屏暂停时保持锁屏前的文本，让用户感觉只是时间冻结了
+constexpr TimerEngine::EngineState kDisplayOf[TimerEngine::Engine_StateCount] = {
+    TimerEngine::Engine_Ready,
+    TimerEngine::Engine_Working,
+    TimerEngine::Engine_Snoozed,
+    TimerEngine::Engine_Paused,
+    TimerEngine::Engine_Working,  // LockedWorking
+    TimerEngine::Engine_Snoozed,  // LockedSnoozed
+    TimerEngine::Engine_Break,
+    TimerEngine::Engine_Nap
+};
+
+// 迁移表的完整性，编译期检查 (见下方 static_assert)
+constexpr bool validateTransitionTable() {
+    for (int state = 0; state < TimerEngine::Engine_StateCount; ++state) {
+        for (int event = 0; event < TimerEngine::Event_Count; ++event) {
+            const Transition t = kTransitions[state][event];
+            if (t.action == Action_Ignore) continue;
+            if (t.target < 0 || t.target >= TimerEngine::Engine_StateCount) return false;
+            // 计时中的状态必须能响应到期、锁屏；计时类动作的目标必须是计时中的状态
+            const bool restarts = t.action == Action_Restart || t.action == Action_Snooze || t.action == Action_Resume;
+            const bool targetRuns = t.target == TimerEngine::Engine_Working || t.target == TimerEngine::Engine_Snoozed;
+            if (restarts != targetRuns) return false;
+        }
+        const bool runs = state == TimerEngine::Engine_Working || state == TimerEngine::Engine_Snoozed;
+        if (runs && (kTransitions[state][TimerEngine::Event_Deadline].action != Action_BeginBreak
+                     || kTransitions[state][TimerEngine::Event_Lock].action != Action_Freeze)) {
+            return false;
+        }
+    }
+    return true;
+}
+
+static_assert(validateTransitionTable(), "kTransitions: inconsistent state transition table");
+
+} // namespace
+
+const QString& TimerEngine::statusTextFor(EngineState state) {
+    static const QString texts[Engine_StateCount] = {
+        QStringLiteral("准备就绪"),
+        QStringLiteral("工作中"),
+        QStringLiteral("稍后提醒"),
+        QStringLiteral("已暂停"),
+        QStringLiteral("工作中"),
+        QStringLiteral("稍后提醒"),
+        QStringLiteral("请休息"),
+        QStringLiteral("午休中")
+    };
+    return texts[kDisplayOf[state]];
+}
+
+bool TimerEngine::dispatch(EngineEvent event) {
+    const Transition t = kTransitions[m_state][event];
+    if (t.action == Action_Ignore) return false;
+
+    const EngineState from = m_state;
+    m_state = t.target;
+    m_deferredUntil = QDateTime();
+
+    // 离开午休：记录时长 (可选：记录统计)
+    if (from == Engine_Nap && t.target != Engine_Nap) {
+        qint64 napDuration = m_napStartTime.secsTo(m_clock->now());
+        qCDebug(lcEngine) << "Nap finished. Duration:" << napDuration << "s";
+    }
+
+    switch (t.action) {
+        case Action_Restart:
+            // 检查是否有休息记录 (如果之前是在休息状态)
+            if (m_breakStartTime.isValid()) {
+                // 计算休息了多少秒
+                qint64 duration = m_breakStartTime.secsTo(m_clock->now());
+                emit breakFinished((int)duration);
+                m_breakStartTime = QDateTime(); // 重置为无效时间
+            }
+            // 锁定本次会话的总时长 (用于进度条)
+            m_currentSessionTotal = m_workDuration;
+            emit currentSessionTotalTimeChanged();
+            // 以新的截止时间 (重新) 启动计时
+            armDeadline(qint64(m_workDuration) * 1000);
+            break;
+        case Action_Snooze:
+            m_currentSessionTotal = m_snoozeDuration; // 进度条分母设为5分钟
+            emit currentSessionTotalTimeChanged();
+            armDeadline(qint64(m_snoozeDuration) * 1000);
+            break;
+        case Action_Freeze:
+            disarmDeadline(); // 冻结剩余时间
+            break;
+        case Action_Resume:
+            armDeadline(m_pausedRemainingMs);
+            break;
+        case Action_BeginBreak:
+            disarmDeadline();
+            m_pausedRemainingMs = 0;
+            // 记录休息开始时间
+            m_breakStartTime = m_clock->now();
+            break;
+        case Action_BeginNap:
+            disarmDeadline(); // 如果正在计时，暂停它
+            m_napStartTime = m_clock->now();
+            qCDebug(lcEngine) << "Nap started at" << m_napStartTime;
+            break;
+        case Action_Ignore:
+            break;
+    }
+
+    updateEstimatedFinishTime();
+    emit statusChanged();
+    if ((from == Engine_Nap) != (t.target == Engine_Nap)) emit isNapModeChanged();
+    if (t.action != Action_Freeze) emit timeUpdated();
+
+    // 触发核心提醒信号 -> 将导致全屏窗口弹出
+    if (t.action == Action_BeginBreak) {
+        // 提醒到全屏窗口第一帧的时延，由 QML 在窗口首次绘制后 markEnd
+        Metrics::instance()->markStart("ui.reminderToOverlay");
+        emit reminderTriggered();
+    }
+
+    setActivityState(kActivityOf[t.target]);
+    return true;
+}
+
 // 构造函数
-TimerEngine::TimerEngine(QObject *parent) 
+TimerEngine::TimerEngine(QObject *parent)
+    : TimerEngine(Clock::system(), parent)
+{
+}
+
+TimerEngine::TimerEngine(Clock *clock, QObject *parent)
     : QObject(parent)
+    , m_clock(clock)
+    , m_pausedRemainingMs(45 * 60 * 1000)
     , m_workDuration(45 * 60) // 默认工作时长初始化为 45 分钟 (单位: 秒)
-    , m_remainingSecs(45 * 60)
     , m_currentSessionTotal(45 * 60)
 {
-    // 实例化 QTimer 对象
-    // "this" 作为 parent，意味着当 TimerEngine 被销毁时，m_timer 也会自动被销毁。
-    m_timer = new QTimer(this);
-    
-    // 设置定时器间隔为 1000 毫秒 (1秒)
-    m_timer->setInterval(1000); 
-    
-    // 连接信号与槽：
-    // 当定时器超时 (timeout) 时，调用本类的 onTick() 函数。
-    // 这就是 Qt 的事件驱动编程模式。
-    connect(m_timer, &QTimer::timeout, this, &TimerEngine::onTick);
-    
-    // 初始化状态
-    m_status = "准备就绪";
+    // 通过 Clock 创建定时器 (真实时间下为 QTimer，虚拟时间下由 VirtualClock 驱动)
+    // "this" 作为 parent，意味着当 TimerEngine 被销毁时，定时器也会自动被销毁。
+    // 截止时间定时器：单次触发
+    m_deadlineTimer = m_clock->createTimer(this);
+    m_deadlineTimer->setObjectName("deadline");
+    connect(m_deadlineTimer, &ClockTimer::timeout, this, &TimerEngine::onDeadline);
+
+    // 显示刷新定时器：按显示需求安排，不参与计时
+    m_tickTimer = m_clock->createTimer(this);
+    m_tickTimer->setObjectName("tick");
+    connect(m_tickTimer, &ClockTimer::timeout, this, &TimerEngine::onTick);
     
+    // 初始状态为 Engine_Ready
     // 默认启动时直接开始工作计时
     startWork(); 
 }
@@ -39,57 +232,160 @@ void TimerEngine::setActivityState(TimerEngine::ActivityState state) {
     if (m_activityState != state) {
         m_activityState = state;
         emit activityStateChanged(state);
-        qDebug() << "Activity State Changed to:" << state;
+        qCDebug(lcEngine) << "Activity State Changed to:" << state;
     }
 }
 
-void TimerEngine::startNap() {
-    if (m_isNapMode) return;
-    
-    // 如果正在计时，暂停它
-    if (m_timer->isActive()) {
-        m_timer->stop();
+// -------------------------------------------------------------------------
+// 截止时间计时
+// -------------------------------------------------------------------------
+
+void TimerEngine::armDeadline(qint64 remainingMs) {
+    remainingMs = qMax<qint64>(0, remainingMs);
+    m_deadlineMs = m_clock->monotonicMs() + remainingMs;
+    m_deadlineTimer->start(qMin<qint64>(remainingMs, DEADLINE_SLICE_MS));
+
+    if (!m_running) {
+        m_running = true;
         emit isRunningChanged();
     }
-    
-    m_isNapMode = true;
-    m_napStartTime = QDateTime::currentDateTime();
-    
-    // 更新状态文本
-    m_status = "午休中";
+    scheduleTick();
+    updateEstimatedFinishTime();
+}
+
+void TimerEngine::disarmDeadline() {
+    m_pausedRemainingMs = remainingMs();
+    m_deadlineTimer->stop();
+    m_tickTimer->stop();
+
+    if (m_running) {
+        m_running = false;
+        emit isRunningChanged();
+    }
+    updateEstimatedFinishTime();
+}
+
+qint64 TimerEngine::remainingMs() const {
+    if (!m_running) return m_pausedRemainingMs;
+    return qMax<qint64>(0, m_deadlineMs - m_clock->monotonicMs());
+}
+
+// -------------------------------------------------------------------------
+// 按需显示刷新
+// -------------------------------------------------------------------------
+
+void TimerEngine::requestDisplay(const QString& consumer, int resolution) {
+    resolution = qBound(int(Display_Second), resolution, int(Display_DeadlineOnly));
+    m_displayDemands.insert(consumer, DisplayResolution(resolution));
+
+    DisplayResolution effective = Display_DeadlineOnly;
+    for (DisplayResolution r : qAsConst(m_displayDemands)) {
+        if (r < effective) effective = r;
+    }
+    if (effective == m_displayResolution) return;
+
+    const bool finer = effective < m_displayResolution;
+    m_displayResolution = effective;
+    scheduleTick();
+
+    // 精度提高时 (例如窗口重新显示) 立即刷新一次，避免显示过期数值
+    if (finer) {
+        updateEstimatedFinishTime();
+        emit timeUpdated();
+    }
+}
+
+void TimerEngine::releaseDisplay(const QString& consumer) {
+    if (!m_displayDemands.contains(consumer)) return;
+    requestDisplay(consumer, Display_DeadlineOnly);
+    m_displayDemands.remove(consumer);
+}
+
+void TimerEngine::scheduleTick() {
+    if (!m_running || m_displayResolution == Display_DeadlineOnly) {
+        m_tickTimer->stop();
+        return;
+    }
+
+    // 剩余时间向上取整显示，因此在剩余时间恰好跨过整秒/整分时刷新
+    const qint64 step = (m_displayResolution == Display_Second) ? 1000 : 60 * 1000;
+    qint64 wait = remainingMs() % step;
+    if (wait == 0) wait = step;
+    m_tickDueMs = m_clock->monotonicMs() + wait;
+    m_tickTimer->start(wait);
+}
+
+void TimerEngine::updateEstimatedFinishTime() {
+    // 如果是暂停状态，无法计算 ETA
+    const bool paused = (m_state == Engine_Paused);
+    const qint64 finishMs = m_clock->now().toMSecsSinceEpoch() + remainingMs();
+    const qint64 minute = paused ? -1 : finishMs / 60000;
+    if (minute == m_etaMinute) return;
+
+    m_etaMinute = minute;
+    // toString("HH:mm") 格式化为 "小时:分钟" 字符串
+    m_etaText = paused ? QStringLiteral("--:--") : QDateTime::fromMSecsSinceEpoch(finishMs).toString("HH:mm");
+    emit estimatedFinishTimeChanged();
+}
+
+void TimerEngine::restoreState(EngineState state, int workDurationSecs, qint64 remainingMs) {
+    if (state < 0 || state >= Engine_StateCount) return;
+
+    if (workDurationSecs > 0 && workDurationSecs != m_workDuration) {
+        m_workDuration = workDurationSecs;
+        emit workDurationMinutesChanged();
+    }
+
+    const EngineState from = m_state;
+    m_state = state;
+    m_deferredUntil = QDateTime();
+    m_breakStartTime = QDateTime();
+
+    if (state == Engine_Working || state == Engine_Snoozed) {
+        m_currentSessionTotal = state == Engine_Snoozed ? m_snoozeDuration : m_workDuration;
+        emit currentSessionTotalTimeChanged();
+        armDeadline(remainingMs);
+    } else {
+        disarmDeadline();
+        m_pausedRemainingMs = qMax<qint64>(0, remainingMs);
+        if (state == Engine_Break) m_breakStartTime = m_clock->now();
+        if (state == Engine_Nap) m_napStartTime = m_clock->now();
+        updateEstimatedFinishTime();
+    }
+
     emit statusChanged();
-    emit isNapModeChanged();
-    
-    setActivityState(State_Nap);
+    if ((from == Engine_Nap) != (state == Engine_Nap)) emit isNapModeChanged();
+    emit timeUpdated();
+    setActivityState(kActivityOf[state]);
+}
 
-    qDebug() << "Nap started at" << m_napStartTime;
+void TimerEngine::startNap() {
+    InputScope input(this, InputTrace::StartNap);
+    dispatch(Event_StartNap);
 }
 
 void TimerEngine::stopNap() {
-    if (!m_isNapMode) return;
-    
-    m_isNapMode = false;
-    emit isNapModeChanged();
-    
-    // 计算午休时长（可选：记录统计）
-    qint64 napDuration = m_napStartTime.secsTo(QDateTime::currentDateTime());
-    qDebug() << "Nap finished. Duration:" << napDuration << "s";
-    
+    InputScope input(this, InputTrace::StopNap);
     // 午休结束后，默认开始新的一轮工作
-    startWork(); 
+    dispatch(Event_StopNap);
 }
 
 bool TimerEngine::isNapMode() const {
-    return m_isNapMode;
+    return m_state == Engine_Nap;
 }
 
 // -------------------------------------------------------------------------
 // Getter 函数实现 (直接返回成员变量)
 // -------------------------------------------------------------------------
 
-int TimerEngine::remainingSeconds() const { return m_remainingSecs; }
+int TimerEngine::remainingSeconds() const {
+    // 向上取整：剩余 0.4 秒时仍显示 1 秒，到期瞬间才显示 0
+    return int((remainingMs() + 999) / 1000);
+}
+
+QString TimerEngine::statusText() const { return statusTextFor(m_state); }
 
-QString TimerEngine::statusText() const { return m_status; }
+TimerEngine::EngineState TimerEngine::engineState() const { return m_state; }
 
 int TimerEngine::workDurationMinutes() const {
     return m_workDuration / 60; // 秒转换为分钟
@@ -99,19 +395,13 @@ int TimerEngine::currentSessionTotalTime() const {
     return m_currentSessionTotal;
 }
 
-// 计算预计完成时间 (ETA)
+// 预计完成时间 (ETA)，由 updateEstimatedFinishTime() 维护
 QString TimerEngine::estimatedFinishTime() const {
-    // 如果是暂停状态，无法计算 ETA
-    if (m_status == "已暂停") return "--:--";
-    
-    // QDateTime::currentDateTime() 获取系统当前时间
-    // addSecs() 加上剩余秒数，得到预计结束时间点
-    // toString("HH:mm") 格式化为 "小时:分钟" 字符串
-    return QDateTime::currentDateTime().addSecs(m_remainingSecs).toString("HH:mm");
+    return m_etaText;
 }
 
 bool TimerEngine::isRunning() const {
-    return m_timer->isActive();
+    return m_running;
 }
 
 // -------------------------------------------------------------------------
@@ -119,6 +409,7 @@ bool TimerEngine::isRunning() const {
 // -------------------------------------------------------------------------
 
 void TimerEngine::setWorkDurationMinutes(int minutes) {
+    InputScope input(this, InputTrace::SetWorkDuration, minutes);
     if (minutes < 1) minutes = 1; // 边界检查：至少1分钟
     
     int newDuration = minutes * 60;
@@ -137,94 +428,50 @@ void TimerEngine::setWorkDurationMinutes(int minutes) {
 }
 
 void TimerEngine::startWork() {
-    // 检查是否有休息记录 (如果之前是在休息状态)
-    if (m_breakStartTime.isValid()) {
-        // 计算休息了多少秒
-        qint64 duration = m_breakStartTime.secsTo(QDateTime::currentDateTime());
-        emit breakFinished((int)duration);
-        m_breakStartTime = QDateTime(); // 重置为无效时间
-    }
-
-    // 重置倒计时
-    m_remainingSecs = m_workDuration;
-    m_currentSessionTotal = m_workDuration; // 锁定本次会话的总时长 (用于进度条)
-    
-    // 发出信号通知前端更新
-    emit currentSessionTotalTimeChanged();
-    
-    m_status = "工作中";
-    emit statusChanged();
-    emit timeUpdated();
-    
-    setActivityState(State_Focus);
-
-    // 启动定时器 (如果还没启动)
-    if (!m_timer->isActive()) {
-        m_timer->start();
-        emit isRunningChanged();
-    }
+    InputScope input(this, InputTrace::StartWork);
+    dispatch(Event_StartWork);
 }
 
 // 贪睡功能：延迟 5 分钟提醒
 void TimerEngine::snooze() {
-    m_remainingSecs = m_snoozeDuration;
-    m_currentSessionTotal = m_snoozeDuration; // 进度条分母设为5分钟
-    emit currentSessionTotalTimeChanged();
-    
-    m_status = "稍后提醒";
-    emit statusChanged();
-    emit timeUpdated();
-    
-    setActivityState(State_Focus); // 贪睡本质上还是在倒计时（工作/拖延状态）
-
-    if (!m_timer->isActive()) {
-        m_timer->start();
-        emit isRunningChanged();
-    }
+    InputScope input(this, InputTrace::Snooze);
+    dispatch(Event_Snooze);
 }
 
 void TimerEngine::stop() {
-    bool wasRunning = m_timer->isActive();
-    m_timer->stop(); // 停止硬件定时器
-    m_status = "已暂停";
-    emit statusChanged();
-    if (wasRunning) emit isRunningChanged();
-    
-    m_pausedBySystem = false;
-    setActivityState(State_Pause);
+    InputScope input(this, InputTrace::Stop);
+    dispatch(Event_Stop);
 }
 
-// 智能暂停/恢复切换
+// 智能暂停/恢复切换：计时中 -> 暂停；已暂停 -> 继续；其他 (休息结束、准备就绪等) -> 开启新一轮工作
 void TimerEngine::togglePause() {
-    if (m_timer->isActive()) {
-        // 如果正在运行，则暂停
-        stop();
-    } else {
-        // 如果未运行
-        if (m_status == "已暂停") {
-            // 从暂停中恢复
-            m_status = "工作中";
-            emit statusChanged();
-            m_timer->start();
-            emit isRunningChanged();
-            setActivityState(State_Focus);
-        } else {
-            // 如果是其他状态（如休息结束、准备就绪），则开启新一轮工作
-            startWork();
-        }
-    }
+    InputScope input(this, InputTrace::TogglePause);
+    dispatch(Event_TogglePause);
 }
 
 // ========================================================================
 // 数据统计相关实现
 // ========================================================================
 
+std::unique_ptr<QSettings> TimerEngine::openStats() const {
+    if (m_statsFile.isEmpty()) return std::unique_ptr<QSettings>(new QSettings("DeskCare", "Stats"));
+    return std::unique_ptr<QSettings>(new QSettings(m_statsFile, QSettings::IniFormat));
+}
+
 // 记录一次运动时长
 void TimerEngine::recordExercise(int durationSeconds) {
+    InputScope input(this, InputTrace::RecordExercise, durationSeconds);
     if (durationSeconds <= 0) return;
 
-    QSettings settings("DeskCare", "Stats");
-    QDateTime now = QDateTime::currentDateTime();
+    if (!m_persistStats) {
+        // 回放/模拟：只通知 ActivityLogger
+        emit exerciseRecorded(durationSeconds);
+        return;
+    }
+
+    const std::unique_ptr<QSettings> stats = openStats();
+    QSettings& settings = *stats;
+    QDateTime now = m_clock->now();
     QString today = now.toString("yyyy-MM-dd");
     
     // 1. 更新每日总时长
@@ -248,28 +495,31 @@ void TimerEngine::recordExercise(int durationSeconds) {
     // 强制同步以确保写入磁盘
     settings.sync();
     
-    qDebug() << "Recorded exercise:" << durationSeconds << "s. Today total:" << (current + durationSeconds);
+    qCDebug(lcEngine) << "Recorded exercise:" << durationSeconds << "s. Today total:" << (current + durationSeconds);
 
     // 发出信号通知 ActivityLogger 同步记录
     emit exerciseRecorded(durationSeconds);
 }
 
 int TimerEngine::getTodayExerciseSeconds() {
-    QSettings settings("DeskCare", "Stats");
-    QString today = QDate::currentDate().toString("yyyy-MM-dd");
+    const std::unique_ptr<QSettings> stats = openStats();
+    QSettings& settings = *stats;
+    QString today = m_clock->now().date().toString("yyyy-MM-dd");
     return settings.value(today, 0).toInt();
 }
 
 QVariantList TimerEngine::getTodaySessions() {
-    QSettings settings("DeskCare", "Stats");
-    QString todayKey = "Sessions/" + QDate::currentDate().toString("yyyy-MM-dd");
+    const std::unique_ptr<QSettings> stats = openStats();
+    QSettings& settings = *stats;
+    QString todayKey = "Sessions/" + m_clock->now().date().toString("yyyy-MM-dd");
     return settings.value(todayKey).toList();
 }
 
 QVariantList TimerEngine::getWeeklyExerciseStats() {
-    QSettings settings("DeskCare", "Stats");
+    const std::unique_ptr<QSettings> stats = openStats();
+    QSettings& settings = *stats;
     QVariantList list;
-    QDate today = QDate::currentDate();
+    QDate today = m_clock->now().date();
     
     // 获取过去7天的数据 (包括今天)
     for (int i = 6; i >= 0; --i) {
@@ -293,47 +543,66 @@ QVariantList TimerEngine::getWeeklyExerciseStats() {
 }
 
 void TimerEngine::handleSystemLock(bool locked) {
-    if (locked) {
-        // 系统锁屏
-        if (m_timer->isActive()) {
-            // 如果当前正在计时，则暂停并标记
-            m_timer->stop();
-            m_pausedBySystem = true;
-            qDebug() << "System locked: Timer paused automatically.";
-            // 这里不改变 m_status，让用户感觉只是时间冻结了
-            setActivityState(State_Pause);
-        }
-    } else {
-        // 系统解锁
-        if (m_pausedBySystem) {
-            // 如果之前是因为锁屏而暂停的，则恢复计时
-            m_timer->start();
-            m_pausedBySystem = false;
-            qDebug() << "System unlocked: Timer resumed automatically.";
-            setActivityState(State_Focus);
-        }
+    InputScope input(this, locked ? InputTrace::SystemLock : InputTrace::SystemUnlock);
+    // 锁屏只暂停计时中的状态；解锁只恢复因锁屏而暂停的状态 (均由迁移表决定)
+    if (dispatch(locked ? Event_Lock : Event_Unlock)) {
+        qCDebug(lcEngine) << (locked ? "System locked: Timer paused automatically."
+                            : "System unlocked: Timer resumed automatically.");
     }
 }
 
-// 定时器回调函数 (每秒执行一次)
+// 显示刷新 (每秒执行一次)
 void TimerEngine::onTick() {
-    if (m_remainingSecs > 0) {
-        m_remainingSecs--;
-        // 触发 timeUpdated 信号，QML 界面收到后会更新剩余时间和进度条
-        emit timeUpdated();
-    } else {
-        // 倒计时结束
-        m_timer->stop();
-        m_status = "请休息";
-        
-        // 记录休息开始时间
-        m_breakStartTime = QDateTime::currentDateTime();
-        
-        emit statusChanged();
-        
-        // 触发核心提醒信号 -> 将导致全屏窗口弹出
-        emit reminderTriggered();
-        
-        setActivityState(State_Rest);
+    // 定时器实际触发相对预定时刻的延迟 (事件循环阻塞、系统定时器合并等)
+    static MetricHistogram *s_tickLateness = Metrics::instance()->histogram("engine.tickLateness");
+    s_tickLateness->record((m_clock->monotonicMs() - m_tickDueMs) * 1000);
+
+    // 睡眠恢复或事件循环长时间阻塞后，截止时间可能已经过去
+    if (remainingMs() <= 0) {
+        onDeadline();
+        return;
+    }
+    // 触发 timeUpdated 信号，QML 界面收到后会更新剩余时间和进度条
+    updateEstimatedFinishTime();
+    emit timeUpdated();
+    scheduleTick();
+}
+
+// 截止时间到达
+void TimerEngine::onDeadline() {
+    if (!m_running) return;
+
+    const qint64 left = remainingMs();
+    if (left > 0) {
+        // 分段等待或定时器提前触发 (时钟源不一致)，按剩余时间重新设置
+        m_deadlineTimer->start(qMin<qint64>(left, DEADLINE_SLICE_MS));
+        return;
     }
+
+    // 倒计时结束 (会议中则先顺延)
+    if (deferForMeeting()) return;
+    dispatch(Event_Deadline);
+}
+
+bool TimerEngine::deferForMeeting() {
+    if (!m_calendar) return false;
+
+    // 日历按墙钟时间记录，二分查找当前所在会议的结束时刻
+    const qint64 now = m_clock->now().toMSecsSinceEpoch();
+    const qint64 freeAt = m_calendar->nextFreeSlot(now);
+    if (freeAt <= now) return false;
+
+    // 状态不变，只是以会议剩余时长重新开始倒计时 (进度条分母随之调整)
+    const qint64 delayMs = freeAt - now;
+    m_deferredUntil = QDateTime::fromMSecsSinceEpoch(freeAt);
+    m_currentSessionTotal = int((delayMs + 999) / 1000);
+    emit currentSessionTotalTimeChanged();
+    armDeadline(delayMs);
+    emit timeUpdated();
+
+    qCDebug(lcEngine) << "Meeting in progress: reminder deferred until" << m_deferredUntil;
+    // 顺延取决于日历文件而非用户输入，回放时无从得知，单独录制
+    if (m_recorder) m_recorder->record(InputTrace::MeetingDeferred, delayMs);
+    emit reminderDeferred(m_deferredUntil);
+    return true;
 }
@@ -1,13 +1,26 @@
 #pragma once
 #include <QObject>
-#include <QTimer>
 #include <QDateTime>
+#include <QHash>
+#include "Clock.h"
+#include "InputTrace.h"
+#include "Calendar.h"
 #include <QVariant> // 添加 QVariant 头文件以支持 QVariantList
+#include <memory>
+
+class QSettings;
 
 // ========================================================================
 // TimerEngine 类：核心业务逻辑引擎
 // ========================================================================
 // 作用：负责倒计时、状态管理（工作中、休息中、暂停等）以及进度计算。
+// 计时方式：运行时只记录一个绝对截止时间 (单调时钟，包含系统睡眠时间)，
+// 剩余时间按需计算；到期由一个 PreciseTimer 单次定时器触发。
+// 每秒的显示刷新只负责通知界面，不参与计时，因此负载抖动不会累积误差，
+// 系统从睡眠中恢复后会直接跳到正确的状态。
+// 显示刷新按需进行：界面/托盘通过 requestDisplay() 申请刷新精度，
+// 引擎只在有人需要时才唤醒 (全部隐藏时只剩截止时间定时器)。
+// 挂接日历 (setCalendar) 后，会议中到期的提醒自动顺延到会议结束。
 // 继承：QObject 是所有 Qt 对象的基类，提供了信号与槽、属性系统、事件处理等核心功能。
 // ========================================================================
 class TimerEngine : public QObject
@@ -30,6 +43,42 @@ public:
     };
     Q_ENUM(ActivityState)
 
+    // 引擎状态 (状态机的状态，比 ActivityState 更细：区分贪睡与锁屏暂停)
+    enum EngineState {
+        Engine_Ready = 0,      // 准备就绪
+        Engine_Working,        // 工作中
+        Engine_Snoozed,        // 稍后提醒 (贪睡倒计时)
+        Engine_Paused,         // 已暂停 (用户操作)
+        Engine_LockedWorking,  // 锁屏自动暂停 (锁屏前为工作中)
+        Engine_LockedSnoozed,  // 锁屏自动暂停 (锁屏前为贪睡)
+        Engine_Break,          // 请休息
+        Engine_Nap,            // 午休中
+        Engine_StateCount
+    };
+    Q_ENUM(EngineState)
+
+    // 状态机事件
+    enum EngineEvent {
+        Event_StartWork = 0,
+        Event_Snooze,
+        Event_Stop,
+        Event_TogglePause,
+        Event_Lock,
+        Event_Unlock,
+        Event_Deadline,
+        Event_StartNap,
+        Event_StopNap,
+        Event_Count
+    };
+
+    // 显示刷新精度 (数值越小越精细)
+    enum DisplayResolution {
+        Display_Second = 0,   // 每秒刷新 (倒计时数字可见)
+        Display_Minute,       // 每分钟刷新 (托盘提示等)
+        Display_DeadlineOnly  // 不需要刷新，只关心到期
+    };
+    Q_ENUM(DisplayResolution)
+
     // ========================================================================
     // Q_PROPERTY 属性系统
     // ========================================================================
@@ -45,15 +94,19 @@ public:
     // 1. 剩余秒数 (只读)
     Q_PROPERTY(int remainingSeconds READ remainingSeconds NOTIFY timeUpdated)
     
-    // 2. 当前状态描述 (只读，如 "工作中", "请休息")
+    // 2. 当前状态描述 (只读，如 "工作中", "请休息")，仅用于显示
     Q_PROPERTY(QString statusText READ statusText NOTIFY statusChanged)
+
+    // 2.1 引擎状态 (用于界面逻辑判断，取代比较 statusText)
+    Q_PROPERTY(EngineState engineState READ engineState NOTIFY statusChanged)
     
     // 3. 工作间隔 (读写，单位：分钟)
     // QML 可以读取当前设置，也可以修改它。修改后会触发 workDurationMinutesChanged 信号。
     Q_PROPERTY(int workDurationMinutes READ workDurationMinutes WRITE setWorkDurationMinutes NOTIFY workDurationMinutesChanged)
     
     // 4. 预计完成时间 (只读，格式 "HH:mm")
-    Q_PROPERTY(QString estimatedFinishTime READ estimatedFinishTime NOTIFY timeUpdated)
+    // 结果已缓存，只在分钟变化时更新
+    Q_PROPERTY(QString estimatedFinishTime READ estimatedFinishTime NOTIFY estimatedFinishTimeChanged)
 
     // 5. 当前会话总时长 (只读，单位：秒)
     // 用于进度条计算：progress = remainingSeconds / currentSessionTotalTime
@@ -70,17 +123,50 @@ public:
     // parent: 父对象指针。Qt 使用对象树机制管理内存。
     // 当父对象被销毁时，所有子对象会自动被销毁，防止内存泄漏。
     explicit TimerEngine(QObject *parent = nullptr);
+    // 使用指定的时钟 (例如 VirtualClock)，clock 的生命周期需长于引擎
+    explicit TimerEngine(Clock *clock, QObject *parent = nullptr);
+
+    // 引擎使用的时钟 (ActivityLogger、ReminderScheduler 与之共用)
+    Clock* clock() const { return m_clock; }
+
+    // 挂接输入录制器 (不转移所有权，nullptr 表示停止录制)
+    void setInputRecorder(InputTraceRecorder* recorder) { m_recorder = recorder; }
+
+    // 是否把运动记录写入 QSettings (回放/模拟时关闭，避免污染真实统计)
+    void setPersistStats(bool persist) { m_persistStats = persist; }
+    // 运动统计改存到指定的 INI 文件 (基准测试等使用临时文件)；为空时使用
+    // QSettings("DeskCare", "Stats")
+    void setStatsFile(const QString& path) { m_statsFile = path; }
+
+    // 挂接日历忙碌时段 (不转移所有权)：倒计时在会议中到期时顺延到会议结束
+    void setCalendar(const CalendarIndex* calendar) { m_calendar = calendar; }
+    const CalendarIndex* calendar() const { return m_calendar; }
+
+    // 当前倒计时因会议顺延到的时刻 (未顺延时无效)
+    QDateTime deferredUntil() const { return m_deferredUntil; }
+
+    // 剩余毫秒数 (未运行时为冻结值)，录制 trace 头部时使用
+    qint64 remainingMs() const;
+    // 回放用：把新建的引擎直接置于录制开始时的状态 (不经过迁移表，不录制)
+    void restoreState(EngineState state, int workDurationSecs, qint64 remainingMs);
 
     // Getter 函数 (对应 Q_PROPERTY 的 READ)
     ActivityState currentActivityState() const;
     int remainingSeconds() const;
     QString statusText() const;
+    EngineState engineState() const;
     int workDurationMinutes() const;
     QString estimatedFinishTime() const;
     int currentSessionTotalTime() const;
     bool isNapMode() const;
     bool isRunning() const;
 
+    // 显示需求：consumer 为任意唯一名称 (如 "mainWindow"、"tray")，
+    // resolution 取 DisplayResolution。引擎按所有需求中最精细的一项刷新。
+    Q_INVOKABLE void requestDisplay(const QString& consumer, int resolution);
+    Q_INVOKABLE void releaseDisplay(const QString& consumer);
+    DisplayResolution displayResolution() const { return m_displayResolution; }
+
 // ========================================================================
 // Slots (槽函数)
 // ========================================================================
@@ -136,14 +222,20 @@ public slots:
 // 只需要在头文件中声明，不需要在 .cpp 中实现 (MOC 会自动生成实现)。
 // 使用 emit 关键字触发信号，例如: emit timeUpdated();
 signals:
-    // 时间更新信号（每秒触发一次，用于刷新倒计时显示）
+    // 时间更新信号（按当前显示精度触发，用于刷新倒计时显示）
     void timeUpdated();
+
+    // 预计完成时间变更信号
+    void estimatedFinishTimeChanged();
     
     // 状态改变信号（当从“工作中”变为“休息中”等情况触发）
     void statusChanged();
     
     // 倒计时结束，触发提醒（用于显示全屏覆盖窗口）
     void reminderTriggered();
+
+    // 倒计时在会议中到期，提醒顺延到 until (会议结束)
+    void reminderDeferred(const QDateTime& until);
     
     // 工作间隔变更信号
     void workDurationMinutesChanged();
@@ -167,24 +259,66 @@ signals:
     void activityStateChanged(ActivityState newState);
 
 private slots:
-    // 内部槽函数：处理 QTimer 的每秒超时事件
+    // 内部槽函数：按显示精度刷新，并检查是否已越过截止时间 (睡眠恢复后)
     void onTick();
+    // 内部槽函数：截止时间到达
+    void onDeadline();
 
 private:
+    // 外部输入作用域：只录制最外层调用 (例如 togglePause 内部调用的 stop 不重复录制)
+    class InputScope;
+
+    // 按迁移表处理事件，事件在当前状态下无效时返回 false
+    bool dispatch(EngineEvent event);
+    // 状态对应的显示文本 (静态表，不分配内存)
+    static const QString& statusTextFor(EngineState state);
+
+    // 以 remainingMs 为剩余时间开始/继续计时 (设置截止时间并启动定时器)
+    void armDeadline(qint64 remainingMs);
+    // 停止计时，冻结剩余时间
+    void disarmDeadline();
+    // 按当前显示精度安排下一次刷新 (对齐到显示值变化的时刻)
+    void scheduleTick();
+    // 正处于会议中则把倒计时顺延到会议结束，返回是否已顺延
+    bool deferForMeeting();
+    // 重新计算 ETA 缓存 (同一分钟内不重复格式化)
+    void updateEstimatedFinishTime();
+
     // 成员变量
-    QTimer *m_timer;      // Qt 定时器对象
-    int m_remainingSecs;  // 剩余秒数
+    Clock *m_clock;               // 时间来源 (默认 Clock::system())
+    ClockTimer *m_deadlineTimer;  // 截止时间定时器 (单次)
+    ClockTimer *m_tickTimer;      // 显示刷新定时器 (单次，按需安排)
+    qint64 m_tickDueMs = 0;       // 显示刷新的预定时刻 (统计触发延迟)
+    bool m_running = false;
+    qint64 m_deadlineMs = 0;        // 运行时：截止时间 (m_clock 单调时间轴)
+    qint64 m_pausedRemainingMs = 0; // 未运行时：冻结的剩余毫秒数
+    // 截止时间定时器单次最长等待：单调时钟在部分平台上不计睡眠时间，
+    // 分段等待可保证即使无人需要显示刷新，恢复后也能及时到期
+    static const int DEADLINE_SLICE_MS = 5 * 60 * 1000;
+
+    QHash<QString, DisplayResolution> m_displayDemands;
+    DisplayResolution m_displayResolution = Display_DeadlineOnly;
+    QString m_etaText = "--:--";
+    qint64 m_etaMinute = -2; // 缓存对应的分钟序号 (-1 表示暂停)
     int m_workDuration;   // 设定的工作时长 (单位：秒)
     int m_currentSessionTotal; // 当前正在进行的会话总时长 (用于进度条分母，防止中途修改设置导致进度条跳变)
     
     const int m_snoozeDuration = 5 * 60; // 贪睡时长常量 (5分钟)
-    QString m_status;     // 当前状态文本
+    EngineState m_state = Engine_Ready; // 当前状态 (状态文本由此派生)
     QDateTime m_breakStartTime; // 休息开始时间点 (用于计算休息了多久)
 
-    bool m_pausedBySystem = false; // 标记是否因系统锁屏而暂停
-    bool m_isNapMode = false; // 午休模式状态
     QDateTime m_napStartTime; // 记录午休开始时间 (用于统计午休时长)
 
+    const CalendarIndex* m_calendar = nullptr;
+    QDateTime m_deferredUntil;
+
+    InputTraceRecorder* m_recorder = nullptr;
+    int m_inputDepth = 0;
+    bool m_persistStats = true;
+    QString m_statsFile;
+    // 打开运动统计的存储 (见 setStatsFile)
+    std::unique_ptr<QSettings> openStats() const;
+
     ActivityState m_activityState = State_Ready;
     void setActivityState(ActivityState state);
 };
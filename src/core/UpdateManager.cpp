@@ -3,11 +3,11 @@
 # pragma execution_character_set("utf-8")
 #endif
 #include "Version.h"
+#include "Logging.h"
 #include <QJsonDocument>
 #include <QFile>
 #include <QDir>
 #include <QStandardPaths>
-#include <QDebug>
 #include <QCoreApplication>
 #include <QProcess>
 
@@ -33,13 +33,13 @@ QString UpdateManager::currentVersion() const
 
 void UpdateManager::checkForUpdates(bool silent)
 {
-    qDebug() << "[UpdateManager] checkForUpdates called. Silent:" << silent;
+    qCDebug(lcUpdate) << "checkForUpdates called. Silent:" << silent;
 
     // Prevent crash: If a request is running, disconnect it before aborting
     // This ensures onVersionCheckFinished is NOT called, preventing double-deletion
     // and accessing m_currentReply after it has been set to nullptr.
     if (m_currentReply) {
-        qDebug() << "[UpdateManager] Aborting pending request.";
+        qCDebug(lcUpdate) << "Aborting pending request.";
         m_currentReply->disconnect(this);
         m_currentReply->abort();
         m_currentReply->deleteLater();
@@ -68,7 +68,7 @@ void UpdateManager::resetStatus()
 void UpdateManager::onVersionCheckFinished()
 {
     if (!m_currentReply) {
-        qDebug() << "[UpdateManager] onVersionCheckFinished called but m_currentReply is null (aborted?)";
+        qCDebug(lcUpdate) << "onVersionCheckFinished called but m_currentReply is null (aborted?)";
         return;
     }
     
@@ -79,7 +79,7 @@ void UpdateManager::onVersionCheckFinished()
     reply->deleteLater();
     
     if (reply->error() != QNetworkReply::NoError) {
-        qDebug() << "[UpdateManager] Network error:" << reply->errorString();
+        qCWarning(lcUpdate) << "Network error:" << reply->errorString();
         if (!m_silentCheck) {
             emit updateError("检查更新失败: " + reply->errorString());
         }
@@ -91,7 +91,7 @@ void UpdateManager::onVersionCheckFinished()
     QJsonDocument doc = QJsonDocument::fromJson(data, &parseError);
     
     if (parseError.error != QJsonParseError::NoError) {
-        qDebug() << "[UpdateManager] JSON parse error:" << parseError.errorString();
+        qCWarning(lcUpdate) << "JSON parse error:" << parseError.errorString();
         if (!m_silentCheck) {
             emit updateError("无法解析版本信息: " + parseError.errorString());
         }
@@ -101,7 +101,7 @@ void UpdateManager::onVersionCheckFinished()
     QJsonObject obj = doc.object();
     
     // Debug: Print full JSON response
-    qDebug() << "[UpdateManager] Received JSON:" << doc.toJson(QJsonDocument::Compact);
+    qCDebug(lcUpdate) << "Received JSON:" << doc.toJson(QJsonDocument::Compact);
 
     // Support both "version" and "latest_version" fields
     QString remoteVersion = obj["version"].toString();
@@ -113,14 +113,14 @@ void UpdateManager::onVersionCheckFinished()
     QString downloadUrl = obj["download_url"].toString();
     
     if (remoteVersion.isEmpty()) {
-        qDebug() << "[UpdateManager] Remote version is empty.";
+        qCDebug(lcUpdate) << "Remote version is empty.";
         if (!m_silentCheck) {
             emit updateError("版本信息无效");
         }
         return;
     }
 
-    qDebug() << "[UpdateManager] Remote version:" << remoteVersion << "Local:" << Version::getCurrentVersion();
+    qCDebug(lcUpdate) << "Remote version:" << remoteVersion << "Local:" << Version::getCurrentVersion();
 
     if (isNewerVersion(remoteVersion, Version::getCurrentVersion())) {
         m_hasUpdate = true;
@@ -237,7 +237,7 @@ void UpdateManager::startInstall()
     arguments << QCoreApplication::applicationDirPath(); // Install dir
     arguments << "DeskCare.exe"; // Exe name (to restart)
 
-    qDebug() << "Starting Updater:" << program << arguments;
+    qCDebug(lcUpdate) << "Starting Updater:" << program << arguments;
 
     if (!QProcess::startDetached(program, arguments)) {
         emit updateError("无法启动更新程序");
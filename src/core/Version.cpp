@@ -1,9 +1,9 @@
 #include "Version.h"
+#include "Logging.h"
 #include <QFile>
 #include <QJsonDocument>
 #include <QJsonObject>
 #include <QCoreApplication>
-#include <QDebug>
 #include <QDir>
 
 QString Version::getCurrentVersion()
@@ -38,7 +38,7 @@ QString Version::getCurrentVersion()
                     int minor = obj["minor"].toInt();
                     int patch = obj["patch"].toInt();
                     versionString = QString("%1.%2.%3").arg(major).arg(minor).arg(patch);
-                    qDebug() << "Loaded version from:" << path << "Version:" << versionString;
+                    qCDebug(lcUpdate) << "Loaded version from:" << path << "Version:" << versionString;
                     versionCache = versionString;
                     return versionString;
                 }
@@ -47,7 +47,7 @@ QString Version::getCurrentVersion()
         }
     }
 
-    qWarning() << "Could not load version_info.json from any search path. Using default:" << versionString;
+    qCWarning(lcUpdate) << "Could not load version_info.json from any search path. Using default:" << versionString;
     versionCache = versionString;
     return versionString;
 }
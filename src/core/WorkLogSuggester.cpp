@@ -0,0 +1,261 @@
+#include "WorkLogSuggester.h"
+#include "ActivityLogger.h"
+#include "Logging.h"
+#include <QThread>
+#include <QSqlDatabase>
+#include <QSqlQuery>
+#include <QSqlError>
+#include <QJsonDocument>
+#include <QJsonObject>
+#include <QDateTime>
+#include <algorithm>
+#include <cmath>
+
+namespace {
+// 得分参考时间点与半衰期：30 天前的一次使用约等于今天的半次使用
+const qint64 kScoreEpochSecs = 1767225600; // 2026-01-01 00:00:00 UTC
+const double kHalfLifeSecs = 30.0 * 24 * 3600;
+const int kCategoryCount = 3;
+}
+
+WorkLogSuggester::WorkLogSuggester(ActivityLogger* logger, QObject *parent)
+    : QObject(parent), m_logger(logger)
+{
+    m_indexes.resize(kCategoryCount);
+
+    if (m_logger) {
+        connect(m_logger, &ActivityLogger::activityContentUpdated, this, &WorkLogSuggester::onContentUpdated);
+    }
+}
+
+WorkLogSuggester::~WorkLogSuggester() {
+    // 后台构建线程持有独立的数据库连接，必须等待其结束
+    if (m_buildThread) {
+        m_buildThread->wait();
+    }
+}
+
+void WorkLogSuggester::prepare() {
+    if (m_ready || m_building || !m_logger) return;
+
+    // 往年归档库 + 当年主库 (按年份升序，保证 lastUsed 时间递增)
+    const QStringList dbPaths = m_logger->store()->databaseFiles();
+
+    m_building = true;
+    QSharedPointer<QVector<Index>> built(new QVector<Index>(kCategoryCount));
+
+    if (dbPaths.isEmpty()) {
+        // 非文件型后端 (如内存存储)：直接在当前线程扫描
+        ActivityQuery query;
+        query.hasContent = true;
+        const QVector<ActivityRecord> records = m_logger->store()->scan(query);
+        for (const ActivityRecord& record : records) {
+            const auto parts = splitContent(record.content, record.workType);
+            for (const auto& part : parts) {
+                (*built)[part.first].add(part.second, record.endTime);
+            }
+        }
+        applyBuilt(built);
+        return;
+    }
+
+    m_buildThread = QThread::create([dbPaths, built]() {
+        const QString connName = "WorkLogSuggester_build";
+        for (const QString& dbPath : dbPaths) {
+            {
+                // SQLite 连接不能跨线程使用，这里单独打开一个只读连接
+                QSqlDatabase db = QSqlDatabase::addDatabase("QSQLITE", connName);
+                db.setDatabaseName(dbPath);
+                db.setConnectOptions("QSQLITE_OPEN_READONLY");
+                if (!db.open()) {
+                    qCWarning(lcDb) << "WorkLogSuggester: failed to open database:" << dbPath << db.lastError();
+                } else {
+                    QSqlQuery query(db);
+                    query.setForwardOnly(true);
+                    if (query.exec("SELECT content, work_type, end_time FROM activity_log WHERE content IS NOT NULL AND content != '' ORDER BY end_time ASC")) {
+                        while (query.next()) {
+                            qint64 usedAt = query.value(2).toLongLong();
+                            const auto parts = splitContent(query.value(0).toString(), query.value(1).toInt());
+                            for (const auto& part : parts) {
+                                (*built)[part.first].add(part.second, usedAt);
+                            }
+                        }
+                    } else {
+                        qCWarning(lcDb) << "WorkLogSuggester: history query failed:" << query.lastError();
+                    }
+                    db.close();
+                }
+            }
+            QSqlDatabase::removeDatabase(connName);
+        }
+    });
+    m_buildThread->setParent(this);
+
+    connect(m_buildThread, &QThread::finished, this, [this, built]() {
+        m_buildThread->deleteLater();
+        m_buildThread = nullptr;
+        applyBuilt(built);
+    });
+
+    m_buildThread->start(QThread::LowPriority);
+}
+
+void WorkLogSuggester::applyBuilt(QSharedPointer<QVector<Index>> built) {
+    m_indexes = *built;
+
+    qint64 now = QDateTime::currentSecsSinceEpoch();
+    for (const auto& update : m_pendingUpdates) {
+        m_indexes[update.second].add(update.first, now);
+    }
+    m_pendingUpdates.clear();
+
+    m_building = false;
+    m_ready = true;
+    emit readyChanged();
+
+    qCDebug(lcDb) << "WorkLogSuggester: index ready. Entries:"
+             << m_indexes[0].entries.size() << m_indexes[1].entries.size() << m_indexes[2].entries.size();
+}
+
+QStringList WorkLogSuggester::suggest(const QString& prefix, int category, int limit) const {
+    QStringList result;
+    if (!m_ready || category < 0 || category >= kCategoryCount || limit <= 0) return result;
+
+    QString key = normalize(prefix);
+    if (key.isEmpty()) return result;
+
+    const Index::Node* node = m_indexes[category].find(key);
+    if (!node) return result;
+
+    const auto& entries = m_indexes[category].entries;
+    for (int idx : node->top) {
+        // 已经完整输入的内容不必再提示
+        if (entries[idx].key == key) continue;
+        result.append(entries[idx].text);
+        if (result.size() >= limit) break;
+    }
+    return result;
+}
+
+void WorkLogSuggester::onContentUpdated(int id, const QString& content, int workType) {
+    Q_UNUSED(id);
+
+    // 尚未构建过索引：构建时会从数据库读到这条内容
+    if (!m_ready && !m_building) return;
+
+    const auto parts = splitContent(content, workType);
+    if (m_building) {
+        for (const auto& part : parts) {
+            m_pendingUpdates.append(qMakePair(part.second, part.first));
+        }
+        return;
+    }
+
+    qint64 now = QDateTime::currentSecsSinceEpoch();
+    for (const auto& part : parts) {
+        m_indexes[part.first].add(part.second, now);
+    }
+}
+
+QVector<QPair<int, QString>> WorkLogSuggester::splitContent(const QString& content, int workType) {
+    QVector<QPair<int, QString>> parts;
+
+    auto appendLines = [&parts](int category, const QString& text) {
+        const QStringList lines = text.split('\n', Qt::SkipEmptyParts);
+        for (const QString& line : lines) {
+            QString trimmed = line.trimmed();
+            if (!trimmed.isEmpty()) parts.append(qMakePair(category, trimmed));
+        }
+    };
+
+    if (content.trimmed().startsWith("{")) {
+        // 新版格式: {"formal":"...", "learning":"...", "personal":"..."}
+        QJsonObject obj = QJsonDocument::fromJson(content.toUtf8()).object();
+        appendLines(0, obj.value("formal").toString());
+        appendLines(1, obj.value("learning").toString());
+        appendLines(2, obj.value("personal").toString());
+    } else {
+        // 旧版纯文本：按 workType 归类 (0: Formal, 1: Learning, 2: Personal)
+        int category = (workType == 1 || workType == 2) ? workType : 0;
+        appendLines(category, content);
+    }
+    return parts;
+}
+
+QString WorkLogSuggester::normalize(const QString& text) {
+    return text.simplified().toLower();
+}
+
+double WorkLogSuggester::scoreOf(int count, qint64 lastUsed) {
+    // log(频次 × 2^((lastUsed - epoch) / halfLife))，避免随时间重新计算衰减
+    return std::log(double(count)) + double(lastUsed - kScoreEpochSecs) / kHalfLifeSecs * std::log(2.0);
+}
+
+// ========================================================================
+// Index 实现
+// ========================================================================
+
+void WorkLogSuggester::Index::add(const QString& text, qint64 usedAt) {
+    QString key = normalize(text);
+    if (key.isEmpty()) return;
+
+    int idx = entryByKey.value(key, -1);
+    if (idx < 0) {
+        idx = entries.size();
+        Entry entry;
+        entry.key = key;
+        entries.append(entry);
+        entryByKey.insert(key, idx);
+    }
+
+    Entry& entry = entries[idx];
+    entry.text = text.simplified(); // 保留最近一次的写法
+    entry.count++;
+    entry.lastUsed = qMax(entry.lastUsed, usedAt);
+    entry.score = scoreOf(entry.count, entry.lastUsed);
+    const double score = entry.score;
+
+    // 得分只增不减，因此沿路径把该条目插入/上移到各节点的 top 列表即可
+    auto updateTop = [this, idx, score](int nodeIdx) {
+        QVector<int>& top = nodes[nodeIdx].top;
+        top.removeOne(idx);
+        auto pos = std::find_if(top.begin(), top.end(), [this, score](int other) {
+            return entries[other].score < score;
+        });
+        top.insert(pos, idx);
+        if (top.size() > TOP_K) top.resize(TOP_K);
+    };
+
+    int nodeIdx = 0;
+    const int depth = qMin(key.size(), int(MAX_KEY_LENGTH));
+    for (int i = 0; i < depth; ++i) {
+        const QChar c = key.at(i);
+        auto& children = nodes[nodeIdx].children;
+        auto it = std::lower_bound(children.begin(), children.end(), c,
+                                   [](const QPair<QChar, int>& child, QChar ch) { return child.first < ch; });
+        int next;
+        if (it != children.end() && it->first == c) {
+            next = it->second;
+        } else {
+            next = nodes.size();
+            children.insert(it, qMakePair(c, next));
+            nodes.append(Node()); // 注意：append 之后不能再使用 children 引用
+        }
+        nodeIdx = next;
+        updateTop(nodeIdx);
+    }
+}
+
+const WorkLogSuggester::Index::Node* WorkLogSuggester::Index::find(const QString& key) const {
+    int nodeIdx = 0;
+    const int depth = qMin(key.size(), int(MAX_KEY_LENGTH));
+    for (int i = 0; i < depth; ++i) {
+        const QChar c = key.at(i);
+        const auto& children = nodes[nodeIdx].children;
+        auto it = std::lower_bound(children.begin(), children.end(), c,
+                                   [](const QPair<QChar, int>& child, QChar ch) { return child.first < ch; });
+        if (it == children.end() || it->first != c) return nullptr;
+        nodeIdx = it->second;
+    }
+    return &nodes[nodeIdx];
+}
@@ -0,0 +1,86 @@
+#pragma once
+
+#include <QObject>
+#include <QHash>
+#include <QVector>
+#include <QStringList>
+#include <QSharedPointer>
+
+class ActivityLogger;
+class QThread;
+
+// ========================================================================
+// WorkLogSuggester 类：工时日志输入联想
+// ========================================================================
+// 作用：根据历史 content 记录，为 WorkLogDialog 提供前缀联想。
+// 原理：每个分类 (正式/学习/私人) 一棵前缀树 (Trie)，每个节点预先缓存
+// 得分最高的 K 条候选，查询时只需沿前缀走到节点并读取缓存列表，与历史条数无关。
+// 得分 = 使用频次 × 时间衰减 (以对数形式存储，随新使用单调递增，便于增量维护)。
+// 索引在首次需要时于后台线程构建，之后随 updateActivityContent 增量更新。
+// ========================================================================
+class WorkLogSuggester : public QObject {
+    Q_OBJECT
+    Q_PROPERTY(bool ready READ isReady NOTIFY readyChanged)
+
+public:
+    explicit WorkLogSuggester(ActivityLogger* logger, QObject *parent = nullptr);
+    ~WorkLogSuggester();
+
+    bool isReady() const { return m_ready; }
+
+    // 触发后台构建索引 (幂等，打开录入对话框时调用)
+    Q_INVOKABLE void prepare();
+
+    // 返回以 prefix 开头的候选 (按得分降序)
+    // category: 0=正式工作, 1=学习成长, 2=私人事务
+    Q_INVOKABLE QStringList suggest(const QString& prefix, int category, int limit = 5) const;
+
+    // 单棵前缀树 (公开以便后台线程直接构建)
+    struct Index {
+        struct Entry {
+            QString text;       // 原始文本 (用于显示)
+            QString key;        // 归一化文本 (用于去重)
+            int count = 0;      // 使用次数
+            qint64 lastUsed = 0; // 最近使用时间 (秒)
+            double score = 0.0;  // 对数得分
+        };
+        struct Node {
+            QVector<QPair<QChar, int>> children; // 按字符排序，二分查找
+            QVector<int> top;                    // 得分最高的候选 (Entry 下标)
+        };
+
+        QVector<Entry> entries;
+        QVector<Node> nodes;
+        QHash<QString, int> entryByKey; // 归一化文本 -> Entry 下标
+
+        Index() { nodes.append(Node()); } // 0 号节点为根
+        void add(const QString& text, qint64 usedAt);
+        const Node* find(const QString& key) const;
+    };
+
+signals:
+    void readyChanged();
+
+private slots:
+    void onContentUpdated(int id, const QString& content, int workType);
+
+private:
+    // 将 content (JSON 三栏或旧版纯文本) 拆分为 (分类, 单行文本)
+    static QVector<QPair<int, QString>> splitContent(const QString& content, int workType);
+    static QString normalize(const QString& text);
+    static double scoreOf(int count, qint64 lastUsed);
+
+    void applyBuilt(QSharedPointer<QVector<Index>> built);
+
+    ActivityLogger* m_logger;
+    QVector<Index> m_indexes; // 每个分类一棵树
+    bool m_ready = false;
+    bool m_building = false;
+    QThread* m_buildThread = nullptr;
+
+    // 构建期间到达的新内容，构建完成后再补充进索引
+    QVector<QPair<QString, int>> m_pendingUpdates;
+
+    static const int TOP_K = 8;
+    static const int MAX_KEY_LENGTH = 64;
+};
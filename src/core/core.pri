@@ -0,0 +1,15 @@
+# 链接 DeskCare 核心静态库 (在使用方的 .pro 中 include)
+INCLUDEPATH += $$PWD/..
+DEPENDPATH += $$PWD/..
+
+QT += sql network
+
+DESKCARE_CORE_DIR = $$shadowed($$PWD)
+LIBS += -L$$DESKCARE_CORE_DIR -ldeskcare_core
+
+# 静态库更新后重新链接
+msvc: PRE_TARGETDEPS += $$DESKCARE_CORE_DIR/deskcare_core.lib
+else: PRE_TARGETDEPS += $$DESKCARE_CORE_DIR/libdeskcare_core.a
+
+# 静态库的平台依赖需要由最终程序链接 (ProcessStats)
+win32:LIBS += -luser32 -lpsapi
@@ -0,0 +1,66 @@
+# DeskCare 核心静态库：不依赖 QtGui / QtQuick，可用于无界面模式与基准测试
+TEMPLATE = lib
+CONFIG += staticlib c++17
+QT = core sql network
+
+TARGET = deskcare_core
+# 固定输出目录 (不区分 debug/release 子目录)，便于 core.pri 定位
+DESTDIR = $$OUT_PWD
+
+SOURCES += \
+    Clock.cpp \
+    TimerEngine.cpp \
+    ReminderScheduler.cpp \
+    Calendar.cpp \
+    CalendarMonitor.cpp \
+    AppConfig.cpp \
+    UpdateManager.cpp \
+    StatisticsManager.cpp \
+    Version.cpp \
+    ActivityLogger.cpp \
+    SqliteActivityStore.cpp \
+    MemoryActivityStore.cpp \
+    ActivityJournal.cpp \
+    InputTrace.cpp \
+    WorkLogSuggester.cpp \
+    ControlServer.cpp \
+    HistoryHttpServer.cpp \
+    Metrics.cpp \
+    StartupTracer.cpp \
+    Logging.cpp \
+    HistoryGenerator.cpp \
+    ProcessStats.cpp \
+    ../utils/PresenceSource.cpp
+
+HEADERS += \
+    Clock.h \
+    TimerEngine.h \
+    ReminderScheduler.h \
+    Calendar.h \
+    CalendarMonitor.h \
+    AppConfig.h \
+    UpdateManager.h \
+    StatisticsManager.h \
+    Version.h \
+    ActivityLogger.h \
+    ActivityStore.h \
+    SqliteActivityStore.h \
+    MemoryActivityStore.h \
+    ActivityJournal.h \
+    InputTrace.h \
+    WorkLogSuggester.h \
+    ControlProtocol.h \
+    ControlServer.h \
+    HistoryHttpServer.h \
+    Metrics.h \
+    StartupTracer.h \
+    Logging.h \
+    HistoryGenerator.h \
+    ProcessStats.h \
+    ../utils/PresenceSource.h
+
+# D-Bus 在场检测 (utils/LinuxPresence) 与 xcb 前台窗口查询 (utils/ForegroundAppMonitor)
+# 不在核心库中，由使用它们的程序编译与链接
+
+# Fix for MSVC "C2001: newline in constant" error due to UTF-8 encoding with Chinese comments
+msvc:QMAKE_CXXFLAGS += /utf-8
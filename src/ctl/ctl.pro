@@ -0,0 +1,19 @@
+QT = core network
+CONFIG += c++17 console
+CONFIG -= app_bundle
+TARGET = deskcare-ctl
+TEMPLATE = app
+
+# 只使用 core/ControlProtocol.h 中的常量，不链接核心库
+INCLUDEPATH += $$PWD/..
+
+SOURCES += main.cpp
+
+# Windows: 与 DeskCare.exe 输出到同一目录
+win32 {
+    CONFIG(debug, debug|release): DESTDIR = $$shadowed($$PWD/../..)/debug
+    else: DESTDIR = $$shadowed($$PWD/../..)/release
+}
+
+# Fix for MSVC "C2001: newline in constant" error due to UTF-8 encoding
+msvc:QMAKE_CXXFLAGS += /utf-8
@@ -0,0 +1,124 @@
+#include <QCoreApplication>
+#include <QLocalSocket>
+#include <QJsonDocument>
+#include <QJsonObject>
+#include <QStringList>
+#include <cstdio>
+#include "core/ControlProtocol.h"
+
+// ========================================================================
+// deskcare-ctl：DeskCare 本地控制客户端
+// ========================================================================
+// 连接正在运行的 DeskCare (桌面版或 deskcare-headless)，发送一条命令并打印结果。
+// 退出码: 0 成功；1 命令失败或用法错误；2 DeskCare 未运行或无响应。
+
+static const int kTimeoutMs = 2000;
+
+static void printUsage() {
+    fputs("Usage: deskcare-ctl <command> [args]\n"
+          "\n"
+          "Commands:\n"
+          "  status                      Print current state and remaining time\n"
+          "  start                       Start a new work interval\n"
+          "  pause | resume | toggle     Pause or resume the countdown\n"
+          "  snooze                      Remind again in 5 minutes\n"
+          "  nap [on|off]                Toggle nap mode\n"
+          "  stats [yyyy-MM-dd]          Activity totals for a day (JSON)\n"
+          "  export [yyyy-MM-dd] [day|week|month] [--formal]\n"
+          "                              Print the work report\n"
+          "  metrics                     Print latency histograms and counters (JSON)\n"
+          "  raw '<json>'                Send a raw protocol request\n"
+          "\n"
+          "Options:\n"
+          "  --json                      Print the raw JSON reply\n", stderr);
+}
+
+static void printLine(const QString &text) {
+    fputs(text.toUtf8().constData(), stdout);
+    fputc('\n', stdout);
+}
+
+// 命令行参数 -> 协议请求，无法识别时返回空对象
+static QJsonObject buildRequest(const QStringList &args) {
+    const QString cmd = args.value(0);
+    QJsonObject request{ { "cmd", cmd } };
+
+    if (cmd == "raw") {
+        return QJsonDocument::fromJson(args.value(1).toUtf8()).object();
+    }
+    if (cmd == "nap") {
+        if (args.value(1) == "on") request.insert("on", true);
+        else if (args.value(1) == "off") request.insert("on", false);
+        return request;
+    }
+    if (cmd == "stats" || cmd == "export") {
+        for (int i = 1; i < args.size(); ++i) {
+            const QString &arg = args.at(i);
+            if (arg == "day") request.insert("range", 0);
+            else if (arg == "week") request.insert("range", 1);
+            else if (arg == "month") request.insert("range", 2);
+            else if (arg == "--formal") request.insert("mode", 1);
+            else request.insert("date", arg);
+        }
+        return request;
+    }
+
+    static const QStringList simple = { "status", "start", "pause", "resume", "toggle", "snooze", "metrics", "wake" };
+    return simple.contains(cmd) ? request : QJsonObject();
+}
+
+int main(int argc, char *argv[])
+{
+    QCoreApplication app(argc, argv);
+
+    QStringList args = app.arguments().mid(1);
+    const bool rawJson = args.removeAll("--json") > 0;
+    if (args.isEmpty() || args.first() == "--help" || args.first() == "-h") {
+        printUsage();
+        return args.isEmpty() ? 1 : 0;
+    }
+
+    const QJsonObject request = buildRequest(args);
+    if (request.isEmpty()) {
+        printUsage();
+        return 1;
+    }
+
+    QLocalSocket socket;
+    socket.connectToServer(ControlProtocol::ServerName);
+    if (!socket.waitForConnected(kTimeoutMs)) {
+        fputs("DeskCare is not running.\n", stderr);
+        return 2;
+    }
+
+    socket.write(QJsonDocument(request).toJson(QJsonDocument::Compact) + '\n');
+    while (!socket.canReadLine()) {
+        if (!socket.waitForReadyRead(kTimeoutMs)) {
+            fputs("No reply from DeskCare.\n", stderr);
+            return 2;
+        }
+    }
+    const QByteArray line = socket.readLine().trimmed();
+    socket.disconnectFromServer();
+
+    const QJsonObject reply = QJsonDocument::fromJson(line).object();
+    if (!reply.value("ok").toBool()) {
+        const QString error = reply.value("error").toString();
+        fputs(QString("Error: %1\n").arg(error.isEmpty() ? QStringLiteral("invalid reply") : error).toUtf8().constData(), stderr);
+        return 1;
+    }
+
+    const QString cmd = request.value("cmd").toString();
+    if (rawJson || cmd == "raw" || cmd == "stats" || cmd == "metrics") {
+        printLine(QString::fromUtf8(line));
+    } else if (reply.contains("report")) {
+        printLine(reply.value("report").toString());
+    } else if (reply.contains("status")) {
+        // 适合状态栏显示: "工作中 12:34"
+        const int remaining = reply.value("remainingSeconds").toInt();
+        printLine(QString("%1 %2:%3").arg(reply.value("status").toString())
+                                     .arg(remaining / 60, 2, 10, QLatin1Char('0'))
+                                     .arg(remaining % 60, 2, 10, QLatin1Char('0')));
+    }
+    return 0;
+}
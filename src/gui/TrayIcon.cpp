@@ -26,6 +26,10 @@ TrayIcon::TrayIcon(TimerEngine *timerEngine, UpdateManager *updateManager, QObje
     
     // Setup connections
     setupConnections();
+
+    // 托盘提示只显示到分钟，不需要每秒唤醒
+    m_timerEngine->requestDisplay("tray", TimerEngine::Display_Minute);
+    updateMenuState();
     
     // Show tray
     m_trayIcon->show();
@@ -96,6 +100,7 @@ void TrayIcon::createMenu() {
 void TrayIcon::setupConnections() {
     // Tray interactions
     connect(m_trayIcon, &QSystemTrayIcon::activated, this, &TrayIcon::onActivated);
+    connect(m_trayIcon, &QSystemTrayIcon::messageClicked, this, &TrayIcon::messageClicked);
     
     // Timer interactions
     connect(m_startAction, &QAction::triggered, m_timerEngine, &TimerEngine::togglePause);
@@ -115,7 +120,7 @@ void TrayIcon::setupConnections() {
     
     // Update menu state on timer changes
     connect(m_timerEngine, &TimerEngine::statusChanged, this, &TrayIcon::updateMenuState);
-    connect(m_timerEngine, &TimerEngine::timeUpdated, this, &TrayIcon::updateMenuState);
+    connect(m_timerEngine, &TimerEngine::timeUpdated, this, &TrayIcon::updateToolTip);
     // Also update on nap mode change
     connect(m_timerEngine, &TimerEngine::isNapModeChanged, this, &TrayIcon::updateMenuState);
     
@@ -142,8 +147,8 @@ void TrayIcon::onActivated(QSystemTrayIcon::ActivationReason reason) {
 }
 
 void TrayIcon::updateMenuState() {
-    QString status = m_timerEngine->statusText();
-    bool isPaused = (status == "已暂停" || status == "准备就绪");
+    const TimerEngine::EngineState state = m_timerEngine->engineState();
+    bool isPaused = (state == TimerEngine::Engine_Paused || state == TimerEngine::Engine_Ready);
     
     m_startAction->setVisible(isPaused);
     m_pauseAction->setVisible(!isPaused);
@@ -155,14 +160,25 @@ void TrayIcon::updateMenuState() {
         m_napAction->setText("☾ 午休模式");
     }
     
-    int secs = m_timerEngine->remainingSeconds();
-    QString timeStr = QString("%1:%2")
-        .arg(secs / 60, 2, 10, QChar('0'))
-        .arg(secs % 60, 2, 10, QChar('0'));
-    
-    m_trayIcon->setToolTip(QString("DeskCare - %1\n%2")
-        .arg(status)
-        .arg(timeStr));
+    updateToolTip();
+}
+
+void TrayIcon::updateToolTip() {
+    // 按分钟显示剩余时间 (向上取整)，内容未变化时不重设提示
+    int mins = (m_timerEngine->remainingSeconds() + 59) / 60;
+    QString toolTip = QString("DeskCare - %1\n剩余 %2 分钟")
+        .arg(m_timerEngine->statusText())
+        .arg(mins);
+    // 会议中顺延的提醒 (timeUpdated 会随顺延一起触发)
+    const QDateTime deferredUntil = m_timerEngine->deferredUntil();
+    if (deferredUntil.isValid()) {
+        toolTip += QString("\n会议中，提醒推迟到 %1").arg(deferredUntil.toString("HH:mm"));
+    }
+
+    if (toolTip != m_toolTip) {
+        m_toolTip = toolTip;
+        m_trayIcon->setToolTip(toolTip);
+    }
 }
 
 // --- Update Logic ---
@@ -17,10 +17,13 @@ public:
 
 signals:
     void showMainWindowRequested();
+    // 用户点击了托盘通知气泡
+    void messageClicked();
 
 private slots:
     void onActivated(QSystemTrayIcon::ActivationReason reason);
     void updateMenuState();
+    void updateToolTip();
     
     // Update slots
     void onCheckUpdate();
@@ -43,6 +46,7 @@ private:
     QAction *m_resetAction;
     QAction *m_quitAction;
     QAction *m_checkUpdateAction; // New action
+    QString m_toolTip; // 当前提示文本 (避免重复设置)
 
     void createMenu();
     void setupConnections();
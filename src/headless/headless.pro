@@ -0,0 +1,27 @@
+# deskcare-headless：无界面控制台程序，只链接核心库，不依赖 QtGui
+QT = core sql network
+QT -= gui
+CONFIG += c++17 console
+CONFIG -= app_bundle
+TARGET = deskcare-headless
+TEMPLATE = app
+
+include(../core/core.pri)
+
+SOURCES += main.cpp
+
+# Linux: 锁屏 / 空闲暂停计时 (logind、Mutter IdleMonitor，D-Bus)
+linux {
+    QT += dbus
+    SOURCES += ../utils/LinuxPresence.cpp
+    HEADERS += ../utils/LinuxPresence.h
+}
+
+# Windows: 与 DeskCare.exe 输出到同一目录
+win32 {
+    CONFIG(debug, debug|release): DESTDIR = $$shadowed($$PWD/../..)/debug
+    else: DESTDIR = $$shadowed($$PWD/../..)/release
+}
+
+# Fix for MSVC "C2001: newline in constant" error due to UTF-8 encoding
+msvc:QMAKE_CXXFLAGS += /utf-8
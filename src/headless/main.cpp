@@ -0,0 +1,174 @@
+// ========================================================================
+// deskcare-headless：无界面版本
+// ========================================================================
+// 只运行计时引擎与活动记录器，基于 QCoreApplication，不链接 QtGui/QtQuick
+// (headless.pro 中 QT -= gui)，适合自助终端、SSH 会话等没有显示器的环境。
+// - 状态变化与提醒打印到标准输出；没有全屏提醒窗口可以确认，休息按
+//   AppConfig 的强制运动时长 (分钟) 计时结束后自动开始下一轮工作。
+// - 与桌面版共用单实例锁：已有实例运行时直接退出。
+// - Ctrl+C / SIGTERM 时正常退出事件循环，保证活动记录写入数据库。
+// ========================================================================
+#include <QCoreApplication>
+#include <QLocalSocket>
+#include <QTimer>
+#include <QStandardPaths>
+#include <cstdio>
+#include "core/AppConfig.h"
+#include "core/TimerEngine.h"
+#include "core/ActivityLogger.h"
+#include "core/ControlServer.h"
+#include "core/ControlProtocol.h"
+#include "core/HistoryHttpServer.h"
+#include "core/Logging.h"
+
+#ifdef Q_OS_LINUX
+#include <QSettings>
+#include <QScopedPointer>
+#include "utils/LinuxPresence.h"
+#endif
+
+#ifdef Q_OS_UNIX
+#include <QSocketNotifier>
+#include <csignal>
+#include <sys/socket.h>
+#include <unistd.h>
+#elif defined(Q_OS_WIN)
+#include <windows.h>
+#endif
+
+// ========================================================================
+// 退出信号处理
+// ========================================================================
+// 信号处理函数里不能调用 Qt：Unix 下写入 socketpair (self-pipe)，由事件循环
+// 中的 QSocketNotifier 读取后退出；Windows 的控制台回调运行在独立线程，
+// 用排队调用把 quit 投递回主线程。
+
+#ifdef Q_OS_UNIX
+static int s_signalFds[2] = { -1, -1 };
+
+static void onTerminateSignal(int) {
+    const char c = 1;
+    const ssize_t written = ::write(s_signalFds[0], &c, 1);
+    (void)written;
+}
+
+static void installTerminateHandler(QCoreApplication *app) {
+    if (::socketpair(AF_UNIX, SOCK_STREAM, 0, s_signalFds) != 0) {
+        qCWarning(lcEngine) << "Headless: socketpair failed, Ctrl+C will not flush the activity log";
+        return;
+    }
+    auto *notifier = new QSocketNotifier(s_signalFds[1], QSocketNotifier::Read, app);
+    QObject::connect(notifier, &QSocketNotifier::activated, app, [app, notifier]() {
+        notifier->setEnabled(false);
+        char c;
+        const ssize_t n = ::read(s_signalFds[1], &c, 1);
+        (void)n;
+        app->quit();
+    });
+
+    struct sigaction action = {};
+    action.sa_handler = onTerminateSignal;
+    sigemptyset(&action.sa_mask);
+    action.sa_flags = SA_RESTART;
+    sigaction(SIGINT, &action, nullptr);
+    sigaction(SIGTERM, &action, nullptr);
+    sigaction(SIGHUP, &action, nullptr);
+}
+#elif defined(Q_OS_WIN)
+static BOOL WINAPI onConsoleCtrl(DWORD) {
+    QMetaObject::invokeMethod(QCoreApplication::instance(), "quit", Qt::QueuedConnection);
+    return TRUE;
+}
+
+static void installTerminateHandler(QCoreApplication *) {
+    SetConsoleCtrlHandler(onConsoleCtrl, TRUE);
+}
+#else
+static void installTerminateHandler(QCoreApplication *) {}
+#endif
+
+// 带时间戳输出一行到标准输出 (立即刷新，便于重定向到日志或管道)
+static void printLine(const Clock *clock, const QString &text) {
+    const QString line = QString("[%1] %2\n").arg(clock->now().toString("yyyy-MM-dd HH:mm:ss"), text);
+    fputs(line.toUtf8().constData(), stdout);
+    fflush(stdout);
+}
+
+int main(int argc, char *argv[])
+{
+    QCoreApplication app(argc, argv);
+    app.setOrganizationName("TraeAI");
+    app.setApplicationName("FocusTimer");
+
+    // ========================================================================
+    // 单实例检查 (与桌面版共用同一个服务器名)
+    // ========================================================================
+    {
+        QLocalSocket socket;
+        socket.connectToServer(ControlProtocol::ServerName);
+        if (socket.waitForConnected(500)) {
+            fputs("DeskCare is already running.\n", stderr);
+            return 1;
+        }
+    }
+    // 立即占用单实例套接字 (先于打开活动数据库)，核心模块创建后再挂接。
+    // 本地控制接口 (deskcare-ctl)；没有窗口可以唤醒，wake 命令被忽略
+    ControlServer controlServer;
+    if (!controlServer.listen()) {
+        qCWarning(lcEngine) << "Failed to listen on single instance server:" << controlServer.errorString();
+    }
+    LogSink::instance()->start(QStandardPaths::writableLocation(QStandardPaths::AppDataLocation) + "/logs");
+
+    // ========================================================================
+    // 核心模块 (声明顺序保证记录器先于引擎析构，退出时写完当前会话)
+    // ========================================================================
+    AppConfig appConfig;
+    TimerEngine timerEngine;
+    ActivityLogger activityLogger(&timerEngine);
+    const Clock *clock = timerEngine.clock();
+
+    controlServer.attach(&timerEngine, &activityLogger);
+    // 本机 HTTP 历史接口 (Http/enabled 开启时监听)
+    HistoryHttpServer historyServer(&activityLogger);
+    if (historyServer.isListening()) printLine(clock, QString("History: %1").arg(historyServer.url()));
+
+    QObject::connect(&timerEngine, &TimerEngine::statusChanged, &app, [&]() {
+        printLine(clock, timerEngine.statusText());
+    });
+
+    // 提醒：打印后开始休息计时，结束时自动进入下一轮工作
+    ClockTimer *breakTimer = timerEngine.clock()->createTimer(&app);
+    QObject::connect(&timerEngine, &TimerEngine::reminderTriggered, &app, [&]() {
+        const int breakMinutes = qMax(1, appConfig.forcedExerciseDuration());
+        printLine(clock, QString("Time to take a break (%1 min)").arg(breakMinutes));
+        breakTimer->start(qint64(breakMinutes) * 60 * 1000);
+    });
+    QObject::connect(breakTimer, &ClockTimer::timeout, &app, [&]() {
+        if (timerEngine.engineState() == TimerEngine::Engine_Break) timerEngine.startWork();
+    });
+
+#ifdef Q_OS_LINUX
+    // 锁屏/空闲暂停计时 (桌面版由 WindowUtils 汇总，这里直接连接)
+    LogindPresenceSource lockSource;
+    // 无输入超过 N 分钟自动暂停 (0 表示关闭)
+    QScopedPointer<IdleMonitorPresenceSource> idleSource;
+    const int idleMinutes = QSettings("TraeAI", "DeskCare").value("Presence/idleMinutes", 10).toInt();
+    if (idleMinutes > 0) idleSource.reset(new IdleMonitorPresenceSource(qint64(idleMinutes) * 60 * 1000));
+    bool away = false;
+    auto updatePresence = [&]() {
+        const bool nowAway = lockSource.isLocked() || (idleSource && idleSource->isIdle());
+        if (nowAway == away) return;
+        away = nowAway;
+        timerEngine.handleSystemLock(away);
+    };
+    QObject::connect(&lockSource, &PresenceSource::presenceChanged, &app, updatePresence);
+    if (idleSource) QObject::connect(idleSource.data(), &PresenceSource::presenceChanged, &app, updatePresence);
+#endif
+
+    installTerminateHandler(&app);
+    printLine(clock, QString("DeskCare headless mode: %1").arg(timerEngine.statusText()));
+
+    const int ret = app.exec();
+    printLine(clock, "Exiting");
+    return ret;
+}
@@ -1,18 +1,40 @@
 #include <QApplication>
 #include <QQmlApplicationEngine>
 #include <QQmlContext>
-#include <QDebug>
+#include <QQmlEngine>
+#include <QQuickWindow>
+#include <QTimer>
+#include <QFile>
 #include <QIcon>
-#include <QLocalServer>
 #include <QLocalSocket>
 #include <QWindow>
+#include <QScopedPointer>
+#include <QStandardPaths>
+#include <cstdio>
+#include <memory>
 #include "core/AppConfig.h"
 #include "core/TimerEngine.h"
+#include "core/ReminderScheduler.h"
+#include "core/CalendarMonitor.h"
 #include "core/UpdateManager.h"
 #include "core/StatisticsManager.h"
 #include "core/ActivityLogger.h"
+#include "core/WorkLogSuggester.h"
+#include "core/InputTrace.h"
+#include "core/ControlServer.h"
+#include "core/ControlProtocol.h"
+#include "core/HistoryHttpServer.h"
+#include "core/Metrics.h"
+#include "core/StartupTracer.h"
+#include "GenerateHistoryMain.h"
+#include "SoakMain.h"
 #include "gui/TrayIcon.h"
 #include "utils/WindowUtils.h"
+#include "utils/ForegroundAppMonitor.h"
+#include "utils/WakeupAuditor.h"
+#include "utils/QmlMemoryProbe.h"
+#include "utils/ComponentPool.h"
+#include "core/Logging.h"
 
 /*
 我已经为您完成了所有源代码文件的详细中文注释添加工作。这些注释不仅解释了代码“做了什么”，更重要的是解释了“为什么要这样做”以及背后的 Qt 核心机制，非常适合作为学习材料。
@@ -57,6 +79,28 @@
 // argv: 命令行参数数组
 int main(int argc, char *argv[])
 {
+    // 合成历史数据 (--generate-history)，见 GenerateHistoryMain.h
+    for (int i = 1; i < argc; ++i) {
+        if (qstrncmp(argv[i], "--generate-history=", 19) == 0) return runGenerateHistory(argc, argv);
+    }
+
+    // 长时间运行检查 (--soak)：加速模拟数月使用并监测内存/句柄增长，见 SoakMain.h
+    for (int i = 1; i < argc; ++i) {
+        if (qstrcmp(argv[i], "--soak") == 0 || qstrncmp(argv[i], "--soak=", 7) == 0) return runSoak(argc, argv);
+    }
+
+    // ========================================================================
+    // 0.5 启动追踪 (--trace-startup=<文件>)
+    // ========================================================================
+    // 记录各启动阶段耗时，首帧后写出 Chrome trace JSON (见 core/StartupTracer.h)。
+    // 需要在 QApplication 之前开启，才能统计到它的创建。
+    for (int i = 1; i < argc; ++i) {
+        if (qstrncmp(argv[i], "--trace-startup=", 16) == 0) {
+            StartupTracer::instance()->enable(QString::fromLocal8Bit(argv[i] + 16));
+        }
+    }
+    TraceSpan phase("QApplication"); // 依次标记各启动阶段 (追踪关闭时无开销)
+
     // ========================================================================
     // 1. High DPI (高DPI) 设置
     // ========================================================================
@@ -82,46 +126,80 @@ int main(int argc, char *argv[])
     app.setOrganizationName("TraeAI");
     app.setApplicationName("FocusTimer");
     app.setWindowIcon(QIcon(":/assets/logo.png"));
+    phase.finish();
+
+    // ========================================================================
+    // 2.2 输入回放模式 (--replay-trace=<文件>)
+    // ========================================================================
+    // 用全新的引擎全速回放录制的输入，把产生的活动记录打印到标准输出后退出。
+    // 不连接单实例服务器，也不触碰真实数据库，可与正在运行的实例并存。
+    for (int i = 1; i < argc; ++i) {
+        const QString arg = QString::fromLocal8Bit(argv[i]);
+        if (arg.startsWith("--replay-trace=")) {
+            InputTraceReplayer::Result result;
+            if (!InputTraceReplayer::replay(arg.mid(15), &result)) return 1;
+            fputs(InputTraceReplayer::format(result).toUtf8().constData(), stdout);
+            return 0;
+        }
+    }
 
     // ========================================================================
     // 2.5 单实例检查 (Single Instance Check)
     // ========================================================================
     // 需求：当用户已经启动了一个实例，再次双击 exe 时，不应启动新实例，而是唤醒已有实例。
     // 实现：使用 QLocalServer/QLocalSocket (基于命名管道/Unix域套接字) 进行进程间通信。
+    // 同一个套接字也是脚本控制接口 (ControlServer，协议见 core/ControlProtocol.h)。
     
-    const QString serverName = "TraeAI_DeskCare_SingleInstance_Lock";
+    phase.next("singleInstanceProbe");
     QLocalSocket socket;
-    socket.connectToServer(serverName);
+    socket.connectToServer(ControlProtocol::ServerName);
     
     // 尝试连接已存在的服务器
     if (socket.waitForConnected(500)) {
-        qDebug() << "Another instance is running. Waking it up...";
+        qCDebug(lcUi) << "Another instance is running. Waking it up...";
         // 发送唤醒消息
-        socket.write("WAKE_UP");
+        socket.write("{\"cmd\":\"wake\"}\n");
         socket.waitForBytesWritten(1000);
         socket.disconnectFromServer();
         
         // 退出当前新实例
         return 0;
     }
-    
-    // 如果连接失败，说明是第一个实例 (或上一个实例崩溃留下了僵尸文件)
-    // 清理可能存在的残留连接文件 (Windows下通常自动清理，但在Unix下很有必要，这里统一处理以防万一)
-    QLocalServer::removeServer(serverName);
-    
-    // 创建单实例服务器
-    QLocalServer singleInstanceServer;
-    if (!singleInstanceServer.listen(serverName)) {
-        qWarning() << "Failed to listen on single instance server:" << singleInstanceServer.errorString();
-        // 即使监听失败，程序也继续运行，只是失去了防多开功能
+    // 如果连接失败，说明是第一个实例：立即占用单实例套接字 (先于打开活动数据库与日志，
+    // 避免第二个实例在此期间打开同一个数据库)，核心模块创建后再挂接
+    phase.next("ControlServer");
+    ControlServer controlServer; // 单实例锁 + 本地控制接口
+    if (!controlServer.listen()) {
+        qCWarning(lcUi) << "Failed to listen on single instance server:" << controlServer.errorString();
+        // 即使监听失败，程序也继续运行，只是失去了防多开与脚本控制功能
     }
+    phase.next("LogSink");
+
+    // 日志文件 <AppData>/logs/deskcare.log (见 core/Logging.h)；只由第一个实例写入
+    LogSink::instance()->start(QStandardPaths::writableLocation(QStandardPaths::AppDataLocation) + "/logs");
+    phase.finish();
 
     // 3.0 Check command line arguments for auto-start
     bool isAutoStartLaunch = false;
+    QString recordTracePath; // --record-trace=<文件>：录制输入事件 (默认关闭)
+    double wakeupBudget = 0; // --audit-wakeups[=<每秒次数>]：唤醒分析 (默认关闭，预算默认 1 次/秒)
+    bool probeQmlMemory = false; // --probe-qml-memory[=<报告文件>]：懒加载组件的内存核算 (默认关闭)
+    QString qmlMemoryReportPath;
     for (int i = 1; i < argc; ++i) {
-        if (QString(argv[i]) == "--autostart") {
+        const QString arg = QString::fromLocal8Bit(argv[i]);
+        if (arg == "--autostart") {
             isAutoStartLaunch = true;
-            break;
+        } else if (arg.startsWith("--record-trace=")) {
+            recordTracePath = arg.mid(15);
+        } else if (arg == "--audit-wakeups") {
+            wakeupBudget = 1.0;
+        } else if (arg.startsWith("--audit-wakeups=")) {
+            wakeupBudget = qMax(0.01, arg.mid(16).toDouble());
+        } else if (arg == "--probe-qml-memory") {
+            probeQmlMemory = true;
+        } else if (arg.startsWith("--probe-qml-memory=")) {
+            probeQmlMemory = true;
+            qmlMemoryReportPath = arg.mid(19);
         }
     }
     
@@ -131,13 +209,39 @@ int main(int argc, char *argv[])
     // 这里实例化了我们在 C++ 中编写的业务逻辑类。
     // 它们都继承自 QObject，以便与 QML 进行交互。
     
+    phase.next("TimerEngine");
     TimerEngine timerEngine; // 计时器逻辑核心
+    // 输入录制 (可选)：需在其他模块连接引擎之前挂接，保证不漏掉任何输入
+    QScopedPointer<InputTraceRecorder> traceRecorder;
+    if (!recordTracePath.isEmpty()) {
+        traceRecorder.reset(new InputTraceRecorder(recordTracePath, timerEngine.clock()));
+        if (traceRecorder->open(&timerEngine)) timerEngine.setInputRecorder(traceRecorder.data());
+    }
+    phase.next("CalendarMonitor");
+    CalendarMonitor calendarMonitor(timerEngine.clock()); // 本地 .ics 日历 (会议中顺延提醒)
+    timerEngine.setCalendar(calendarMonitor.index());
+    phase.next("ReminderScheduler");
+    ReminderScheduler reminderScheduler(&timerEngine); // 护眼/喝水/长休息等附加提醒
+    phase.next("UpdateManager");
     UpdateManager updateManager; // 更新管理器
+    phase.next("StatisticsManager");
     StatisticsManager statsManager; // 用户统计管理器
+    phase.next("ActivityLogger");
     ActivityLogger activityLogger(&timerEngine); // 活动记录器 (新功能)
+    phase.next("WorkLogSuggester");
+    WorkLogSuggester workLogSuggester(&activityLogger); // 工时日志输入联想
+    controlServer.attach(&timerEngine, &activityLogger);
+    phase.next("HistoryHttpServer");
+    HistoryHttpServer historyServer(&activityLogger); // 本机 HTTP 历史接口 (默认关闭)
+    phase.next("TrayIcon");
     TrayIcon trayIcon(&timerEngine, &updateManager);       // 系统托盘图标控制
+    phase.next("AppConfig");
     AppConfig appConfig;     // 配置管理 (读写注册表/配置文件)
+    phase.next("WindowUtils");
     WindowUtils windowUtils; // 窗口工具 (处理置顶等原生 API)
+    phase.next("ForegroundAppMonitor");
+    ForegroundAppMonitor foregroundMonitor; // 前台应用统计 (默认关闭)
+    phase.finish();
 
     // 启动时上报用户活跃数据 (DAU)
     statsManager.reportStartup();
@@ -152,12 +256,71 @@ int main(int argc, char *argv[])
     QObject::connect(&windowUtils, &WindowUtils::sessionStateChanged, 
                      &timerEngine, &TimerEngine::handleSystemLock);
 
+    // 前台应用统计：只在专注时采样，切换结果计入当前专注会话
+    QObject::connect(&foregroundMonitor, &ForegroundAppMonitor::foregroundChanged,
+                     &activityLogger, &ActivityLogger::onForegroundAppChanged);
+    QObject::connect(&timerEngine, &TimerEngine::activityStateChanged,
+                     &foregroundMonitor, [&](TimerEngine::ActivityState state) {
+        foregroundMonitor.setActive(state == TimerEngine::State_Focus);
+    });
+    foregroundMonitor.setActive(timerEngine.currentActivityState() == TimerEngine::State_Focus);
+
+    // 每种提醒在活动日志中有独立的会话
+    QObject::connect(&reminderScheduler, &ReminderScheduler::reminderStarted,
+                     &activityLogger, &ActivityLogger::onReminderStarted);
+    QObject::connect(&reminderScheduler, &ReminderScheduler::reminderFinished,
+                     &activityLogger, &ActivityLogger::onReminderFinished);
+
+    // 附加提醒以托盘气泡通知 (运动提醒由全屏窗口处理)，点击气泡视为已完成
+    QObject::connect(&reminderScheduler, &ReminderScheduler::remindersDue,
+                     &trayIcon, [&](const QStringList& kinds) {
+        if (kinds.contains(ReminderScheduler::MovementKind)) return;
+        QStringList titles, messages;
+        for (const QString& id : kinds) {
+            titles << reminderScheduler.title(id);
+            messages << reminderScheduler.message(id);
+        }
+        trayIcon.showMessage(titles.join(" · "), messages.join("\n"));
+    });
+    QObject::connect(&trayIcon, &TrayIcon::messageClicked,
+                     &reminderScheduler, &ReminderScheduler::completeAll);
+
     // ========================================================================
     // 5. 初始化 QML 引擎 (前端加载)
     // ========================================================================
     // QQmlApplicationEngine 负责加载 QML 文件并管理 QML 上下文。
+    phase.next("QQmlApplicationEngine");
     QQmlApplicationEngine engine;
+    phase.finish();
+
+    // 唤醒分析 (诊断模式)：需在加载 QML 之前挂接，才能追踪到所有 QML Timer
+    QScopedPointer<WakeupAuditor> wakeupAuditor;
+    if (wakeupBudget > 0) {
+        wakeupAuditor.reset(new WakeupAuditor(wakeupBudget));
+        wakeupAuditor->attachQml(&engine);
+    }
+
+    // 懒加载组件的内存核算 (诊断模式)：Main.qml 中的 Loader 通过 memoryProbe.watch() 登记，
+    // 退出时输出报告 (见 utils/QmlMemoryProbe.h)
+    QScopedPointer<QmlMemoryProbe> memoryProbe;
+    if (probeQmlMemory) {
+        memoryProbe.reset(new QmlMemoryProbe(&engine));
+        QmlMemoryProbe* probe = memoryProbe.data();
+        QObject::connect(&app, &QCoreApplication::aboutToQuit, probe, [probe, qmlMemoryReportPath]() {
+            const QString report = probe->report();
+            qCInfo(lcUi).noquote() << "QML memory report:\n" + report;
+            if (qmlMemoryReportPath.isEmpty()) return;
+            QFile file(qmlMemoryReportPath);
+            if (file.open(QIODevice::WriteOnly | QIODevice::Truncate | QIODevice::Text)) file.write(report.toUtf8());
+            else qCWarning(lcUi) << "Cannot write QML memory report to" << qmlMemoryReportPath;
+        });
+    }
     
+    // 提醒窗口 / 活动看板的预编译与后台创建 (见 utils/ComponentPool.h)。
+    // 需在加载 QML 之前创建，以装上自己的孵化控制器
+    ComponentPool componentPool(&engine);
+    componentPool.attachTimerEngine(&timerEngine);
+
     // ========================================================================
     // 6. 依赖注入：将 C++ 对象暴露给 QML
     // ========================================================================
@@ -165,12 +328,24 @@ int main(int argc, char *argv[])
     // 这样在 QML 文件中，就可以直接使用 "timerEngine"、"appConfig" 等变量名来调用 C++ 的方法和属性。
     // 这是 Qt Quick 中 C++ (后端) 与 QML (前端) 交互最简单直接的方式。
     
+    // 注册 TimerEngine 类型 (不可在 QML 中创建)，使 QML 可以使用 TimerEngine.Engine_Working 等枚举
+    qmlRegisterUncreatableType<TimerEngine>("DeskCare", 1, 0, "TimerEngine",
+                                            "TimerEngine is provided via the timerEngine context property");
+
     engine.rootContext()->setContextProperty("timerEngine", &timerEngine);
+    engine.rootContext()->setContextProperty("reminderScheduler", &reminderScheduler);
+    engine.rootContext()->setContextProperty("calendarMonitor", &calendarMonitor);
     engine.rootContext()->setContextProperty("updateManager", &updateManager);
     engine.rootContext()->setContextProperty("activityLogger", &activityLogger);
+    engine.rootContext()->setContextProperty("workLogSuggester", &workLogSuggester);
     engine.rootContext()->setContextProperty("trayIcon", &trayIcon);
     engine.rootContext()->setContextProperty("appConfig", &appConfig);
     engine.rootContext()->setContextProperty("windowUtils", &windowUtils);
+    engine.rootContext()->setContextProperty("foregroundMonitor", &foregroundMonitor);
+    engine.rootContext()->setContextProperty("historyServer", &historyServer);
+    engine.rootContext()->setContextProperty("metrics", Metrics::instance());
+    engine.rootContext()->setContextProperty("memoryProbe", memoryProbe.data()); // 未开启时为 null
+    engine.rootContext()->setContextProperty("componentPool", &componentPool);
     engine.rootContext()->setContextProperty("isAutoStartLaunch", isAutoStartLaunch);
 
     // 加载主界面 QML 文件
@@ -187,19 +362,38 @@ int main(int argc, char *argv[])
     }, Qt::QueuedConnection);
     
     // 开始加载
+    phase.next("qml.load");
     engine.load(url);
+    phase.finish();
+
+    // 启动稳定后在后台编译按需创建的窗口
+    componentPool.precompile({ QUrl(QStringLiteral("qrc:/assets/qml/OverlayWindow.qml")),
+                               QUrl(QStringLiteral("qrc:/assets/qml/ActivityDashboard.qml")) }, 3000);
+
+    // 启动追踪：主窗口第一帧后写出文件。frameSwapped 来自渲染线程，排队到主线程处理；
+    // 开机自启时窗口隐藏没有首帧，10 秒后照常写出
+    if (StartupTracer::instance()->isEnabled()) {
+        QQuickWindow* mainWindow = engine.rootObjects().isEmpty()
+                ? nullptr : qobject_cast<QQuickWindow*>(engine.rootObjects().first());
+        if (mainWindow) {
+            // 只需要第一帧，之后断开 (与 ComponentPool::recordFirstFrame 相同)
+            auto connection = std::make_shared<QMetaObject::Connection>();
+            *connection = QObject::connect(mainWindow, &QQuickWindow::frameSwapped, &app, [connection]() {
+                QObject::disconnect(*connection);
+                StartupTracer* tracer = StartupTracer::instance();
+                if (!tracer->isEnabled()) return;
+                tracer->instant("firstFrame");
+                tracer->finish();
+            });
+        }
+        QTimer::singleShot(10000, &app, []() { StartupTracer::instance()->finish(); });
+    }
 
     // ========================================================================
     // 6.5 处理单实例唤醒信号
     // ========================================================================
-    // 当收到第二个实例的连接请求时，将主窗口置顶显示
-    QObject::connect(&singleInstanceServer, &QLocalServer::newConnection, &app, [&]() {
-        QLocalSocket* clientConnection = singleInstanceServer.nextPendingConnection();
-        if (!clientConnection) return;
-        
-        clientConnection->close();
-        clientConnection->deleteLater();
-        
+    // 当第二个实例发来 wake 命令时，将主窗口置顶显示
+    QObject::connect(&controlServer, &ControlServer::wakeRequested, &app, [&]() {
         // 获取主窗口并激活
         if (engine.rootObjects().isEmpty()) return;
         
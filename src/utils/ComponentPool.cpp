@@ -0,0 +1,256 @@
+#include "ComponentPool.h"
+#include "core/TimerEngine.h"
+#include "core/Metrics.h"
+#include "core/Logging.h"
+#include <QElapsedTimer>
+#include <QFileInfo>
+#include <QQmlComponent>
+#include <QQmlContext>
+#include <QQmlEngine>
+#include <QQmlIncubator>
+#include <QQuickWindow>
+#include <QScopedPointer>
+#include <climits>
+#include <memory>
+
+static const int kIncubateSliceMs = 5; // 每次空闲推进孵化的时长
+
+// ========================================================================
+// 孵化器与孵化控制器
+// ========================================================================
+
+class ComponentPool::Incubator : public QQmlIncubator {
+public:
+    Incubator(QQmlComponent *component, const QVariantMap &properties)
+        : QQmlIncubator(QQmlIncubator::Asynchronous), component(component), properties(properties) {}
+
+    QQmlComponent *component;
+    QVariantMap properties;
+
+protected:
+    void statusChanged(Status status) override {
+        if (status == Error) qCWarning(lcUi) << "ComponentPool: incubation failed" << component->url() << errors();
+    }
+};
+
+// 事件循环每轮推进 kIncubateSliceMs，两片之间照常处理输入与绘制
+class ComponentPool::IncubationController : public QObject, public QQmlIncubationController {
+public:
+    IncubationController() {
+        m_timer.setInterval(0);
+        QObject::connect(&m_timer, &QTimer::timeout, this, [this]() {
+            incubateFor(kIncubateSliceMs);
+            if (incubatingObjectCount() == 0) m_timer.stop();
+        });
+    }
+
+protected:
+    void incubatingObjectCountChanged(int count) override {
+        if (count > 0) m_timer.start();
+        else m_timer.stop();
+    }
+
+private:
+    QTimer m_timer;
+};
+
+ComponentPool::ComponentPool(QQmlEngine *engine, QObject *parent)
+    : QObject(parent), m_engine(engine)
+{
+    // 需在加载 QML 之前设置，否则 QQuickWindow 会装上自己的控制器
+    if (!engine->incubationController()) {
+        m_controller = new IncubationController;
+        engine->setIncubationController(m_controller);
+    }
+
+    m_prewarmTimer.setSingleShot(true);
+    connect(&m_prewarmTimer, &QTimer::timeout, this, &ComponentPool::schedulePrewarm);
+}
+
+ComponentPool::~ComponentPool() {
+    for (const QString &key : m_prepared.keys()) discard(key);
+    if (m_controller && m_engine->incubationController() == m_controller) m_engine->setIncubationController(nullptr);
+    delete m_controller;
+}
+
+// ========================================================================
+// 编译
+// ========================================================================
+
+void ComponentPool::precompile(const QList<QUrl> &urls, int delayMs) {
+    QTimer::singleShot(delayMs, this, [this, urls]() {
+        for (const QUrl &url : urls) component(url);
+    });
+}
+
+QQmlComponent *ComponentPool::component(const QUrl &url) {
+    auto it = m_components.constFind(url);
+    if (it != m_components.constEnd()) return it.value();
+
+    auto *component = new QQmlComponent(m_engine, url, QQmlComponent::Asynchronous, this);
+    connect(component, &QQmlComponent::statusChanged, this, &ComponentPool::onComponentStatusChanged);
+    m_components.insert(url, component);
+    if (component->isError()) qCWarning(lcUi) << "ComponentPool:" << component->errorString();
+    return component;
+}
+
+void ComponentPool::onComponentStatusChanged() {
+    auto *component = qobject_cast<QQmlComponent *>(sender());
+    if (!component) return;
+    if (component->isError()) {
+        qCWarning(lcUi) << "ComponentPool:" << component->errorString();
+        return;
+    }
+    if (!component->isReady()) return;
+
+    // 编译完成前就请求准备的实例
+    for (Incubator *incubator : qAsConst(m_prepared)) {
+        if (incubator->component == component && incubator->status() == QQmlIncubator::Null) startIncubation(incubator);
+    }
+}
+
+// ========================================================================
+// 准备与取用
+// ========================================================================
+
+void ComponentPool::prepare(const QString &key, const QUrl &url, const QVariantMap &initialProperties) {
+    discard(key);
+    QQmlComponent *c = component(url);
+    if (c->isError()) return;
+
+    auto *incubator = new Incubator(c, initialProperties);
+    m_prepared.insert(key, incubator);
+    if (c->isReady()) startIncubation(incubator); // 否则编译完成后开始
+}
+
+void ComponentPool::startIncubation(Incubator *incubator) {
+    incubator->setInitialProperties(incubator->properties);
+    incubator->component->create(*incubator, m_engine->rootContext());
+}
+
+QObject *ComponentPool::take(const QString &key, const QUrl &url, const QVariantMap &initialProperties) {
+    QObject *object = nullptr;
+    bool warm = false;
+    if (Incubator *incubator = m_prepared.take(key)) {
+        warm = incubator->isReady();
+        if (incubator->isLoading()) {
+            incubator->forceCompletion();
+            static MetricCounter *s_forced = Metrics::instance()->counter("pool.forced");
+            s_forced->add();
+        }
+        if (incubator->isReady()) object = incubator->object();
+        delete incubator; // Ready 状态下不会删除创建的对象
+    }
+
+    if (warm) {
+        static MetricCounter *s_hit = Metrics::instance()->counter("pool.hit");
+        s_hit->add();
+    }
+
+    if (!object) {
+        static MetricCounter *s_miss = Metrics::instance()->counter("pool.miss");
+        s_miss->add();
+        // 后台编译尚未完成时用同步组件：类型加载器会就地完成编译
+        QQmlComponent *c = component(url);
+        QScopedPointer<QQmlComponent> synchronous;
+        if (c->isLoading()) {
+            synchronous.reset(new QQmlComponent(m_engine, url));
+            c = synchronous.data();
+        }
+        object = c->createWithInitialProperties(initialProperties, m_engine->rootContext());
+        if (!object) {
+            qCWarning(lcUi) << "ComponentPool: cannot create" << url << c->errorString();
+            return nullptr;
+        }
+    }
+
+    // 顶层对象默认不可由 JS 销毁，交给 QML 管理
+    QQmlEngine::setObjectOwnership(object, QQmlEngine::JavaScriptOwnership);
+    recordFirstFrame(object, url, warm);
+    return object;
+}
+
+void ComponentPool::discard(const QString &key) {
+    Incubator *incubator = m_prepared.take(key);
+    if (!incubator) return;
+    // 可能在 QML 信号处理中调用，已创建的窗口延迟删除；孵化中的先 clear 中止并回收半成品
+    if (incubator->isReady() && incubator->object()) incubator->object()->deleteLater();
+    else if (incubator->isLoading()) incubator->clear();
+    delete incubator;
+}
+
+bool ComponentPool::isReady(const QString &key) const {
+    const Incubator *incubator = m_prepared.value(key);
+    return incubator && incubator->isReady();
+}
+
+void ComponentPool::recordFirstFrame(QObject *object, const QUrl &url, bool warm) {
+    auto *window = qobject_cast<QQuickWindow *>(object);
+    if (!window) return;
+
+    const QString name = QString("ui.%1.firstFrame.%2").arg(QFileInfo(url.path()).baseName(), warm ? "warm" : "cold");
+    MetricHistogram *histogram = Metrics::instance()->histogram(name);
+    QElapsedTimer timer;
+    timer.start();
+    // frameSwapped 来自渲染线程，排队到主线程；只记录第一帧
+    auto connection = std::make_shared<QMetaObject::Connection>();
+    auto done = std::make_shared<bool>(false);
+    *connection = connect(window, &QQuickWindow::frameSwapped, this, [histogram, timer, connection, done]() {
+        if (*done) return;
+        *done = true;
+        histogram->record(timer.nsecsElapsed() / 1000);
+        QObject::disconnect(*connection);
+    });
+}
+
+// ========================================================================
+// 预热时机
+// ========================================================================
+
+void ComponentPool::attachTimerEngine(TimerEngine *engine, int leadSeconds) {
+    m_timerEngine = engine;
+    m_leadSeconds = leadSeconds;
+    connect(engine, &TimerEngine::statusChanged, this, &ComponentPool::schedulePrewarm);
+    connect(engine, &TimerEngine::isRunningChanged, this, &ComponentPool::schedulePrewarm);
+    connect(engine, &TimerEngine::estimatedFinishTimeChanged, this, &ComponentPool::schedulePrewarm);
+    schedulePrewarm();
+}
+
+void ComponentPool::schedulePrewarm() {
+    if (!m_timerEngine) return;
+    const TimerEngine::EngineState state = m_timerEngine->engineState();
+
+    // 提醒已触发：准备好的实例由 QML 取用 (statusChanged 先于 reminderTriggered 发出，这里不能作废)
+    if (state == TimerEngine::Engine_Break) {
+        m_prewarmTimer.stop();
+        m_prewarmed = false;
+        return;
+    }
+
+    const bool counting = (state == TimerEngine::Engine_Working || state == TimerEngine::Engine_Snoozed)
+                          && m_timerEngine->isRunning();
+    if (!counting) {
+        m_prewarmTimer.stop();
+        if (m_prewarmed) {
+            m_prewarmed = false;
+            emit prewarmCancelled();
+        }
+        return;
+    }
+
+    const qint64 delayMs = qint64(m_timerEngine->remainingSeconds() - m_leadSeconds) * 1000;
+    if (delayMs > 0) {
+        // 截止时间推后 (重新开始计时、修改时长)：之前的准备作废
+        if (m_prewarmed) {
+            m_prewarmed = false;
+            emit prewarmCancelled();
+        }
+        m_prewarmTimer.start(int(qMin<qint64>(delayMs, INT_MAX)));
+        return;
+    }
+    m_prewarmTimer.stop();
+    if (!m_prewarmed) {
+        m_prewarmed = true;
+        emit prewarmDue();
+    }
+}
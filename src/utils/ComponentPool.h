@@ -0,0 +1,85 @@
+#pragma once
+#include <QObject>
+#include <QHash>
+#include <QPointer>
+#include <QTimer>
+#include <QUrl>
+#include <QVariantMap>
+
+class QQmlEngine;
+class QQmlComponent;
+class TimerEngine;
+
+// ========================================================================
+// ComponentPool：预编译 / 预创建顶层 QML 窗口
+// ========================================================================
+// 全屏提醒窗口 (粒子、Canvas、主题) 与活动看板在需要时才同步创建，第一帧
+// 要等完整的编译与实例化。这里把两步提前：
+// - precompile: 启动稳定后在后台线程编译组件 (QQmlComponent::Asynchronous)，
+//   之后的创建不再解析 QML。
+// - prepare: 用 QQmlIncubator 异步创建一个实例，由本类的孵化控制器在事件循环
+//   空闲时分片推进 (每片 kIncubateSliceMs)，不阻塞界面；窗口创建后保持隐藏。
+//   主窗口隐藏在托盘时 QQuickWindow 自带的控制器不运行，因此使用自己的控制器。
+//   注意：QQmlEngine 只有一个孵化控制器，构造函数 (引擎还没有控制器时) 为整个
+//   引擎安装一个 0 ms QTimer 驱动的控制器，之后 QQuickWindow 不再安装自己的，
+//   引擎中所有异步创建 (包括 Loader { asynchronous: true }) 都由它推进，
+//   不再跟随窗口的渲染节奏。必须在加载 QML 之前构造；析构时卸下。
+// - take: 取出准备好的实例 (仍在孵化则强制完成，没有准备则同步创建)，
+//   所有权交给 JS，用完由 QML destroy()。
+//
+// attachTimerEngine 后，在工作/贪睡倒计时剩余 leadSeconds 秒时发出 prewarmDue
+// (QML 在此选择主题并 prepare 提醒窗口)；倒计时被暂停、锁屏、停止或进入午休时
+// 发出 prewarmCancelled (QML discard 已准备的实例)。
+//
+// 指标 (core/Metrics.h)：
+//   pool.hit / pool.forced / pool.miss       take 时已就绪 / 强制完成 / 同步创建
+//   ui.<组件>.firstFrame.warm / .cold        take 到窗口第一帧 (hit 为 warm)
+// 提醒触发到全屏窗口第一帧的端到端时延仍为 ui.reminderToOverlay。
+// ========================================================================
+class ComponentPool : public QObject {
+    Q_OBJECT
+public:
+    explicit ComponentPool(QQmlEngine *engine, QObject *parent = nullptr);
+    ~ComponentPool();
+
+    // delayMs 后在后台编译这些组件 (避开启动阶段)
+    void precompile(const QList<QUrl> &urls, int delayMs);
+
+    // 根据计时引擎的截止时间发出 prewarmDue / prewarmCancelled
+    void attachTimerEngine(TimerEngine *engine, int leadSeconds = 60);
+
+    // 开始异步创建 key 对应的实例 (已有准备好的实例时丢弃重建)
+    Q_INVOKABLE void prepare(const QString &key, const QUrl &url, const QVariantMap &initialProperties);
+    // 取出 key 的实例；没有准备时以 initialProperties 同步创建。失败返回 null
+    Q_INVOKABLE QObject *take(const QString &key, const QUrl &url, const QVariantMap &initialProperties);
+    // 丢弃 key 已准备 (或正在孵化) 的实例
+    Q_INVOKABLE void discard(const QString &key);
+    // key 的实例已孵化完成
+    Q_INVOKABLE bool isReady(const QString &key) const;
+
+signals:
+    void prewarmDue();
+    void prewarmCancelled();
+
+private slots:
+    void onComponentStatusChanged();
+    void schedulePrewarm();
+
+private:
+    class Incubator;
+    class IncubationController;
+
+    QQmlComponent *component(const QUrl &url);
+    void startIncubation(Incubator *incubator);
+    void recordFirstFrame(QObject *object, const QUrl &url, bool warm);
+
+    QQmlEngine *m_engine;
+    IncubationController *m_controller = nullptr;
+    QHash<QUrl, QQmlComponent *> m_components;   // 已编译 (或正在编译) 的组件
+    QHash<QString, Incubator *> m_prepared;
+
+    QPointer<TimerEngine> m_timerEngine;
+    int m_leadSeconds = 60;
+    QTimer m_prewarmTimer;
+    bool m_prewarmed = false;
+};
@@ -0,0 +1,304 @@
+#include "ForegroundAppMonitor.h"
+#include "../core/Logging.h"
+#include <QSettings>
+#include <QFileInfo>
+#include <QSocketNotifier>
+
+#ifdef Q_OS_WIN
+#include <windows.h>
+#elif defined(Q_OS_LINUX)
+#include <xcb/xcb.h>
+#include <cstdlib>
+#include <cstring>
+#endif
+
+// ========================================================================
+// 平台实现
+// ========================================================================
+
+#ifdef Q_OS_WIN
+
+// WinEvent 回调没有用户数据参数，同一时刻只有一个监视器安装钩子
+static ForegroundAppMonitor *s_hookOwner = nullptr;
+
+static void CALLBACK onForegroundEvent(HWINEVENTHOOK, DWORD event, HWND, LONG idObject, LONG, DWORD, DWORD) {
+    if (event != EVENT_SYSTEM_FOREGROUND || idObject != OBJID_WINDOW || !s_hookOwner) return;
+    // 回调在消息循环中执行，排队到事件循环后再查询，避免在钩子内做耗时操作
+    QMetaObject::invokeMethod(s_hookOwner, "sample", Qt::QueuedConnection);
+}
+
+#elif defined(Q_OS_LINUX)
+
+namespace {
+
+struct XcbState {
+    xcb_connection_t *connection = nullptr;
+    xcb_window_t root = 0;
+    xcb_atom_t activeWindow = XCB_ATOM_NONE;
+    xcb_atom_t wmName = XCB_ATOM_NONE;
+    xcb_atom_t utf8String = XCB_ATOM_NONE;
+};
+
+xcb_atom_t internAtom(xcb_connection_t *connection, const char *name) {
+    xcb_intern_atom_reply_t *reply = xcb_intern_atom_reply(
+        connection, xcb_intern_atom(connection, 0, uint16_t(strlen(name)), name), nullptr);
+    const xcb_atom_t atom = reply ? reply->atom : xcb_atom_t(XCB_ATOM_NONE);
+    free(reply);
+    return atom;
+}
+
+QByteArray readProperty(xcb_connection_t *connection, xcb_window_t window, xcb_atom_t property,
+                        xcb_atom_t type, uint32_t maxLength = 1024) {
+    xcb_get_property_reply_t *reply = xcb_get_property_reply(
+        connection, xcb_get_property(connection, 0, window, property, type, 0, maxLength / 4), nullptr);
+    if (!reply) return QByteArray();
+    const QByteArray value(static_cast<const char *>(xcb_get_property_value(reply)),
+                           xcb_get_property_value_length(reply));
+    free(reply);
+    return value;
+}
+
+XcbState *openXcb() {
+    int screenNumber = 0;
+    xcb_connection_t *connection = xcb_connect(nullptr, &screenNumber);
+    if (!connection || xcb_connection_has_error(connection)) {
+        if (connection) xcb_disconnect(connection);
+        return nullptr;
+    }
+
+    xcb_screen_iterator_t it = xcb_setup_roots_iterator(xcb_get_setup(connection));
+    for (int i = 0; i < screenNumber && it.rem; ++i) xcb_screen_next(&it);
+    if (!it.rem) {
+        xcb_disconnect(connection);
+        return nullptr;
+    }
+
+    XcbState *state = new XcbState;
+    state->connection = connection;
+    state->root = it.data->root;
+    state->activeWindow = internAtom(connection, "_NET_ACTIVE_WINDOW");
+    state->wmName = internAtom(connection, "_NET_WM_NAME");
+    state->utf8String = internAtom(connection, "UTF8_STRING");
+    return state;
+}
+
+// 开始/停止接收窗口的属性变化 (只影响本连接的事件掩码)
+void watchProperties(const XcbState *state, xcb_window_t window, bool watch) {
+    const uint32_t mask = watch ? XCB_EVENT_MASK_PROPERTY_CHANGE : XCB_EVENT_MASK_NO_EVENT;
+    xcb_change_window_attributes(state->connection, window, XCB_CW_EVENT_MASK, &mask);
+}
+
+QString windowTitle(const XcbState *state, xcb_window_t window) {
+    const QByteArray name = readProperty(state->connection, window, state->wmName, state->utf8String);
+    if (!name.isEmpty()) return QString::fromUtf8(name);
+    return QString::fromLocal8Bit(readProperty(state->connection, window, XCB_ATOM_WM_NAME, XCB_ATOM_STRING));
+}
+
+QString windowApp(const XcbState *state, xcb_window_t window) {
+    // WM_CLASS = "实例名\0类名\0"，类名更稳定 (如 "firefox" / "Code")
+    const QList<QByteArray> parts = readProperty(state->connection, window, XCB_ATOM_WM_CLASS, XCB_ATOM_STRING).split('\0');
+    if (parts.size() >= 2 && !parts.at(1).isEmpty()) return QString::fromLocal8Bit(parts.at(1));
+    if (!parts.isEmpty()) return QString::fromLocal8Bit(parts.at(0));
+    return QString();
+}
+
+} // namespace
+
+#endif
+
+// ========================================================================
+// ForegroundAppMonitor
+// ========================================================================
+
+ForegroundAppMonitor::ForegroundAppMonitor(QObject *parent) : QObject(parent) {
+    m_sampleTimer.setInterval(SAMPLE_INTERVAL_MS);
+    connect(&m_sampleTimer, &QTimer::timeout, this, &ForegroundAppMonitor::sample);
+
+    QSettings settings("TraeAI", "DeskCare");
+    m_enabled = settings.value("AppUsage/enabled", false).toBool();
+}
+
+ForegroundAppMonitor::~ForegroundAppMonitor() {
+    stop();
+#ifdef Q_OS_LINUX
+    delete m_notifier;
+    if (XcbState *state = static_cast<XcbState *>(m_native)) {
+        xcb_disconnect(state->connection);
+        delete state;
+    }
+#endif
+}
+
+void ForegroundAppMonitor::setEnabled(bool enabled) {
+    if (m_enabled == enabled) return;
+    m_enabled = enabled;
+
+    QSettings settings("TraeAI", "DeskCare");
+    settings.setValue("AppUsage/enabled", enabled);
+
+    if (m_enabled && m_active) start();
+    else stop();
+    emit enabledChanged();
+}
+
+void ForegroundAppMonitor::setActive(bool active) {
+    if (m_active == active) return;
+    m_active = active;
+
+    if (m_enabled && m_active) start();
+    else stop();
+}
+
+void ForegroundAppMonitor::start() {
+    if (m_running) return;
+    m_running = true;
+
+#ifdef Q_OS_WIN
+    if (!s_hookOwner) {
+        // WINEVENT_OUTOFCONTEXT：事件以消息形式投递到本线程，无需注入 DLL
+        m_hook = SetWinEventHook(EVENT_SYSTEM_FOREGROUND, EVENT_SYSTEM_FOREGROUND, nullptr,
+                                 onForegroundEvent, 0, 0, WINEVENT_OUTOFCONTEXT | WINEVENT_SKIPOWNPROCESS);
+        if (m_hook) s_hookOwner = this;
+    }
+    if (!m_hook) m_sampleTimer.start(); // 钩子不可用时退回采样
+#elif defined(Q_OS_LINUX)
+    if (!m_native) {
+        m_native = openXcb();
+        if (!m_native) qCWarning(lcEngine) << "ForegroundAppMonitor: no X11 display, app usage tracking unavailable";
+    }
+    if (const XcbState *state = static_cast<XcbState *>(m_native)) {
+        if (!m_notifier) {
+            m_notifier = new QSocketNotifier(xcb_get_file_descriptor(state->connection), QSocketNotifier::Read);
+            connect(m_notifier, &QSocketNotifier::activated, this, &ForegroundAppMonitor::onXcbEvents);
+        }
+        watchProperties(state, state->root, true);
+        xcb_flush(state->connection);
+        m_notifier->setEnabled(true);
+    }
+#endif
+
+    sample();
+}
+
+void ForegroundAppMonitor::stop() {
+    if (!m_running) return;
+    m_running = false;
+    m_sampleTimer.stop();
+
+#ifdef Q_OS_WIN
+    if (m_hook) {
+        UnhookWinEvent(static_cast<HWINEVENTHOOK>(m_hook));
+        m_hook = nullptr;
+        s_hookOwner = nullptr;
+    }
+#elif defined(Q_OS_LINUX)
+    // 不再需要事件：取消监听，X 服务器不再发送
+    if (const XcbState *state = static_cast<XcbState *>(m_native)) {
+        m_notifier->setEnabled(false);
+        watchProperties(state, state->root, false);
+        if (m_lastWindow) watchProperties(state, m_lastWindow, false);
+        xcb_flush(state->connection);
+        m_lastWindow = 0;
+    }
+#endif
+
+    setForeground(QString(), QString());
+}
+
+void ForegroundAppMonitor::sample() {
+    if (!m_running) return;
+
+    QString app, title;
+    if (queryForeground(&app, &title)) setForeground(app, title);
+}
+
+void ForegroundAppMonitor::onXcbEvents() {
+#ifdef Q_OS_LINUX
+    const XcbState *state = static_cast<XcbState *>(m_native);
+    if (!state) return;
+
+    // 同步查询 (xcb_*_reply) 期间到达的事件已被读进 xcb 的队列，不会再触发
+    // 套接字通知，这里一并取出。错误 (例如监听的窗口已关闭) 同样忽略
+    bool changed = false;
+    while (xcb_generic_event_t *event = xcb_poll_for_event(state->connection)) {
+        if ((event->response_type & ~0x80) == XCB_PROPERTY_NOTIFY) {
+            const auto *notify = reinterpret_cast<const xcb_property_notify_event_t *>(event);
+            if (notify->window == state->root) {
+                changed |= notify->atom == state->activeWindow;
+            } else if (notify->window == m_lastWindow) {
+                changed |= notify->atom == state->wmName || notify->atom == XCB_ATOM_WM_NAME;
+            }
+        }
+        free(event);
+    }
+    if (xcb_connection_has_error(state->connection)) {
+        qCWarning(lcEngine) << "ForegroundAppMonitor: X11 connection lost, app usage tracking stopped";
+        m_notifier->setEnabled(false);
+        return;
+    }
+    if (changed) sample();
+#endif
+}
+
+void ForegroundAppMonitor::setForeground(const QString &app, const QString &title) {
+    if (app == m_app && title == m_title) return;
+    m_app = app;
+    m_title = title;
+    emit foregroundChanged(m_app, m_title);
+}
+
+bool ForegroundAppMonitor::queryForeground(QString *app, QString *title) {
+#ifdef Q_OS_WIN
+    HWND hwnd = GetForegroundWindow();
+    if (!hwnd) return false;
+
+    wchar_t titleBuffer[512];
+    const int titleLength = GetWindowTextW(hwnd, titleBuffer, 512);
+    *title = QString::fromWCharArray(titleBuffer, qMax(0, titleLength));
+
+    DWORD pid = 0;
+    GetWindowThreadProcessId(hwnd, &pid);
+    HANDLE process = OpenProcess(PROCESS_QUERY_LIMITED_INFORMATION, FALSE, pid);
+    if (!process) return false;
+
+    wchar_t pathBuffer[MAX_PATH];
+    DWORD pathLength = MAX_PATH;
+    const bool ok = QueryFullProcessImageNameW(process, 0, pathBuffer, &pathLength) != FALSE;
+    CloseHandle(process);
+    if (!ok) return false;
+
+    *app = QFileInfo(QString::fromWCharArray(pathBuffer, int(pathLength))).completeBaseName();
+    return true;
+#elif defined(Q_OS_LINUX)
+    const XcbState *state = static_cast<XcbState *>(m_native);
+    if (!state || xcb_connection_has_error(state->connection)) return false;
+    // 查询期间读进队列的事件不会再触发套接字通知，回到事件循环后处理
+    QMetaObject::invokeMethod(this, &ForegroundAppMonitor::onXcbEvents, Qt::QueuedConnection);
+
+    const QByteArray active = readProperty(state->connection, state->root, state->activeWindow, XCB_ATOM_WINDOW, 4);
+    if (active.size() < int(sizeof(xcb_window_t))) return false;
+    xcb_window_t window = 0;
+    memcpy(&window, active.constData(), sizeof(window));
+    if (window == 0) return false;
+
+    // 窗口未变：应用不变，只刷新标题 (浏览器切换标签页等)
+    *title = windowTitle(state, window);
+    if (window == m_lastWindow && !m_app.isEmpty()) {
+        *app = m_app;
+    } else {
+        *app = windowApp(state, window);
+        // 改为监听新活动窗口的标题
+        if (window != m_lastWindow) {
+            if (m_lastWindow) watchProperties(state, m_lastWindow, false);
+            watchProperties(state, window, true);
+            xcb_flush(state->connection);
+            m_lastWindow = window;
+        }
+    }
+    return !app->isEmpty();
+#else
+    Q_UNUSED(app);
+    Q_UNUSED(title);
+    return false;
+#endif
+}
@@ -0,0 +1,74 @@
+#pragma once
+#include <QObject>
+#include <QString>
+#include <QTimer>
+
+class QSocketNotifier;
+
+// ========================================================================
+// ForegroundAppMonitor：前台应用检测
+// ========================================================================
+// 作用：报告当前前台窗口所属的应用名与窗口标题，ActivityLogger 据此
+// 统计每段专注会话中各应用的使用时长。
+// - Windows：SetWinEventHook(EVENT_SYSTEM_FOREGROUND) 事件驱动，切换窗口时
+//   才查询一次进程名，平时零开销。
+// - Linux (X11)：独立的 xcb 连接，监听根窗口 _NET_ACTIVE_WINDOW 与活动窗口
+//   标题的 PropertyNotify (QSocketNotifier 监视 xcb 套接字)，有变化时才查询；
+//   窗口未变时只读标题。Wayland 下只能看到 XWayland 窗口。
+// - 其他平台：不支持，始终为空。
+// 默认关闭 (涉及隐私)，由 QSettings("TraeAI", "DeskCare") 的
+// AppUsage/enabled 控制；开启后也只在 setActive(true) (专注中) 时采样。
+// 窗口标题只保存在内存中，不写入数据库。
+// ========================================================================
+class ForegroundAppMonitor : public QObject {
+    Q_OBJECT
+
+    Q_PROPERTY(bool enabled READ isEnabled WRITE setEnabled NOTIFY enabledChanged)
+    Q_PROPERTY(QString currentApp READ currentApp NOTIFY foregroundChanged)
+    Q_PROPERTY(QString currentTitle READ currentTitle NOTIFY foregroundChanged)
+
+public:
+    explicit ForegroundAppMonitor(QObject *parent = nullptr);
+    ~ForegroundAppMonitor();
+
+    bool isEnabled() const { return m_enabled; }
+    void setEnabled(bool enabled);
+
+    // 是否需要采样 (由专注状态驱动)
+    void setActive(bool active);
+
+    QString currentApp() const { return m_app; }
+    QString currentTitle() const { return m_title; }
+
+signals:
+    void enabledChanged();
+    // 前台应用或标题改变 (停止采样时以空应用名通知一次)
+    void foregroundChanged(const QString &app, const QString &title);
+
+private slots:
+    // 查询一次当前前台窗口
+    void sample();
+    // Linux: 处理 xcb 连接上的事件
+    void onXcbEvents();
+
+private:
+    void start();
+    void stop();
+    void setForeground(const QString &app, const QString &title);
+    // 平台相关查询，不支持或失败时返回 false
+    bool queryForeground(QString *app, QString *title);
+
+    static const int SAMPLE_INTERVAL_MS = 5000; // Windows 钩子不可用时的采样间隔
+
+    bool m_enabled = false;
+    bool m_active = false;
+    bool m_running = false;
+    QString m_app;
+    QString m_title;
+
+    QTimer m_sampleTimer;     // 采样兜底 (Windows 钩子不可用时)
+    void *m_hook = nullptr;   // Windows: HWINEVENTHOOK
+    void *m_native = nullptr; // Linux: xcb 连接状态
+    QSocketNotifier *m_notifier = nullptr; // Linux: xcb 套接字可读
+    quint32 m_lastWindow = 0; // Linux: 上次的活动窗口 (同时监听其标题变化)
+};
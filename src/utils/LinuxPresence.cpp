@@ -0,0 +1,202 @@
+#include "LinuxPresence.h"
+#include "../core/Logging.h"
+#include <QCoreApplication>
+#include <QDBusConnection>
+#include <QDBusConnectionInterface>
+#include <QDBusMessage>
+#include <QDBusObjectPath>
+#include <QDBusPendingCallWatcher>
+#include <QDBusPendingReply>
+#include <QDBusServiceWatcher>
+#include <QDBusVariant>
+
+static const char *kLogindService = "org.freedesktop.login1";
+static const char *kLogindSessionInterface = "org.freedesktop.login1.Session";
+static const char *kPropertiesInterface = "org.freedesktop.DBus.Properties";
+
+static const char *kIdleService = "org.gnome.Mutter.IdleMonitor";
+static const char *kIdlePath = "/org/gnome/Mutter/IdleMonitor/Core";
+static const char *kIdleInterface = "org.gnome.Mutter.IdleMonitor";
+
+// logind 对象路径中的会话 id 转义 (sd_bus_path_encode)：非字母数字及开头的数字写成 _xx
+static QString encodeSessionPath(const QString &sessionId) {
+    QString path = QStringLiteral("/org/freedesktop/login1/session/");
+    const QByteArray id = sessionId.toUtf8();
+    for (int i = 0; i < id.size(); ++i) {
+        const char c = id.at(i);
+        const bool alpha = (c >= 'a' && c <= 'z') || (c >= 'A' && c <= 'Z');
+        const bool digit = c >= '0' && c <= '9';
+        if (alpha || (digit && i > 0)) {
+            path += QLatin1Char(c);
+        } else {
+            path += QString("_%1").arg(quint8(c), 2, 16, QLatin1Char('0'));
+        }
+    }
+    return path;
+}
+
+// ========================================================================
+// LogindPresenceSource
+// ========================================================================
+
+LogindPresenceSource::LogindPresenceSource(QObject *parent) : PresenceSource(parent) {
+    // 屏保 (会话总线)：不限定发送方，KDE/GNOME/Xfce 的实现都能收到
+    QDBusConnection session = QDBusConnection::sessionBus();
+    if (session.isConnected()) {
+        session.connect(QString(), "/org/freedesktop/ScreenSaver", "org.freedesktop.ScreenSaver", "ActiveChanged",
+                        this, SLOT(onScreenSaverActiveChanged(bool)));
+        session.connect(QString(), "/org/gnome/ScreenSaver", "org.gnome.ScreenSaver", "ActiveChanged",
+                        this, SLOT(onScreenSaverActiveChanged(bool)));
+    }
+
+    // logind (系统总线)：先确定当前会话的对象路径
+    QDBusConnection system = QDBusConnection::systemBus();
+    if (!system.isConnected()) {
+        qCWarning(lcEngine) << "Presence: system bus unavailable, logind lock detection disabled";
+        return;
+    }
+
+    const QString sessionId = qEnvironmentVariable("XDG_SESSION_ID");
+    if (!sessionId.isEmpty()) {
+        attachSession(encodeSessionPath(sessionId));
+        return;
+    }
+
+    // 没有 XDG_SESSION_ID (例如由用户级服务启动)：按进程号异步查询
+    QDBusMessage call = QDBusMessage::createMethodCall(kLogindService, "/org/freedesktop/login1",
+                                                       "org.freedesktop.login1.Manager", "GetSessionByPID");
+    call.setArguments({ quint32(QCoreApplication::applicationPid()) });
+    auto *watcher = new QDBusPendingCallWatcher(system.asyncCall(call), this);
+    connect(watcher, &QDBusPendingCallWatcher::finished, this, [this, watcher]() {
+        QDBusPendingReply<QDBusObjectPath> reply = *watcher;
+        if (reply.isError()) {
+            qCWarning(lcEngine) << "Presence: no logind session for this process:" << reply.error().message();
+        } else {
+            attachSession(reply.value().path());
+        }
+        watcher->deleteLater();
+    });
+}
+
+void LogindPresenceSource::attachSession(const QString &sessionPath) {
+    m_sessionPath = sessionPath;
+    QDBusConnection system = QDBusConnection::systemBus();
+
+    system.connect(kLogindService, m_sessionPath, kLogindSessionInterface, "Lock",
+                   this, SLOT(onSessionLock()));
+    system.connect(kLogindService, m_sessionPath, kLogindSessionInterface, "Unlock",
+                   this, SLOT(onSessionUnlock()));
+    system.connect(kLogindService, m_sessionPath, kPropertiesInterface, "PropertiesChanged",
+                   this, SLOT(onSessionPropertiesChanged(QString,QVariantMap,QStringList)));
+
+    // 初始状态 (程序可能在锁屏期间启动)
+    QDBusMessage call = QDBusMessage::createMethodCall(kLogindService, m_sessionPath, kPropertiesInterface, "Get");
+    call.setArguments({ QString(kLogindSessionInterface), QStringLiteral("LockedHint") });
+    auto *watcher = new QDBusPendingCallWatcher(system.asyncCall(call), this);
+    connect(watcher, &QDBusPendingCallWatcher::finished, this, [this, watcher]() {
+        QDBusPendingReply<QDBusVariant> reply = *watcher;
+        if (!reply.isError()) {
+            m_sessionLocked = reply.value().variant().toBool();
+            update();
+        }
+        watcher->deleteLater();
+    });
+    qCDebug(lcEngine) << "Presence: watching logind session" << m_sessionPath;
+}
+
+void LogindPresenceSource::onSessionLock() {
+    m_sessionLocked = true;
+    update();
+}
+
+void LogindPresenceSource::onSessionUnlock() {
+    m_sessionLocked = false;
+    update();
+}
+
+void LogindPresenceSource::onSessionPropertiesChanged(const QString &interface, const QVariantMap &changed,
+                                                      const QStringList &invalidated) {
+    Q_UNUSED(invalidated);
+    if (interface != QLatin1String(kLogindSessionInterface)) return;
+    auto it = changed.constFind(QStringLiteral("LockedHint"));
+    if (it == changed.constEnd()) return;
+    m_sessionLocked = it->toBool();
+    update();
+}
+
+void LogindPresenceSource::onScreenSaverActiveChanged(bool active) {
+    m_screenSaverActive = active;
+    update();
+}
+
+void LogindPresenceSource::update() {
+    setLocked(m_sessionLocked || m_screenSaverActive);
+}
+
+// ========================================================================
+// IdleMonitorPresenceSource
+// ========================================================================
+
+IdleMonitorPresenceSource::IdleMonitorPresenceSource(qint64 idleMs, QObject *parent)
+    : PresenceSource(parent), m_idleMs(idleMs)
+{
+    QDBusConnection session = QDBusConnection::sessionBus();
+    m_serviceWatcher = new QDBusServiceWatcher(kIdleService, session,
+                                               QDBusServiceWatcher::WatchForRegistration
+                                               | QDBusServiceWatcher::WatchForUnregistration, this);
+    connect(m_serviceWatcher, &QDBusServiceWatcher::serviceRegistered, this, &IdleMonitorPresenceSource::registerWatches);
+    connect(m_serviceWatcher, &QDBusServiceWatcher::serviceUnregistered, this, &IdleMonitorPresenceSource::onServiceUnregistered);
+
+    if (!session.isConnected()) {
+        qCWarning(lcEngine) << "Presence: session bus unavailable, idle detection disabled";
+        return;
+    }
+    session.connect(kIdleService, kIdlePath, kIdleInterface, "WatchFired", this, SLOT(onWatchFired(uint)));
+
+    if (session.interface() && session.interface()->isServiceRegistered(kIdleService)) {
+        registerWatches();
+    } else {
+        qCDebug(lcEngine) << "Presence: Mutter IdleMonitor not available, idle detection inactive";
+    }
+}
+
+void IdleMonitorPresenceSource::addWatch(const QString &method, const QVariantList &args, uint *watchId) {
+    QDBusMessage call = QDBusMessage::createMethodCall(kIdleService, kIdlePath, kIdleInterface, method);
+    call.setArguments(args);
+    auto *watcher = new QDBusPendingCallWatcher(QDBusConnection::sessionBus().asyncCall(call), this);
+    connect(watcher, &QDBusPendingCallWatcher::finished, this, [watcher, watchId, method]() {
+        QDBusPendingReply<uint> reply = *watcher;
+        if (reply.isError()) {
+            qCWarning(lcEngine) << "Presence: IdleMonitor" << method << "failed:" << reply.error().message();
+        } else {
+            *watchId = reply.value();
+        }
+        watcher->deleteLater();
+    });
+}
+
+void IdleMonitorPresenceSource::registerWatches() {
+    // 监视随 D-Bus 连接断开自动注销，合成器重启后需要重新注册
+    m_idleWatch = 0;
+    m_activeWatch = 0;
+    setIdle(false);
+    addWatch("AddIdleWatch", { QVariant::fromValue(quint64(m_idleMs)) }, &m_idleWatch);
+}
+
+void IdleMonitorPresenceSource::onServiceUnregistered() {
+    m_idleWatch = 0;
+    m_activeWatch = 0;
+    setIdle(false);
+}
+
+void IdleMonitorPresenceSource::onWatchFired(uint id) {
+    if (id == 0) return;
+    if (id == m_idleWatch) {
+        // 已空闲 idleMs：等待下一次输入
+        setIdle(true);
+        addWatch("AddUserActiveWatch", {}, &m_activeWatch);
+    } else if (id == m_activeWatch) {
+        m_activeWatch = 0;
+        setIdle(false);
+    }
+}
@@ -0,0 +1,68 @@
+#pragma once
+#include "PresenceSource.h"
+#include <QVariantMap>
+#include <QStringList>
+
+class QDBusServiceWatcher;
+
+// ========================================================================
+// Linux 在场检测源 (D-Bus，仅 Linux 编译)
+// ========================================================================
+
+// ------------------------------------------------------------------------
+// LogindPresenceSource：锁屏检测
+// ------------------------------------------------------------------------
+// 监听 systemd-logind 当前会话的 Lock/Unlock 信号与 LockedHint 属性，
+// 以及会话总线上的 org.freedesktop.ScreenSaver / org.gnome.ScreenSaver
+// ActiveChanged 信号 (不依赖 logind 的桌面环境)。任一来源为锁定即视为锁屏。
+class LogindPresenceSource : public PresenceSource {
+    Q_OBJECT
+public:
+    explicit LogindPresenceSource(QObject *parent = nullptr);
+
+    QString name() const override { return QStringLiteral("logind"); }
+
+private slots:
+    void onSessionLock();
+    void onSessionUnlock();
+    void onSessionPropertiesChanged(const QString &interface, const QVariantMap &changed,
+                                    const QStringList &invalidated);
+    void onScreenSaverActiveChanged(bool active);
+
+private:
+    // 已知会话路径后订阅其信号并读取初始 LockedHint
+    void attachSession(const QString &sessionPath);
+    void update();
+
+    QString m_sessionPath;
+    bool m_sessionLocked = false;
+    bool m_screenSaverActive = false;
+};
+
+// ------------------------------------------------------------------------
+// IdleMonitorPresenceSource：空闲检测
+// ------------------------------------------------------------------------
+// 使用 GNOME Mutter 的 IdleMonitor：注册一个 idleMs 的空闲监视，触发后
+// 再注册一次"用户活动"监视，两者都由合成器在事件发生时通知，无需轮询。
+// 合成器重启时自动重新注册；非 GNOME 桌面上该服务不存在，此来源不生效。
+class IdleMonitorPresenceSource : public PresenceSource {
+    Q_OBJECT
+public:
+    explicit IdleMonitorPresenceSource(qint64 idleMs, QObject *parent = nullptr);
+
+    QString name() const override { return QStringLiteral("idle"); }
+
+private slots:
+    void registerWatches();
+    void onServiceUnregistered();
+    void onWatchFired(uint id);
+
+private:
+    // 异步调用 IdleMonitor 的 Add*Watch 方法，返回的监视 id 写入 *watchId
+    void addWatch(const QString &method, const QVariantList &args, uint *watchId);
+
+    qint64 m_idleMs;
+    uint m_idleWatch = 0;   // 空闲监视 (持续有效)
+    uint m_activeWatch = 0; // 用户活动监视 (触发一次后失效)
+    QDBusServiceWatcher *m_serviceWatcher;
+};
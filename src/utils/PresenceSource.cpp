@@ -0,0 +1,16 @@
+#include "PresenceSource.h"
+#include "../core/Logging.h"
+
+void PresenceSource::setLocked(bool locked) {
+    if (m_locked == locked) return;
+    m_locked = locked;
+    qCDebug(lcEngine) << "Presence:" << name() << (locked ? "locked" : "unlocked");
+    emit presenceChanged();
+}
+
+void PresenceSource::setIdle(bool idle) {
+    if (m_idle == idle) return;
+    m_idle = idle;
+    qCDebug(lcEngine) << "Presence:" << name() << (idle ? "idle" : "active");
+    emit presenceChanged();
+}
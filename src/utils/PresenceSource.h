@@ -0,0 +1,53 @@
+#pragma once
+#include <QObject>
+#include <QString>
+
+// ========================================================================
+// PresenceSource：用户在场检测源 (可插拔)
+// ========================================================================
+// 作用：把"用户是否离开"的各种来源 (锁屏、长时间无输入) 抽象为统一接口，
+// WindowUtils 汇总所有来源后发出 sessionStateChanged，驱动 TimerEngine
+// 的自动暂停/恢复。所有实现都是事件驱动的，不轮询。
+// - Windows：会话通知由 WindowUtils 内部的 SysMsgWindow 处理
+// - Linux：LogindPresenceSource (锁屏)、IdleMonitorPresenceSource (空闲)，
+//   见 LinuxPresence.h
+// - FakePresenceSource：手动设置状态，用于模拟与测试
+// ========================================================================
+class PresenceSource : public QObject {
+    Q_OBJECT
+public:
+    using QObject::QObject;
+
+    // 来源名称 (用于日志)
+    virtual QString name() const = 0;
+
+    bool isLocked() const { return m_locked; }
+    bool isIdle() const { return m_idle; }
+
+signals:
+    // 锁屏或空闲状态改变
+    void presenceChanged();
+
+protected:
+    // 状态真正改变时才发出 presenceChanged
+    void setLocked(bool locked);
+    void setIdle(bool idle);
+
+private:
+    bool m_locked = false;
+    bool m_idle = false;
+};
+
+// ========================================================================
+// FakePresenceSource：手动控制的检测源
+// ========================================================================
+class FakePresenceSource : public PresenceSource {
+    Q_OBJECT
+public:
+    using PresenceSource::PresenceSource;
+
+    QString name() const override { return QStringLiteral("fake"); }
+
+    using PresenceSource::setLocked;
+    using PresenceSource::setIdle;
+};
@@ -0,0 +1,285 @@
+#include "QmlMemoryProbe.h"
+#include "core/ProcessStats.h"
+#include "core/Logging.h"
+#include <QCoreApplication>
+#include <QGuiApplication>
+#include <QElapsedTimer>
+#include <QOffscreenSurface>
+#include <QOpenGLContext>
+#include <QOpenGLFunctions>
+#include <QQmlEngine>
+#include <QQuickWindow>
+#include <QTimer>
+#include <QWindow>
+#include <algorithm>
+#include <cmath>
+
+#ifdef DESKCARE_HAVE_QML_PRIVATE
+#include <private/qv4engine_p.h>
+#include <private/qv4mm_p.h>
+#endif
+
+#if defined(__GLIBC__)
+#include <malloc.h>
+#endif
+
+// 驱动扩展的查询枚举 (单位 KB)
+static const GLenum kGpuMemAvailableNvx = 0x9049; // GL_GPU_MEMORY_INFO_CURRENT_AVAILABLE_VIDMEM_NVX
+static const GLenum kTextureFreeMemoryAti = 0x87FC; // GL_TEXTURE_FREE_MEMORY_ATI
+
+QmlMemoryProbe::QmlMemoryProbe(QQmlEngine *engine, int settleMs, QObject *parent)
+    : QObject(parent), m_engine(engine), m_settleMs(settleMs)
+{
+    // QObject 计数需要尽早安装钩子；之前创建的对象不计入，不影响增量
+    ProcessStats::trackQObjects();
+    m_gpuAvailableAtStart = gpuAvailableBytes();
+#ifndef DESKCARE_HAVE_QML_PRIVATE
+    qCInfo(lcUi) << "QmlMemoryProbe: built without QtQml private headers, JS heap is not reported";
+#endif
+    if (m_gpuAvailableAtStart < 0) qCInfo(lcUi) << "QmlMemoryProbe: GPU memory query unavailable";
+}
+
+QmlMemoryProbe::~QmlMemoryProbe() {
+    delete m_glContext;
+    delete m_glSurface;
+}
+
+// ========================================================================
+// 采样
+// ========================================================================
+
+QmlMemoryProbe::Snapshot QmlMemoryProbe::snapshot() {
+    Snapshot s;
+
+    QElapsedTimer gc;
+    gc.start();
+    m_engine->collectGarbage();
+    s.gcMs = gc.nsecsElapsed() / 1e6;
+
+    // 回收释放的 JS 包装对象可能带出 deleteLater 的 QObject，删除后再回收一次
+    QCoreApplication::sendPostedEvents(nullptr, QEvent::DeferredDelete);
+    m_engine->collectGarbage();
+
+    // 丢弃可重建的场景图资源 (字形缓存、未被引用的纹理等)；线程化渲染循环中同步完成
+    for (QWindow *window : QGuiApplication::topLevelWindows()) {
+        if (auto *quickWindow = qobject_cast<QQuickWindow *>(window)) quickWindow->releaseResources();
+    }
+#if defined(__GLIBC__)
+    malloc_trim(0);
+#endif
+
+    s.residentBytes = ProcessStats::residentBytes();
+    s.qobjects = ProcessStats::liveQObjects();
+#ifdef DESKCARE_HAVE_QML_PRIVATE
+    if (QV4::ExecutionEngine *v4 = m_engine->handle()) {
+        s.jsUsedBytes = qint64(v4->memoryManager->getUsedMem());
+        s.jsAllocatedBytes = qint64(v4->memoryManager->getAllocatedMem());
+        s.jsLargeItemBytes = qint64(v4->memoryManager->getLargeItemsMem());
+    }
+#endif
+    const qint64 available = gpuAvailableBytes();
+    if (available >= 0 && m_gpuAvailableAtStart >= 0) s.gpuBytes = m_gpuAvailableAtStart - available;
+    s.valid = true;
+    return s;
+}
+
+qint64 QmlMemoryProbe::gpuAvailableBytes() {
+    if (!m_glTried) {
+        m_glTried = true;
+        m_glContext = new QOpenGLContext;
+        m_glContext->setShareContext(QOpenGLContext::globalShareContext());
+        m_glSurface = new QOffscreenSurface;
+        if (m_glContext->create()) {
+            m_glSurface->setFormat(m_glContext->format());
+            m_glSurface->create();
+        }
+        if (!m_glContext->isValid() || !m_glSurface->isValid()) {
+            delete m_glContext;
+            delete m_glSurface;
+            m_glContext = nullptr;
+            m_glSurface = nullptr;
+        }
+    }
+    if (!m_glContext || !m_glContext->makeCurrent(m_glSurface)) return -1;
+
+    GLint values[4] = { -1, -1, -1, -1 };
+    if (m_glContext->hasExtension("GL_NVX_gpu_memory_info")) {
+        m_glContext->functions()->glGetIntegerv(kGpuMemAvailableNvx, values);
+    } else if (m_glContext->hasExtension("GL_ATI_meminfo")) {
+        m_glContext->functions()->glGetIntegerv(kTextureFreeMemoryAti, values);
+    }
+    m_glContext->doneCurrent();
+    return values[0] < 0 ? -1 : qint64(values[0]) * 1024;
+}
+
+// ========================================================================
+// 周期
+// ========================================================================
+
+void QmlMemoryProbe::watch(QObject *loader, const QString &component) {
+    if (!loader || m_loaders.contains(loader)) return;
+    if (loader->metaObject()->indexOfSignal("activeChanged()") < 0) {
+        qCWarning(lcUi) << "QmlMemoryProbe: not a Loader:" << component;
+        return;
+    }
+    m_loaders.insert(loader, component);
+    connect(loader, SIGNAL(activeChanged()), this, SLOT(onLoaderActiveChanged()));
+    connect(loader, &QObject::destroyed, this, [this, loader]() { m_loaders.remove(loader); });
+
+    // 起始基线：等主界面加载完成、稳定之后
+    const int generation = m_components[component].generation;
+    QTimer::singleShot(m_settleMs, this, [this, component, generation]() {
+        ComponentState &state = m_components[component];
+        if (state.generation == generation && !state.baseline.valid) recordBaseline(component);
+    });
+}
+
+void QmlMemoryProbe::onLoaderActiveChanged() {
+    QObject *loader = sender();
+    const QString component = m_loaders.value(loader);
+    if (component.isEmpty()) return;
+
+    // Loader 在 setActive 中同步创建/销毁内容，之后才发出 activeChanged；
+    // 不能在这里删除对象，等渲染和动画结束后再采样
+    const bool active = loader->property("active").toBool();
+    const int generation = ++m_components[component].generation;
+    QTimer::singleShot(m_settleMs, this, [this, component, generation, active]() {
+        if (m_components.value(component).generation != generation) return;
+        if (active) recordLoaded(component);
+        else recordUnloaded(component);
+    });
+}
+
+void QmlMemoryProbe::recordBaseline(const QString &component) {
+    m_components[component].baseline = snapshot();
+}
+
+void QmlMemoryProbe::recordLoaded(const QString &component) {
+    ComponentState &state = m_components[component];
+    // 上一次卸载还没来得及采样就再次加载时，两次加载合并为一个周期
+    if (!state.loaded.valid) ++state.loads;
+    state.loaded = snapshot();
+}
+
+void QmlMemoryProbe::recordUnloaded(const QString &component) {
+    ComponentState &state = m_components[component];
+    Cycle cycle;
+    cycle.component = component;
+    if (!state.loaded.valid) ++state.loads; // 加载后很快关闭，没有 loaded 快照
+    cycle.index = state.loads;
+    cycle.before = state.baseline;
+    cycle.loaded = state.loaded;
+    cycle.after = snapshot();
+
+    state.baseline = cycle.after;
+    state.loaded = Snapshot();
+    state.cycles.append(cycle);
+    if (state.cycles.size() > kMaxCycles) state.cycles.removeFirst();
+
+    if (cycle.before.valid) {
+        qCDebug(lcUi).nospace() << "QmlMemoryProbe: " << component << " cycle " << cycle.index
+                                << ": rss " << (cycle.after.residentBytes - cycle.before.residentBytes) / 1024
+                                << " KB, qobjects " << cycle.after.qobjects - cycle.before.qobjects
+                                << ", js " << (cycle.after.jsUsedBytes - cycle.before.jsUsedBytes) / 1024 << " KB";
+    }
+    emit cycleCompleted(component);
+}
+
+QVector<QmlMemoryProbe::Cycle> QmlMemoryProbe::cycles(const QString &component) const {
+    return m_components.value(component).cycles;
+}
+
+QStringList QmlMemoryProbe::components() const {
+    QStringList names = m_components.keys();
+    std::sort(names.begin(), names.end());
+    return names;
+}
+
+// ========================================================================
+// 断言与报告
+// ========================================================================
+
+namespace {
+
+struct Metric {
+    const char *name;
+    qint64 QmlMemoryProbe::Snapshot::*field;
+    double scale;      // 报告中的单位换算
+    const char *unit;
+};
+
+// 前 kAssertedMetrics 项参与 expectReleased；gpu 是整个设备的读数，只报告
+const int kAssertedMetrics = 3;
+const Metric kMetrics[] = {
+    { "rss", &QmlMemoryProbe::Snapshot::residentBytes, 1024, "KB" },
+    { "qobjects", &QmlMemoryProbe::Snapshot::qobjects, 1, "" },
+    { "js", &QmlMemoryProbe::Snapshot::jsUsedBytes, 1024, "KB" },
+    { "gpu", &QmlMemoryProbe::Snapshot::gpuBytes, 1024, "KB" },
+};
+
+// a -> b 的差值；任一侧不可用时为 NaN
+double delta(const QmlMemoryProbe::Snapshot &a, const QmlMemoryProbe::Snapshot &b, qint64 QmlMemoryProbe::Snapshot::*field) {
+    if (!a.valid || !b.valid || a.*field < 0 || b.*field < 0) return std::nan("");
+    return double(b.*field - a.*field);
+}
+
+// 第一个保留周期之后，平均每周期的残留
+double retainedPerCycle(const QVector<QmlMemoryProbe::Cycle> &cycles, qint64 QmlMemoryProbe::Snapshot::*field) {
+    if (cycles.size() < 2) return std::nan("");
+    return delta(cycles.first().after, cycles.last().after, field) / (cycles.size() - 1);
+}
+
+QString formatValue(double value, const Metric &metric) {
+    if (std::isnan(value)) return QStringLiteral("n/a");
+    return QString("%1%2%3").arg(value >= 0 ? "+" : "").arg(value / metric.scale, 0, 'f', metric.scale > 1 ? 0 : 1)
+        .arg(metric.unit);
+}
+
+} // namespace
+
+bool QmlMemoryProbe::expectReleased(const QString &component, const Tolerance &tolerance, QString *failure) const {
+    const QVector<Cycle> list = cycles(component);
+    failure->clear();
+    if (list.size() < 2) {
+        *failure = QString("%1: %2 load/unload cycle(s) recorded, at least 2 are needed").arg(component).arg(list.size());
+        return false;
+    }
+
+    const double limits[kAssertedMetrics] = { tolerance.residentBytes, tolerance.qobjects, tolerance.jsBytes };
+    for (int i = 0; i < kAssertedMetrics; ++i) {
+        const double retained = retainedPerCycle(list, kMetrics[i].field);
+        if (std::isnan(retained) || retained <= limits[i]) continue;
+        *failure += QString("%1: %2 retained %3 per cycle over %4 cycles (tolerance %5)\n").arg(component)
+                        .arg(kMetrics[i].name).arg(formatValue(retained, kMetrics[i])).arg(list.size() - 1)
+                        .arg(formatValue(limits[i], kMetrics[i]));
+    }
+    return failure->isEmpty();
+}
+
+QString QmlMemoryProbe::report() const {
+    QString text = QString("%1 %2  %3  %4  %5\n").arg("component", -24).arg("cycles", 6)
+                       .arg("first cycle (rss/qobjects/js/gpu)", -36).arg("loaded (median)", -36)
+                       .arg("retained per cycle");
+    for (const QString &component : components()) {
+        const QVector<Cycle> list = cycles(component);
+        if (list.isEmpty()) continue;
+
+        QStringList first, loaded, retained;
+        for (const Metric &metric : kMetrics) {
+            // 第一个周期已被淘汰时不再显示
+            first << (list.first().index == 1 ? formatValue(delta(list.first().before, list.first().after, metric.field), metric)
+                                              : QStringLiteral("-"));
+            QVector<double> peaks;
+            for (const Cycle &cycle : list) {
+                const double value = delta(cycle.before, cycle.loaded, metric.field);
+                if (!std::isnan(value)) peaks.append(value);
+            }
+            std::sort(peaks.begin(), peaks.end());
+            loaded << formatValue(peaks.isEmpty() ? std::nan("") : peaks.at(peaks.size() / 2), metric);
+            retained << formatValue(retainedPerCycle(list, metric.field), metric);
+        }
+        text += QString("%1 %2  %3  %4  %5\n").arg(component, -24).arg(list.last().index, 6)
+                    .arg(first.join('/'), -36).arg(loaded.join('/'), -36).arg(retained.join('/'));
+    }
+    return text;
+}
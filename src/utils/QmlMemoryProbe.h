@@ -0,0 +1,124 @@
+#pragma once
+#include <QObject>
+#include <QHash>
+#include <QPointer>
+#include <QString>
+#include <QVector>
+
+class QQmlEngine;
+class QOpenGLContext;
+class QOffscreenSurface;
+
+// ========================================================================
+// QmlMemoryProbe：按需加载的 QML 组件的内存核算 (诊断模式，--probe-qml-memory 开启)
+// ========================================================================
+// Main.qml 用 Loader 懒加载设置页、更新对话框、活动看板和全屏提醒窗口，
+// 关闭时 active = false 以释放内存。这里检查内存是否真的回来了：每个组件的
+// 每一次 "加载 -> 卸载" 为一个周期，记录三个快照：
+//   before  上一次卸载后 (第一次为开始监视时) 的稳定状态
+//   loaded  加载并渲染之后
+//   after   卸载、回收之后
+// 快照前先执行 JS 垃圾回收、处理延迟删除、让所有 QQuickWindow 释放可重建的
+// 场景图资源 (releaseResources)，glibc 下再把空闲堆还给系统 (malloc_trim)，
+// 使读数只反映仍被引用的内存。快照内容：
+//   - 常驻内存、存活 QObject (core/ProcessStats.h)
+//   - JS 堆：已用 / 已分配 / 大对象字节数与一次回收的耗时。需要 QtQml 私有
+//     头文件 (app.pro 中检测 qml-private)，缺少时为 -1
+//   - 显存：相对探针创建时的占用 (GL_NVX_gpu_memory_info / GL_ATI_meminfo
+//     驱动扩展，整个设备的读数)，没有 OpenGL 或驱动不支持时为 -1。
+//     场景图没有公开的纹理统计，CPU 侧的图片缓存计入常驻内存
+//
+// 第一个周期包含类型编译、图片缓存等一次性开销，判断泄漏时不计入；之后每个
+// 周期卸载后的读数都应回到加载前的水平，expectReleased 按平均每周期的增量断言。
+// 显存是整个设备的读数 (其他进程也在分配)，只出现在报告中，不参与断言。
+// ========================================================================
+class QmlMemoryProbe : public QObject {
+    Q_OBJECT
+public:
+    struct Snapshot {
+        bool valid = false;
+        qint64 residentBytes = -1;
+        qint64 qobjects = -1;
+        qint64 jsUsedBytes = -1;
+        qint64 jsAllocatedBytes = -1;
+        qint64 jsLargeItemBytes = -1;
+        double gcMs = -1;
+        qint64 gpuBytes = -1;
+    };
+
+    struct Cycle {
+        QString component;
+        int index = 0;       // 该组件的第几次加载 (从 1 开始)
+        Snapshot before;
+        Snapshot loaded;     // 加载后很快又卸载时可能没有
+        Snapshot after;
+    };
+
+    // 平均每个周期允许残留的量 (不计第一个周期)
+    struct Tolerance {
+        double residentBytes = 256 * 1024;
+        double qobjects = 0.5;
+        double jsBytes = 64 * 1024;
+    };
+
+    // settleMs: Loader 切换后等待渲染 / 动画结束再采样的时间
+    explicit QmlMemoryProbe(QQmlEngine *engine, int settleMs = 1500, QObject *parent = nullptr);
+    ~QmlMemoryProbe();
+
+    // 监视 QML Loader (在 Component.onCompleted 中调用)：active 变化时延迟 settleMs 自动采样
+    Q_INVOKABLE void watch(QObject *loader, const QString &component);
+
+    // 手动记录 (在 C++ 中直接创建/销毁组件时使用)。同步采样，调用方需保证
+    // 当前不在 QML 绑定或信号处理之中 (会处理延迟删除)
+    void recordBaseline(const QString &component);
+    void recordLoaded(const QString &component);
+    void recordUnloaded(const QString &component);
+
+    // 回收后采样当前状态
+    Snapshot snapshot();
+
+    // 最近的周期 (每个组件最多保留 kMaxCycles 个)
+    QVector<Cycle> cycles(const QString &component) const;
+    QStringList components() const;
+
+    // 断言：第一个周期之后平均每周期的常驻内存、QObject 与 JS 堆残留不超过容差；
+    // 不足两个周期也视为失败。
+    // failure 为逐项说明 (成功时为空)
+    bool expectReleased(const QString &component, const Tolerance &tolerance, QString *failure) const;
+    bool expectReleased(const QString &component, QString *failure) const {
+        return expectReleased(component, Tolerance(), failure);
+    }
+
+    // 文本报告：每个组件的周期数、首个周期开销、加载峰值与平均残留
+    Q_INVOKABLE QString report() const;
+
+signals:
+    void cycleCompleted(const QString &component);
+
+private slots:
+    void onLoaderActiveChanged();
+
+private:
+    static const int kMaxCycles = 100;
+
+    struct ComponentState {
+        Snapshot baseline;
+        Snapshot loaded;
+        int loads = 0;
+        int generation = 0;   // 每次 active 变化加一，丢弃过期的延迟采样
+        QVector<Cycle> cycles;
+    };
+
+    qint64 gpuAvailableBytes();
+
+    QQmlEngine *m_engine;
+    int m_settleMs;
+    QHash<QString, ComponentState> m_components;
+    QHash<QObject *, QString> m_loaders;
+
+    // 查询显存用的离屏上下文 (首次需要时创建)
+    QOpenGLContext *m_glContext = nullptr;
+    QOffscreenSurface *m_glSurface = nullptr;
+    bool m_glTried = false;
+    qint64 m_gpuAvailableAtStart = -1;
+};
@@ -0,0 +1,179 @@
+#include "WakeupAuditor.h"
+#include "core/Metrics.h"
+#include "core/Logging.h"
+#include <QAbstractEventDispatcher>
+#include <QCoreApplication>
+#include <QGuiApplication>
+#include <QWindow>
+#include <QQmlApplicationEngine>
+#include <QQmlContext>
+#include <QQmlEngine>
+#include <QRegularExpression>
+#include <QEvent>
+#include <algorithm>
+
+static const int kTopOffenders = 10;
+
+WakeupAuditor::WakeupAuditor(double budgetPerSecond, int reportIntervalMs, QObject *parent)
+    : QObject(parent), m_budget(budgetPerSecond)
+{
+    if (QAbstractEventDispatcher *dispatcher = QAbstractEventDispatcher::instance()) {
+        connect(dispatcher, &QAbstractEventDispatcher::aboutToBlock, this, &WakeupAuditor::onAboutToBlock,
+                Qt::DirectConnection);
+    }
+    // 应用对象上的事件过滤器能看到主线程所有对象的事件
+    QCoreApplication::instance()->installEventFilter(this);
+
+    m_reportTimer.setInterval(reportIntervalMs);
+    connect(&m_reportTimer, &QTimer::timeout, this, &WakeupAuditor::report);
+    m_reportTimer.start();
+    m_period.start();
+
+    qCInfo(lcUi) << "WakeupAuditor: enabled, budget" << m_budget << "wakeups/s, report every" << reportIntervalMs << "ms";
+}
+
+WakeupAuditor::~WakeupAuditor() {
+    if (QCoreApplication::instance()) QCoreApplication::instance()->removeEventFilter(this);
+}
+
+void WakeupAuditor::attachQml(QQmlApplicationEngine *engine) {
+    m_engine = engine;
+    connect(engine, &QQmlApplicationEngine::objectCreated, this, &WakeupAuditor::scanQmlTimers);
+    scanQmlTimers();
+}
+
+bool WakeupAuditor::eventFilter(QObject *watched, QEvent *event) {
+    // 自己的报告定时器不计入
+    if (event->type() == QEvent::Timer && watched != &m_reportTimer) account(ownerName(watched));
+    return false;
+}
+
+void WakeupAuditor::onQmlTimerTriggered() {
+    const auto it = m_qmlTimerNames.constFind(sender());
+    if (it != m_qmlTimerNames.constEnd()) account(it.value());
+}
+
+void WakeupAuditor::account(const QString &owner) {
+    OwnerStats &stats = m_stats[owner];
+    ++stats.timerEvents;
+    if (!m_ownersThisWake.contains(owner)) {
+        m_ownersThisWake.insert(owner);
+        ++stats.wakeups;
+    }
+}
+
+void WakeupAuditor::onAboutToBlock() {
+    ++m_wakeups;
+    if (m_ownersThisWake.isEmpty()) ++m_stats[QStringLiteral("(other)")].wakeups;
+    m_ownersThisWake.clear();
+}
+
+// ========================================================================
+// 归属
+// ========================================================================
+
+QString WakeupAuditor::ownerName(QObject *object) {
+    if (!object) return QStringLiteral("(null)");
+
+    // 跳过定时器包装 (QTimer / ClockTimer)，保留最近的对象名 (如 "tick")
+    QString timerName;
+    QObject *owner = object;
+    while (owner->parent() && (qobject_cast<QTimer *>(owner) || owner->inherits("ClockTimer"))) {
+        if (timerName.isEmpty()) timerName = owner->objectName();
+        owner = owner->parent();
+    }
+
+    // QML 类型名形如 "OverlayWindow_QMLTYPE_3"，去掉编号后缀
+    static const QRegularExpression qmlSuffix("_QML(TYPE)?_\\d+$");
+    QString name = QString::fromLatin1(owner->metaObject()->className()).remove(qmlSuffix);
+    if (const QQmlContext *context = qmlContext(owner)) {
+        const QString file = context->baseUrl().fileName();
+        if (!file.isEmpty()) name = file + ' ' + name;
+    }
+    if (!owner->objectName().isEmpty()) name += '(' + owner->objectName() + ')';
+    if (!timerName.isEmpty()) name += '/' + timerName;
+    return name;
+}
+
+void WakeupAuditor::scanQmlTimers() {
+    // 根对象之外还要扫描所有窗口：Loader/Instantiator 创建的窗口不一定挂在根对象下
+    QList<QObject *> roots;
+    if (m_engine) roots += m_engine->rootObjects();
+    for (QWindow *window : QGuiApplication::allWindows()) roots.append(window);
+
+    for (QObject *root : qAsConst(roots)) {
+        if (qstrcmp(root->metaObject()->className(), "QQmlTimer") == 0) watchQmlTimer(root);
+        const QList<QObject *> children = root->findChildren<QObject *>();
+        for (QObject *child : children) {
+            if (qstrcmp(child->metaObject()->className(), "QQmlTimer") == 0) watchQmlTimer(child);
+        }
+    }
+}
+
+void WakeupAuditor::watchQmlTimer(QObject *timer) {
+    if (m_qmlTimers.contains(timer)) return;
+    m_qmlTimers.insert(timer);
+
+    // Timer 的使用者是其父对象，文件名取 Timer 自己的上下文
+    QString name = timer->parent() ? ownerName(timer->parent()) : QStringLiteral("QML");
+    if (const QQmlContext *context = qmlContext(timer)) {
+        const QString file = context->baseUrl().fileName();
+        if (!file.isEmpty() && !name.startsWith(file)) name = file + ' ' + name;
+    }
+    name += QString(" Timer(%1ms)").arg(timer->property("interval").toInt());
+    m_qmlTimerNames.insert(timer, name);
+
+    connect(timer, SIGNAL(triggered()), this, SLOT(onQmlTimerTriggered()));
+    connect(timer, &QObject::destroyed, this, [this](QObject *object) {
+        m_qmlTimers.remove(object);
+        m_qmlTimerNames.remove(object);
+    });
+}
+
+// ========================================================================
+// 报告
+// ========================================================================
+
+void WakeupAuditor::report() {
+    scanQmlTimers();
+
+    const double seconds = qMax<qint64>(1, m_period.restart()) / 1000.0;
+    const double total = m_wakeups / seconds;
+
+    QVector<QPair<QString, OwnerStats>> owners;
+    owners.reserve(m_stats.size());
+    for (auto it = m_stats.constBegin(); it != m_stats.constEnd(); ++it) owners.append(qMakePair(it.key(), it.value()));
+    std::sort(owners.begin(), owners.end(), [](const QPair<QString, OwnerStats> &a, const QPair<QString, OwnerStats> &b) {
+        if (a.second.wakeups != b.second.wakeups) return a.second.wakeups > b.second.wakeups;
+        return a.second.timerEvents > b.second.timerEvents;
+    });
+
+    m_lastReport.clear();
+    QString text = QString("Wakeups: %1/s (budget %2/s)").arg(total, 0, 'f', 1).arg(m_budget, 0, 'f', 1);
+    for (int i = 0; i < owners.size(); ++i) {
+        const double wakeups = owners.at(i).second.wakeups / seconds;
+        const double events = owners.at(i).second.timerEvents / seconds;
+        m_lastReport.append(QVariantMap{
+            { "owner", owners.at(i).first },
+            { "wakeupsPerSec", wakeups },
+            { "timerEventsPerSec", events },
+        });
+        if (i < kTopOffenders) {
+            text += QString("\n  %1 wakeups/s  %2 events/s  %3")
+                        .arg(wakeups, 6, 'f', 2).arg(events, 6, 'f', 2).arg(owners.at(i).first);
+        }
+    }
+
+    static MetricCounter *s_total = Metrics::instance()->counter("wakeups.total");
+    static MetricCounter *s_overBudget = Metrics::instance()->counter("wakeups.overBudget");
+    s_total->add(m_wakeups);
+    if (total > m_budget) {
+        s_overBudget->add();
+        qCWarning(lcUi).noquote() << text;
+    } else {
+        qCInfo(lcUi).noquote() << text;
+    }
+
+    m_stats.clear();
+    m_wakeups = 0;
+}
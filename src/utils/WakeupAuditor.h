@@ -0,0 +1,73 @@
+#pragma once
+#include <QObject>
+#include <QHash>
+#include <QSet>
+#include <QString>
+#include <QVariant>
+#include <QElapsedTimer>
+#include <QTimer>
+
+class QQmlApplicationEngine;
+
+// ========================================================================
+// WakeupAuditor：事件循环唤醒分析 (诊断模式，--audit-wakeups 开启)
+// ========================================================================
+// 找出让 CPU 无法进入空闲的组件：
+// - 唤醒次数：事件循环每次进入等待前 QAbstractEventDispatcher 发出
+//   aboutToBlock，两次之间为一次唤醒；期间处理过事件的每个使用者各计一次，
+//   没有可归属事件的唤醒记为 "(other)" (输入、套接字、跨线程投递等)。
+// - 定时器事件：在 QCoreApplication 上安装事件过滤器，看到主线程所有
+//   QTimerEvent，沿父对象链归属到第一个不是定时器包装的对象
+//   (例如 "TimerEngine/tick")，QML 对象附带所在文件名。
+// - QML Timer：由动画驱动而非 QTimerEvent，单独连接每个 Timer 的
+//   triggered 信号，按 "文件名 Timer(间隔)" 归属；定期重新扫描以覆盖
+//   Loader 动态创建的窗口。动画本身归入 QUnifiedTimer / 渲染循环。
+//
+// 每 reportIntervalMs 输出一次排行 (qInfo)，总唤醒频率超过预算时 qWarning，
+// 同时累加 Metrics 计数器 wakeups.total / wakeups.overBudget。
+// ========================================================================
+class WakeupAuditor : public QObject {
+    Q_OBJECT
+public:
+    // budgetPerSecond: 每秒唤醒次数预算
+    explicit WakeupAuditor(double budgetPerSecond, int reportIntervalMs = 10000, QObject *parent = nullptr);
+    ~WakeupAuditor();
+
+    // 追踪该引擎加载的 QML Timer (可在 load 前调用)
+    void attachQml(QQmlApplicationEngine *engine);
+
+    // 最近一个统计周期的排行: [{owner, wakeupsPerSec, timerEventsPerSec}]，按唤醒频率降序
+    Q_INVOKABLE QVariantList lastReport() const { return m_lastReport; }
+
+protected:
+    bool eventFilter(QObject *watched, QEvent *event) override;
+
+private slots:
+    void onAboutToBlock();
+    void onQmlTimerTriggered();
+    void report();
+
+private:
+    struct OwnerStats {
+        quint64 wakeups = 0;
+        quint64 timerEvents = 0;
+    };
+
+    void account(const QString &owner);
+    void scanQmlTimers();
+    void watchQmlTimer(QObject *timer);
+    static QString ownerName(QObject *object);
+
+    double m_budget;
+    QTimer m_reportTimer;
+    QElapsedTimer m_period;
+
+    QHash<QString, OwnerStats> m_stats;  // 当前周期
+    QSet<QString> m_ownersThisWake;      // 本次唤醒 (上一次 aboutToBlock 之后) 已计数的使用者
+    quint64 m_wakeups = 0;               // 当前周期总唤醒次数
+
+    QQmlApplicationEngine *m_engine = nullptr;
+    QSet<QObject *> m_qmlTimers;         // 已连接的 QML Timer
+    QHash<QObject *, QString> m_qmlTimerNames;
+    QVariantList m_lastReport;
+};
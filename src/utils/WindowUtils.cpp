@@ -1,8 +1,9 @@
 #include "WindowUtils.h"
-#include <QDebug>
+#include "core/Logging.h"
 #include <QGuiApplication>
 #include <QScreen>
 #include <QCursor>
+#include <QSettings>
 
 // #ifdef Q_OS_WIN 是 Qt 的宏，仅在 Windows 平台编译此段代码
 #ifdef Q_OS_WIN
@@ -10,6 +11,10 @@
 #include <wtsapi32.h> // 引入 Windows Terminal Services API
 #endif
 
+#ifdef Q_OS_LINUX
+#include "LinuxPresence.h" // logind / IdleMonitor (D-Bus)
+#endif
+
 // ========================================================================
 // SysMsgWindow: 专用消息接收窗口
 // ========================================================================
@@ -28,9 +33,9 @@ public:
         if (hwnd) {
             // 注册会话通知
             if (WTSRegisterSessionNotification(hwnd, NOTIFY_FOR_THIS_SESSION)) {
-                qDebug() << "SysMsgWindow: Successfully registered for session notifications. HWND:" << hwnd;
+                qCDebug(lcUi) << "SysMsgWindow: Successfully registered for session notifications. HWND:" << hwnd;
             } else {
-                qDebug() << "SysMsgWindow: Failed to register. Error:" << GetLastError();
+                qCDebug(lcUi) << "SysMsgWindow: Failed to register. Error:" << GetLastError();
             }
         }
 #endif
@@ -54,15 +59,17 @@ protected:
 #ifdef Q_OS_WIN
         MSG *msg = static_cast<MSG *>(message);
         if (msg->message == WM_WTSSESSION_CHANGE) {
-            qDebug() << "SysMsgWindow: Received WM_WTSSESSION_CHANGE. wParam:" << msg->wParam;
+            qCDebug(lcUi) << "SysMsgWindow: Received WM_WTSSESSION_CHANGE. wParam:" << msg->wParam;
             switch (msg->wParam) {
                 case WTS_SESSION_LOCK:
-                    qDebug() << "SysMsgWindow: Session Locked";
-                    emit m_parent->sessionStateChanged(true);
+                    qCDebug(lcUi) << "SysMsgWindow: Session Locked";
+                    m_parent->m_nativeLocked = true;
+                    m_parent->updatePresence();
                     break;
                 case WTS_SESSION_UNLOCK:
-                    qDebug() << "SysMsgWindow: Session Unlocked";
-                    emit m_parent->sessionStateChanged(false);
+                    qCDebug(lcUi) << "SysMsgWindow: Session Unlocked";
+                    m_parent->m_nativeLocked = false;
+                    m_parent->updatePresence();
                     break;
                 default:
                     break;
@@ -84,6 +91,35 @@ WindowUtils::WindowUtils(QObject *parent) : QObject(parent), m_sysMsgWindow(null
     // 创建隐藏的消息接收窗口
     // 注意：必须在 GUI 线程中创建
     m_sysMsgWindow = new SysMsgWindow(this);
+
+#ifdef Q_OS_LINUX
+    // Linux：锁屏与空闲均由 D-Bus 事件通知 (无轮询)
+    addPresenceSource(new LogindPresenceSource(this));
+    // 无输入超过 N 分钟自动暂停 (0 表示关闭)
+    const int idleMinutes = QSettings("TraeAI", "DeskCare").value("Presence/idleMinutes", 10).toInt();
+    if (idleMinutes > 0) {
+        addPresenceSource(new IdleMonitorPresenceSource(qint64(idleMinutes) * 60 * 1000, this));
+    }
+#endif
+}
+
+void WindowUtils::addPresenceSource(PresenceSource *source) {
+    if (!source || m_presenceSources.contains(source)) return;
+    source->setParent(this);
+    m_presenceSources.append(source);
+    connect(source, &PresenceSource::presenceChanged, this, &WindowUtils::updatePresence);
+    updatePresence();
+}
+
+void WindowUtils::updatePresence() {
+    bool away = m_nativeLocked;
+    for (PresenceSource *source : qAsConst(m_presenceSources)) {
+        away = away || source->isLocked() || source->isIdle();
+    }
+    if (away == m_away) return;
+
+    m_away = away;
+    emit sessionStateChanged(away);
 }
 
 WindowUtils::~WindowUtils() {
@@ -102,7 +138,7 @@ void WindowUtils::setTopMost(QObject *window, bool top) {
     // 它依赖于元对象系统，如果转换失败（对象不是 QWindow 类型），返回 nullptr。
     QWindow *qWin = qobject_cast<QWindow*>(window);
     if (!qWin) {
-        qDebug() << "WindowUtils: Passed object is not a QWindow";
+        qCDebug(lcUi) << "WindowUtils: Passed object is not a QWindow";
         return;
     }
 
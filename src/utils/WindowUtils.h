@@ -2,6 +2,8 @@
 #include <QObject>
 #include <QWindow>
 #include <QVariantMap>
+#include <QList>
+#include "PresenceSource.h"
 
 // ========================================================================
 // WindowUtils 类：窗口工具类
@@ -10,6 +12,8 @@
 // 主要是为了解决 QML 中设置窗口置顶 (WindowStaysOnTopHint) 时，
 // 在某些操作系统（尤其是 Windows）上可能导致的窗口闪烁或重绘问题。
 // 同时负责监听系统级事件（如锁屏）。
+// 在场检测：Windows 会话通知与可插拔的 PresenceSource (Linux 上默认挂接
+// logind 锁屏检测与空闲检测) 汇总为一个"用户离开"状态。
 class WindowUtils : public QObject {
     Q_OBJECT
 public:
@@ -33,12 +37,22 @@ public:
     // 用于手动启动时，让窗口出现在用户操作的那个屏幕上
     Q_INVOKABLE QVariantMap getScreenGeometryAtCursor();
 
+    // 挂接在场检测源 (接管所有权)
+    void addPresenceSource(PresenceSource *source);
+
 signals:
-    // 当系统会话状态改变时触发（true=锁屏, false=解锁）
+    // 当用户离开/回来时触发（true=锁屏或空闲, false=解锁且有输入）
     void sessionStateChanged(bool locked);
 
 private:
+    // 汇总所有来源，状态改变时发出 sessionStateChanged
+    void updatePresence();
+
     // 内部类，用于接收系统消息的隐藏窗口
     class SysMsgWindow;
     SysMsgWindow *m_sysMsgWindow;
+
+    QList<PresenceSource *> m_presenceSources;
+    bool m_nativeLocked = false; // Windows 会话通知
+    bool m_away = false;
 };
@@ -0,0 +1,14 @@
+# 活动查询与统计的基准测试 (QtTest，QBENCHMARK)，只链接核心库
+QT = core sql network testlib
+QT -= gui
+CONFIG += c++17 console testcase
+CONFIG -= app_bundle
+TARGET = tst_activity_benchmark
+TEMPLATE = app
+
+include(../../src/core/core.pri)
+
+SOURCES += tst_activitybenchmark.cpp
+
+# Fix for MSVC "C2001: newline in constant" error due to UTF-8 encoding with Chinese comments
+msvc:QMAKE_CXXFLAGS += /utf-8
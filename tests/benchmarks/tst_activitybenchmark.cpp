@@ -0,0 +1,313 @@
+// ========================================================================
+// 活动记录与统计路径的基准测试 (QtTest)
+// ========================================================================
+// 对每个规模 (数据行) 用 HistoryGenerator 生成数据目录，打开真实的
+// SqliteActivityStore，测量:
+//   open                          打开存储 (归档扫描、日志重放)，只测一次
+//   dailyActivities               普通工作日 / 频繁锁屏的日子 (行数最多)
+//   dailyStats                    一天的统计
+//   report                        工时日志报告 (week / month / year，跨年时涉及归档库)
+//   appendSession                 写入一段会话 (写入日志，批量压实摊销在内)
+//   appendSessionFlush            写入并立即压实 (单行事务)
+// 以及与数据量无关的运动统计 (exercise*)，写入临时目录中的 INI 文件。
+//
+// 环境变量：
+//   DESKCARE_BENCH_ROWS=1000,100000   数据规模 (逗号分隔，默认 1k/10k/100k/1M)
+//   DESKCARE_BENCH_DATA=<目录>        生成的数据保存在 <目录>/rows_<N> 并在下次复用
+//                                     (默认使用临时目录，结束后删除)
+//
+// 结果用 QtTest 的输出格式保存与比较，例如:
+//   tst_activity_benchmark -o result.xml,xml
+//   tst_activity_benchmark -csv -o result.csv,csv
+// ========================================================================
+#include <QtTest>
+#include <QDir>
+#include <QHash>
+#include <QLoggingCategory>
+#include <QScopedPointer>
+#include <QTemporaryDir>
+#include "core/ActivityLogger.h"
+#include "core/Clock.h"
+#include "core/HistoryGenerator.h"
+#include "core/SqliteActivityStore.h"
+#include "core/TimerEngine.h"
+
+class ActivityBenchmark : public QObject
+{
+    Q_OBJECT
+
+private slots:
+    void initTestCase();
+    void cleanupTestCase();
+
+    void open_data() { addSizes(); }
+    void open();
+    void dailyActivities_data();
+    void dailyActivities();
+    void dailyStats_data() { addSizes(); }
+    void dailyStats();
+    void report_data();
+    void report();
+    void appendSession_data() { addSizes(); }
+    void appendSession();
+    void appendSessionFlush_data() { addSizes(); }
+    void appendSessionFlush();
+
+    void exerciseRecord();
+    void exerciseToday();
+    void exerciseWeekly();
+
+private:
+    // 一个规模的数据目录与打开的记录器 (同一规模的用例共用)
+    struct Fixture {
+        QString dataDir;
+        HistoryGenerator::Result history;
+        ActivityLogger* logger = nullptr;
+        qint64 nextInsert = 0; // 写入用例的下一个开始时间
+        ~Fixture() { delete logger; }
+    };
+
+    void addSizes();
+    // 生成 (或复用) rows 行的数据目录，失败时返回 nullptr 并记录失败
+    Fixture* prepare(qint64 rows);
+    // 已打开记录器的 fixture
+    Fixture* fixture(qint64 rows);
+    // 打开 rows 规模的存储；各规模的 fixture 同时存在，连接名必须不同
+    static ActivityLogger* openLogger(const Fixture* fixture, qint64 rows);
+    // 打开的存储能查到生成的全部行 (连接失效时不会静默通过)
+    static bool verifyRows(const Fixture* fixture);
+
+    QList<qint64> m_sizes;
+    QString m_dataRoot;
+    QTemporaryDir m_tempDir;
+    QHash<qint64, Fixture*> m_fixtures;
+
+    QScopedPointer<VirtualClock> m_clock;
+    QScopedPointer<TimerEngine> m_engine;
+};
+
+void ActivityBenchmark::initTestCase() {
+    // 计时期间不输出调试日志 (Debug 构建默认全部开启)
+    QLoggingCategory::setFilterRules("deskcare.*.debug=false");
+    QVERIFY(m_tempDir.isValid());
+
+    const QByteArray rows = qgetenv("DESKCARE_BENCH_ROWS");
+    for (const QString& size : QString::fromLatin1(rows.isEmpty() ? "1000,10000,100000,1000000" : rows)
+                                   .split(',', Qt::SkipEmptyParts)) {
+        const qint64 value = size.trimmed().toLongLong();
+        if (value > 0) m_sizes.append(value);
+    }
+    QVERIFY2(!m_sizes.isEmpty(), "DESKCARE_BENCH_ROWS contains no valid size");
+    m_dataRoot = QString::fromLocal8Bit(qgetenv("DESKCARE_BENCH_DATA"));
+    if (m_dataRoot.isEmpty()) m_dataRoot = m_tempDir.path();
+
+    // 运动统计：2099 年的虚拟日期，写入临时 INI 文件
+    m_clock.reset(new VirtualClock(QDateTime(QDate(2099, 1, 5), QTime(12, 0))));
+    m_engine.reset(new TimerEngine(m_clock.data()));
+    m_engine->setStatsFile(m_tempDir.filePath("stats.ini"));
+    m_engine->stop();
+}
+
+void ActivityBenchmark::cleanupTestCase() {
+    qDeleteAll(m_fixtures);
+    m_fixtures.clear();
+    m_engine.reset();
+    m_clock.reset();
+}
+
+void ActivityBenchmark::addSizes() {
+    QTest::addColumn<qint64>("rows");
+    for (qint64 rows : qAsConst(m_sizes)) QTest::newRow(QByteArray::number(rows)) << rows;
+}
+
+ActivityBenchmark::Fixture* ActivityBenchmark::prepare(qint64 rows) {
+    if (Fixture* existing = m_fixtures.value(rows)) return existing;
+
+    HistoryGenerator::Options options;
+    options.rows = rows;
+    QScopedPointer<Fixture> fixture(new Fixture);
+    fixture->dataDir = QDir(m_dataRoot).filePath(QString("rows_%1").arg(rows));
+
+    if (!HistoryGenerator::loadResult(fixture->dataDir, options, &fixture->history)) {
+        if (QDir(fixture->dataDir).exists("activity_log.db")) {
+            QTest::qFail(qPrintable(fixture->dataDir + " contains data from different generator options"),
+                         __FILE__, __LINE__);
+            return nullptr;
+        }
+        qInfo("generating %lld rows in %s ...", rows, qPrintable(fixture->dataDir));
+        QString error;
+        if (!HistoryGenerator::generate(fixture->dataDir, options, &fixture->history, &error)) {
+            QTest::qFail(qPrintable(error), __FILE__, __LINE__);
+            return nullptr;
+        }
+        HistoryGenerator::saveResult(fixture->dataDir, options, fixture->history);
+    }
+    // 写在 2099 年，避开被查询的日期 (复用的数据目录会逐次累积这些行)
+    fixture->nextInsert = QDateTime(QDate(2099, 1, 1), QTime(9, 0)).toSecsSinceEpoch();
+    m_fixtures.insert(rows, fixture.data());
+    return fixture.take();
+}
+
+ActivityBenchmark::Fixture* ActivityBenchmark::fixture(qint64 rows) {
+    Fixture* fixture = prepare(rows);
+    if (!fixture) return nullptr;
+    if (!fixture->logger) {
+        fixture->logger = openLogger(fixture, rows);
+        if (!verifyRows(fixture)) return nullptr;
+    }
+    return fixture;
+}
+
+ActivityLogger* ActivityBenchmark::openLogger(const Fixture* fixture, qint64 rows) {
+    return new ActivityLogger(nullptr, new SqliteActivityStore(fixture->dataDir, QStringLiteral("benchmark_%1").arg(rows)));
+}
+
+bool ActivityBenchmark::verifyRows(const Fixture* fixture) {
+    ActivityStore* store = fixture->logger->store();
+    if (!store->isOpen()) {
+        QTest::qFail(qPrintable("cannot open " + fixture->dataDir), __FILE__, __LINE__);
+        return false;
+    }
+    // 生成的历史截止到 lastDate，写入用例追加的 2099 年记录不在范围内
+    const qint64 startTs = QDateTime(fixture->history.firstDate, QTime(0, 0)).toSecsSinceEpoch();
+    const qint64 endTs = QDateTime(fixture->history.lastDate, QTime(23, 59, 59)).toSecsSinceEpoch();
+    qint64 count = 0;
+    const QHash<QString, ActivityAggregate> aggregates = store->aggregate(startTs, endTs, 0);
+    for (const ActivityAggregate& aggregate : aggregates) count += aggregate.count;
+    if (count != fixture->history.rows) {
+        QTest::qFail(qPrintable(QString("%1: expected %2 rows, query returned %3")
+                                    .arg(fixture->dataDir).arg(fixture->history.rows).arg(count)),
+                     __FILE__, __LINE__);
+        return false;
+    }
+    return true;
+}
+
+// ========================================================================
+// 用例
+// ========================================================================
+
+void ActivityBenchmark::open() {
+    QFETCH(qint64, rows);
+    Fixture* data = prepare(rows);
+    if (!data) return;
+    // 首次打开包含往年数据归档，只测一次；打开的记录器留给后续用例
+    if (data->logger) QSKIP("store already opened by an earlier case");
+    ActivityLogger* logger = nullptr;
+    QBENCHMARK_ONCE {
+        logger = openLogger(data, rows);
+    }
+    data->logger = logger;
+    QVERIFY(verifyRows(data));
+}
+
+void ActivityBenchmark::dailyActivities_data() {
+    QTest::addColumn<qint64>("rows");
+    QTest::addColumn<bool>("fragmented");
+    for (qint64 rows : qAsConst(m_sizes)) {
+        QTest::addRow("%lld/typical", rows) << rows << false;
+        QTest::addRow("%lld/fragmented", rows) << rows << true;
+    }
+}
+
+void ActivityBenchmark::dailyActivities() {
+    QFETCH(qint64, rows);
+    QFETCH(bool, fragmented);
+    Fixture* data = fixture(rows);
+    if (!data) return;
+    const QDate day = fragmented ? data->history.fragmentedDay : data->history.typicalDay;
+    if (!day.isValid()) QSKIP("no fragmented day in this history");
+    QBENCHMARK {
+        data->logger->getDailyActivities(day);
+    }
+}
+
+void ActivityBenchmark::dailyStats() {
+    QFETCH(qint64, rows);
+    Fixture* data = fixture(rows);
+    if (!data) return;
+    const QDate day = data->history.typicalDay;
+    QBENCHMARK {
+        data->logger->getDailyStats(day);
+    }
+}
+
+void ActivityBenchmark::report_data() {
+    QTest::addColumn<qint64>("rows");
+    QTest::addColumn<int>("days");
+    for (qint64 rows : qAsConst(m_sizes)) {
+        QTest::addRow("%lld/week", rows) << rows << 7;
+        QTest::addRow("%lld/month", rows) << rows << 30;
+        QTest::addRow("%lld/year", rows) << rows << 365;
+    }
+}
+
+void ActivityBenchmark::report() {
+    QFETCH(qint64, rows);
+    QFETCH(int, days);
+    Fixture* data = fixture(rows);
+    if (!data) return;
+    const QDate day = data->history.typicalDay;
+    const qint64 startMs = QDateTime(day.addDays(1 - days), QTime(0, 0)).toMSecsSinceEpoch();
+    const qint64 endMs = QDateTime(day, QTime(23, 59, 59)).toMSecsSinceEpoch();
+    QBENCHMARK {
+        data->logger->generateReportCustom(startMs, endMs, 0);
+    }
+}
+
+static void appendOne(ActivityStore* store, qint64* start) {
+    ActivityRecord record;
+    record.state = "Focus";
+    record.startTime = *start;
+    record.endTime = *start + 1500;
+    record.duration = 1500;
+    store->appendSession(record);
+    *start += 1800;
+}
+
+void ActivityBenchmark::appendSession() {
+    QFETCH(qint64, rows);
+    Fixture* data = fixture(rows);
+    if (!data) return;
+    ActivityStore* store = data->logger->store();
+    QBENCHMARK {
+        appendOne(store, &data->nextInsert);
+    }
+    store->flush();
+}
+
+void ActivityBenchmark::appendSessionFlush() {
+    QFETCH(qint64, rows);
+    Fixture* data = fixture(rows);
+    if (!data) return;
+    ActivityStore* store = data->logger->store();
+    QBENCHMARK {
+        appendOne(store, &data->nextInsert);
+        store->flush();
+    }
+}
+
+// ---- 运动统计 (与数据量无关) ----
+
+void ActivityBenchmark::exerciseRecord() {
+    // 每次记录前推进一天，避免当天的会话列表越来越长 (推进计入耗时，引擎已停止，开销可忽略)
+    QBENCHMARK {
+        m_clock->advance(24 * 3600 * 1000);
+        m_engine->recordExercise(300);
+    }
+}
+
+void ActivityBenchmark::exerciseToday() {
+    QBENCHMARK {
+        m_engine->getTodayExerciseSeconds();
+    }
+}
+
+void ActivityBenchmark::exerciseWeekly() {
+    QBENCHMARK {
+        m_engine->getWeeklyExerciseStats();
+    }
+}
+
+QTEST_GUILESS_MAIN(ActivityBenchmark)
+#include "tst_activitybenchmark.moc"